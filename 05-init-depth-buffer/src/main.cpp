@@ -434,7 +434,10 @@ int main(int argc, char** argv)
     depth_image_info.tiling = depth_image_tiling;
     depth_image_info.samples = VK_SAMPLE_COUNT_1_BIT;
     depth_image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    depth_image_info.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    // The depth buffer is never read after the render pass, so it can stay
+    // in tile memory and be backed lazily, if at all.
+    depth_image_info.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+                             VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
     depth_image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
     VkImage depth_image = {};
@@ -445,11 +448,23 @@ int main(int argc, char** argv)
     VkMemoryRequirements depth_image_mem_reqs = {};
     vkGetImageMemoryRequirements(device, depth_image, &depth_image_mem_reqs);
 
+    // Lazily allocated memory mostly exists on tilers, elsewhere any device
+    // local memory will do.
+    const bool depth_image_lazily_allocated =
+        findMemoryTypeIndex(
+            physical_device_mem_prop,
+            depth_image_mem_reqs,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+                VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+            .first;
     auto[depth_image_mem_type_index_found, depth_image_mem_type_index] =
         findMemoryTypeIndex(
             physical_device_mem_prop,
             depth_image_mem_reqs,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            depth_image_lazily_allocated
+                ? VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+                      VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT
+                : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
     if (!depth_image_mem_type_index_found)
     {
@@ -469,6 +484,21 @@ int main(int argc, char** argv)
         vkBindImageMemory(device, depth_image, depth_image_mem, 0),
         "BindImageMemory");
 
+    if (depth_image_lazily_allocated)
+    {
+        VkDeviceSize depth_image_committed = 0;
+        vkGetDeviceMemoryCommitment(
+            device, depth_image_mem, &depth_image_committed);
+        std::cout << "Depth image: " << depth_image_committed << " of "
+                  << depth_image_mem_reqs.size
+                  << " bytes committed, lazily allocated" << std::endl;
+    }
+    else
+    {
+        std::cout << "Depth image: " << depth_image_mem_reqs.size
+                  << " bytes, no lazily allocated memory" << std::endl;
+    }
+
     VkImageViewCreateInfo depth_imageview_info = {};
     depth_imageview_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
     depth_imageview_info.image = depth_image;
@@ -24,12 +24,19 @@
 
 #include <GLFW/glfw3.h>
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
+#include <iterator>
 #include <set>
 #include <shaderc/shaderc.hpp>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -44,6 +51,8 @@
 constexpr uint32_t c_width = 640;
 constexpr uint32_t c_height = 480;
 
+const char* const c_pipeline_cache_path = "pipeline_cache.bin";
+
 const glm::mat4 c_clip(
     glm::vec4(1.f, 0.f, 0.f, 0.f),
     glm::vec4(0.f, -1.f, 0.f, 0.f),
@@ -297,6 +306,130 @@ std::pair<bool, uint32_t> findMemoryTypeIndex(
     };
 }
 
+// The driver data is wrapped in its size and checksum, so a truncated or
+// damaged file is dropped before the driver sees it.
+constexpr uint32_t c_pipeline_cache_file_magic = 0x43504B56; // "VKPC"
+constexpr uint32_t c_pipeline_cache_file_version = 1;
+
+struct PipelineCacheFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t data_size;
+    uint64_t checksum;
+};
+
+uint64_t checksum(const void* data, std::size_t size)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * Reads pipeline cache data saved by an earlier run. Data that is damaged,
+ * too short or was written for another driver or device is dropped, the
+ * cache then starts empty.
+ */
+std::vector<char> loadPipelineCacheData(
+    const char* path, const VkPhysicalDeviceProperties& props)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> bytes(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+
+    PipelineCacheFileHeader file_header = {};
+    if (bytes.size() < sizeof(file_header))
+    {
+        return {};
+    }
+    std::memcpy(&file_header, bytes.data(), sizeof(file_header));
+    std::vector<char> data(bytes.begin() + sizeof(file_header), bytes.end());
+    if (file_header.magic != c_pipeline_cache_file_magic ||
+        file_header.version != c_pipeline_cache_file_version ||
+        file_header.data_size != data.size() ||
+        file_header.checksum != checksum(data.data(), data.size()))
+    {
+        return {};
+    }
+
+    // headerLength, headerVersion, vendorID, deviceID, pipelineCacheUUID
+    constexpr std::size_t c_header_size = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+    uint32_t header[4] = {};
+    if (data.size() < c_header_size)
+    {
+        return {};
+    }
+    std::memcpy(header, data.data(), sizeof(header));
+    if (header[0] < c_header_size ||
+        header[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+        header[2] != props.vendorID || header[3] != props.deviceID ||
+        std::memcmp(
+            data.data() + sizeof(header),
+            props.pipelineCacheUUID,
+            VK_UUID_SIZE) != 0)
+    {
+        return {};
+    }
+    return data;
+}
+
+/** Writes next to the final name first, so a crash can't leave half a file. */
+bool savePipelineCacheData(
+    VkDevice device, VkPipelineCache pipeline_cache, const char* path)
+{
+    std::size_t size = 0;
+    if (vkGetPipelineCacheData(device, pipeline_cache, &size, nullptr) !=
+        VK_SUCCESS)
+    {
+        return false;
+    }
+    std::vector<char> data(size);
+    // VK_INCOMPLETE when the cache grew in between, the prefix that fit is
+    // still a valid cache.
+    VkResult result =
+        vkGetPipelineCacheData(device, pipeline_cache, &size, data.data());
+    if (result != VK_SUCCESS && result != VK_INCOMPLETE)
+    {
+        return false;
+    }
+
+    PipelineCacheFileHeader file_header = {};
+    file_header.magic = c_pipeline_cache_file_magic;
+    file_header.version = c_pipeline_cache_file_version;
+    file_header.data_size = size;
+    file_header.checksum = checksum(data.data(), size);
+
+    const std::string temp_path = std::string(path) + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary);
+        file.write(
+            reinterpret_cast<const char*>(&file_header), sizeof(file_header));
+        file.write(data.data(), static_cast<std::streamsize>(size));
+        if (!file)
+        {
+            file.close();
+            std::remove(temp_path.c_str());
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temp_path, path, error);
+    if (error)
+    {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
 } // namespace
 
 int main(int argc, char** argv)
@@ -1095,10 +1228,39 @@ int main(int argc, char** argv)
     pipeline_info.renderPass = render_pass;
     pipeline_info.subpass = 0;
 
+    VkPhysicalDeviceProperties physical_device_props = {};
+    vkGetPhysicalDeviceProperties(physical_device, &physical_device_props);
+    const std::vector<char> pipeline_cache_data =
+        loadPipelineCacheData(c_pipeline_cache_path, physical_device_props);
+
+    VkPipelineCacheCreateInfo pipeline_cache_info = {};
+    pipeline_cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipeline_cache_info.initialDataSize = pipeline_cache_data.size();
+    pipeline_cache_info.pInitialData = pipeline_cache_data.data();
+
+    VkPipelineCache pipeline_cache = {};
+    FAIL_IF_NOT_SUCCESS(
+        vkCreatePipelineCache(
+            device, &pipeline_cache_info, nullptr, &pipeline_cache),
+        "CreatePipelineCache");
+
+    auto pipeline_create_start = std::chrono::steady_clock::now();
     VkPipeline pipeline = {};
     FAIL_IF_NOT_SUCCESS(
-        vkCreateGraphicsPipelines(device, 0, 1, &pipeline_info, nullptr, &pipeline),
+        vkCreateGraphicsPipelines(
+            device, pipeline_cache, 1, &pipeline_info, nullptr, &pipeline),
         "CreateGraphicsPipelines");
+    std::chrono::duration<double, std::milli> pipeline_create_ms =
+        std::chrono::steady_clock::now() - pipeline_create_start;
+    std::cout << "Pipeline created in " << pipeline_create_ms.count()
+              << " ms, " << (pipeline_cache_data.empty() ? "cold" : "warm")
+              << " cache" << std::endl;
+
+    if (!savePipelineCacheData(device, pipeline_cache, c_pipeline_cache_path))
+    {
+        std::cerr << "Failed to save the pipeline cache." << std::endl;
+    }
+    vkDestroyPipelineCache(device, pipeline_cache, nullptr);
 
     while (!glfwWindowShouldClose(window))
     {
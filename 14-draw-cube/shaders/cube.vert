@@ -0,0 +1,65 @@
+#version 450
+
+// One source for all transform paths, selected with a define:
+// TRANSFORMS_UBO, TRANSFORMS_PUSH, TRANSFORMS_SSBO, TRANSFORMS_INSTANCED or
+// TRANSFORMS_BINDLESS.
+
+#if defined(TRANSFORMS_BINDLESS)
+#extension GL_EXT_nonuniform_qualifier : require
+#endif
+
+layout (location = 0) in vec4 in_pos;
+layout (location = 1) in vec4 in_color;
+#if defined(TRANSFORMS_INSTANCED)
+layout (location = 2) in mat4 in_model;
+layout (location = 6) in vec4 in_instance_color;
+#endif
+layout (location = 0) out vec4 out_color;
+
+#if defined(TRANSFORMS_UBO)
+layout (std140, binding = 0) uniform bufferVals {
+    mat4 mvp;
+} u_buffer_vals;
+#elif defined(TRANSFORMS_PUSH)
+layout (push_constant) uniform PushConstants {
+    mat4 mvp;
+} u_push;
+#elif defined(TRANSFORMS_SSBO)
+layout (std430, binding = 0) readonly buffer Transforms {
+    mat4 mvp[];
+} u_transforms;
+#elif defined(TRANSFORMS_INSTANCED)
+layout (push_constant) uniform PushConstants {
+    mat4 view_projection;
+} u_push;
+#elif defined(TRANSFORMS_BINDLESS)
+// Heap index of the storage buffer with this frame's transforms.
+layout (push_constant) uniform PushConstants {
+    uint transforms;
+} u_push;
+layout (std430, binding = 0) readonly buffer Transforms {
+    mat4 mvp[];
+} u_buffers[];
+#else
+#error "A TRANSFORMS_* define is required"
+#endif
+
+void main() {
+#if defined(TRANSFORMS_UBO)
+   out_color = in_color;
+   gl_Position = u_buffer_vals.mvp * in_pos;
+#elif defined(TRANSFORMS_PUSH)
+   out_color = in_color;
+   gl_Position = u_push.mvp * in_pos;
+#elif defined(TRANSFORMS_SSBO)
+   out_color = in_color;
+   gl_Position = u_transforms.mvp[gl_InstanceIndex] * in_pos;
+#elif defined(TRANSFORMS_BINDLESS)
+   out_color = in_color;
+   mat4 mvp = u_buffers[u_push.transforms].mvp[gl_InstanceIndex];
+   gl_Position = mvp * in_pos;
+#else
+   out_color = in_color * in_instance_color;
+   gl_Position = u_push.view_projection * (in_model * in_pos);
+#endif
+}
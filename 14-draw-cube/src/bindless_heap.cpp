@@ -0,0 +1,280 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bindless_heap.h"
+
+#include <algorithm>
+
+bool queryBindlessSupport(
+    VkPhysicalDevice physical_device,
+    BindlessSupport& support,
+    std::string& error)
+{
+    VkPhysicalDeviceDescriptorIndexingProperties indexing_props = {};
+    indexing_props.sType =
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+    VkPhysicalDeviceProperties2 props = {};
+    props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    props.pNext = &indexing_props;
+    vkGetPhysicalDeviceProperties2(physical_device, &props);
+    if (props.properties.apiVersion < VK_API_VERSION_1_2)
+    {
+        error = "Vulkan 1.2";
+        return false;
+    }
+
+    VkPhysicalDeviceDescriptorIndexingFeatures indexing = {};
+    indexing.sType =
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+    VkPhysicalDeviceFeatures2 features = {};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &indexing;
+    vkGetPhysicalDeviceFeatures2(physical_device, &features);
+
+    const struct
+    {
+        VkBool32 supported;
+        const char* name;
+    } required[] = {
+        {features.features.shaderStorageBufferArrayDynamicIndexing,
+         "shaderStorageBufferArrayDynamicIndexing"},
+        {features.features.shaderSampledImageArrayDynamicIndexing,
+         "shaderSampledImageArrayDynamicIndexing"},
+        {indexing.runtimeDescriptorArray, "runtimeDescriptorArray"},
+        {indexing.descriptorBindingPartiallyBound,
+         "descriptorBindingPartiallyBound"},
+        {indexing.descriptorBindingUpdateUnusedWhilePending,
+         "descriptorBindingUpdateUnusedWhilePending"},
+        {indexing.descriptorBindingStorageBufferUpdateAfterBind,
+         "descriptorBindingStorageBufferUpdateAfterBind"},
+        {indexing.descriptorBindingSampledImageUpdateAfterBind,
+         "descriptorBindingSampledImageUpdateAfterBind"},
+    };
+    for (const auto& feature : required)
+    {
+        if (feature.supported != VK_TRUE)
+        {
+            error = feature.name;
+            return false;
+        }
+    }
+
+    support.features = {};
+    support.features.sType =
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+    support.features.runtimeDescriptorArray = VK_TRUE;
+    support.features.descriptorBindingPartiallyBound = VK_TRUE;
+    support.features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+    support.features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+    support.features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+
+    // A combined image sampler counts as both a sampler and an image.
+    support.max_buffers = std::min(
+        indexing_props.maxDescriptorSetUpdateAfterBindStorageBuffers,
+        indexing_props.maxPerStageDescriptorUpdateAfterBindStorageBuffers);
+    support.max_images = std::min(
+        {indexing_props.maxDescriptorSetUpdateAfterBindSampledImages,
+         indexing_props.maxDescriptorSetUpdateAfterBindSamplers,
+         indexing_props.maxPerStageDescriptorUpdateAfterBindSampledImages,
+         indexing_props.maxPerStageDescriptorUpdateAfterBindSamplers});
+    support.max_resources = std::min(
+        indexing_props.maxPerStageUpdateAfterBindResources,
+        indexing_props.maxUpdateAfterBindDescriptorsInAllPools);
+    return true;
+}
+
+uint32_t BindlessHeap::Array::acquire()
+{
+    if (!free.empty())
+    {
+        const uint32_t index = free.back();
+        free.pop_back();
+        ++used;
+        return index;
+    }
+    if (next == capacity)
+    {
+        return c_invalid_index;
+    }
+    ++used;
+    return next++;
+}
+
+void BindlessHeap::Array::release(uint32_t index)
+{
+    free.push_back(index);
+    --used;
+}
+
+BindlessHeap::BindlessHeap(
+    VkDevice device,
+    const BindlessSupport& support,
+    uint32_t buffers_capacity,
+    uint32_t images_capacity)
+    : device_(device)
+{
+    buffers_.capacity = std::min(
+        {buffers_capacity, support.max_buffers, support.max_resources});
+    images_.capacity = std::min(
+        {images_capacity,
+         support.max_images,
+         support.max_resources - buffers_.capacity});
+}
+
+BindlessHeap::~BindlessHeap()
+{
+    // Destroying the pool frees the set.
+    if (pool_ != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorPool(device_, pool_, nullptr);
+    }
+    if (layout_ != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorSetLayout(device_, layout_, nullptr);
+    }
+}
+
+VkResult BindlessHeap::create()
+{
+    VkDescriptorSetLayoutBinding bindings[2] = {};
+    bindings[0].binding = c_buffers_binding;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[0].descriptorCount = buffers_.capacity;
+    bindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+    bindings[1].binding = c_images_binding;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[1].descriptorCount = images_.capacity;
+    bindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+
+    const VkDescriptorBindingFlags binding_flag =
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+        VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+    const VkDescriptorBindingFlags binding_flags[2] = {
+        binding_flag, binding_flag};
+    VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info = {};
+    binding_flags_info.sType =
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    binding_flags_info.bindingCount = 2;
+    binding_flags_info.pBindingFlags = binding_flags;
+
+    VkDescriptorSetLayoutCreateInfo layout_info = {};
+    layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layout_info.pNext = &binding_flags_info;
+    layout_info.flags =
+        VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layout_info.bindingCount = 2;
+    layout_info.pBindings = bindings;
+    if (VkResult result = vkCreateDescriptorSetLayout(
+            device_, &layout_info, nullptr, &layout_);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkDescriptorPoolSize pool_sizes[2] = {};
+    pool_sizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    pool_sizes[0].descriptorCount = std::max(buffers_.capacity, 1u);
+    pool_sizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    pool_sizes[1].descriptorCount = std::max(images_.capacity, 1u);
+
+    VkDescriptorPoolCreateInfo pool_info = {};
+    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    pool_info.maxSets = 1;
+    pool_info.poolSizeCount = 2;
+    pool_info.pPoolSizes = pool_sizes;
+    if (VkResult result =
+            vkCreateDescriptorPool(device_, &pool_info, nullptr, &pool_);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkDescriptorSetAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorPool = pool_;
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.pSetLayouts = &layout_;
+    return vkAllocateDescriptorSets(device_, &alloc_info, &set_);
+}
+
+uint32_t BindlessHeap::addBuffer(const VkDescriptorBufferInfo& info)
+{
+    const uint32_t index = buffers_.acquire();
+    if (index == c_invalid_index)
+    {
+        return index;
+    }
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set_;
+    write.dstBinding = c_buffers_binding;
+    write.dstArrayElement = index;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = &info;
+    vkUpdateDescriptorSets(device_, 1, &write, 0, nullptr);
+    return index;
+}
+
+uint32_t BindlessHeap::addImage(const VkDescriptorImageInfo& info)
+{
+    const uint32_t index = images_.acquire();
+    if (index == c_invalid_index)
+    {
+        return index;
+    }
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set_;
+    write.dstBinding = c_images_binding;
+    write.dstArrayElement = index;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &info;
+    vkUpdateDescriptorSets(device_, 1, &write, 0, nullptr);
+    return index;
+}
+
+void BindlessHeap::removeBuffer(uint32_t index)
+{
+    // The stale descriptor stays in place until the index is reused;
+    // partially bound arrays allow it as long as no shader reads it.
+    buffers_.release(index);
+}
+
+void BindlessHeap::removeImage(uint32_t index)
+{
+    images_.release(index);
+}
+
+void BindlessHeap::writeStats(std::ostream& out) const
+{
+    out << "Bindless heap: " << buffers_.used << "/" << buffers_.capacity
+        << " buffers, " << images_.used << "/" << images_.capacity
+        << " images" << std::endl;
+}
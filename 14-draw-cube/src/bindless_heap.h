@@ -0,0 +1,127 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/** What a device offers for BindlessHeap, see queryBindlessSupport(). */
+struct BindlessSupport
+{
+    // Only the features the heap relies on are set. To be chained into
+    // VkDeviceCreateInfo::pNext, together with the dynamic indexing of
+    // storage buffer and sampled image arrays in VkPhysicalDeviceFeatures.
+    VkPhysicalDeviceDescriptorIndexingFeatures features = {};
+    uint32_t max_buffers = 0;
+    uint32_t max_images = 0;
+    // Shared by the buffers and images in every stage.
+    uint32_t max_resources = 0;
+};
+
+/**
+ * Checks that the device supports Vulkan 1.2 and the descriptor indexing
+ * features of BindlessHeap. The instance must be created for Vulkan 1.2
+ * too. On failure error names the first missing piece.
+ */
+bool queryBindlessSupport(
+    VkPhysicalDevice physical_device,
+    BindlessSupport& support,
+    std::string& error);
+
+/**
+ * One global descriptor set holding every buffer and texture: binding 0 is
+ * a runtime array of storage buffers, binding 1 one of combined image
+ * samplers, both visible to all stages. Shaders index them with integers
+ * passed per draw, usually through push constants, so a frame binds the
+ * set once and the draws only change those integers.
+ *
+ * The bindings are update after bind and partially bound: descriptors can
+ * be added while command buffers using the set are recorded or pending, as
+ * long as those don't access them. Removed indices are handed out again,
+ * so a descriptor must only be removed once no pending frame uses it.
+ */
+class BindlessHeap
+{
+public:
+    static constexpr uint32_t c_buffers_binding = 0;
+    static constexpr uint32_t c_images_binding = 1;
+    static constexpr uint32_t c_invalid_index =
+        std::numeric_limits<uint32_t>::max();
+
+    /** The capacities are clamped to the limits in support. */
+    BindlessHeap(
+        VkDevice device,
+        const BindlessSupport& support,
+        uint32_t buffers_capacity,
+        uint32_t images_capacity);
+    ~BindlessHeap();
+
+    BindlessHeap(const BindlessHeap&) = delete;
+    BindlessHeap& operator=(const BindlessHeap&) = delete;
+
+    VkResult create();
+
+    VkDescriptorSetLayout layout() const { return layout_; }
+    VkDescriptorSet set() const { return set_; }
+
+    /**
+     * Writes the descriptor and returns its index in the array of its
+     * binding, c_invalid_index when the array is full.
+     */
+    uint32_t addBuffer(const VkDescriptorBufferInfo& info);
+    uint32_t addImage(const VkDescriptorImageInfo& info);
+
+    void removeBuffer(uint32_t index);
+    void removeImage(uint32_t index);
+
+    void writeStats(std::ostream& out) const;
+
+private:
+    struct Array
+    {
+        uint32_t capacity = 0;
+        // Indices below next have been handed out before.
+        uint32_t next = 0;
+        std::vector<uint32_t> free;
+        uint32_t used = 0;
+
+        uint32_t acquire();
+        void release(uint32_t index);
+    };
+
+    VkDevice device_;
+
+    VkDescriptorSetLayout layout_ = VK_NULL_HANDLE;
+    VkDescriptorPool pool_ = VK_NULL_HANDLE;
+    VkDescriptorSet set_ = VK_NULL_HANDLE;
+
+    Array buffers_;
+    Array images_;
+};
@@ -0,0 +1,418 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cpu_culler.h"
+
+#include <algorithm>
+#include <cmath>
+
+// AVX2 kernels are compiled with a function target attribute and picked
+// at runtime on GCC and Clang; MSVC builds use them with /arch:AVX2.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CPU_CULLER_SSE2 1
+#define CPU_CULLER_AVX2 1
+#define CPU_CULLER_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define CPU_CULLER_SSE2 1
+#if defined(__AVX2__)
+#define CPU_CULLER_AVX2 1
+#endif
+#define CPU_CULLER_TARGET_AVX2
+#endif
+
+namespace {
+
+/** Planes scaled to unit normals, so sphere radii compare directly. */
+struct CullPlanes
+{
+    float nx[6];
+    float ny[6];
+    float nz[6];
+    float d[6];
+};
+
+CullPlanes makeCullPlanes(const Frustum& frustum)
+{
+    CullPlanes planes = {};
+    for (std::size_t i = 0; i < frustum.planes.size(); ++i)
+    {
+        const glm::vec4& plane = frustum.planes[i];
+        const float length = std::sqrt(
+            plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        const float scale = length > 0.f ? 1.f / length : 0.f;
+        planes.nx[i] = plane.x * scale;
+        planes.ny[i] = plane.y * scale;
+        planes.nz[i] = plane.z * scale;
+        planes.d[i] = plane.w * scale;
+    }
+    return planes;
+}
+
+/** Read only view of the volume arrays. */
+struct VolumeArrays
+{
+    const float* cx;
+    const float* cy;
+    const float* cz;
+    const float* ex;
+    const float* ey;
+    const float* ez;
+    const float* radius;
+};
+
+bool isVisibleScalar(
+    const CullPlanes& planes,
+    const VolumeArrays& v,
+    CullVolume volume,
+    std::size_t i)
+{
+    for (int p = 0; p < 6; ++p)
+    {
+        const float distance = planes.nx[p] * v.cx[i] +
+                               planes.ny[p] * v.cy[i] +
+                               planes.nz[p] * v.cz[i] + planes.d[p];
+        const float radius =
+            volume == CullVolume::Sphere
+                ? v.radius[i]
+                : std::fabs(planes.nx[p]) * v.ex[i] +
+                      std::fabs(planes.ny[p]) * v.ey[i] +
+                      std::fabs(planes.nz[p]) * v.ez[i];
+        if (distance < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void cullScalar(
+    const CullPlanes& planes,
+    const VolumeArrays& v,
+    CullVolume volume,
+    std::size_t begin,
+    std::size_t end,
+    std::vector<uint32_t>& visible)
+{
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        if (isVisibleScalar(planes, v, volume, i))
+        {
+            visible.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+/** Appends first + the index of every set bit. */
+void appendMask(uint32_t mask, std::size_t first, std::vector<uint32_t>& out)
+{
+    while (mask != 0)
+    {
+        uint32_t bit = 0;
+        while ((mask & (1u << bit)) == 0)
+        {
+            ++bit;
+        }
+        out.push_back(static_cast<uint32_t>(first + bit));
+        mask &= mask - 1;
+    }
+}
+
+#if CPU_CULLER_SSE2
+void cullSse2(
+    const CullPlanes& planes,
+    const VolumeArrays& v,
+    CullVolume volume,
+    std::size_t begin,
+    std::size_t end,
+    std::vector<uint32_t>& visible)
+{
+    const __m128 sign_mask = _mm_set1_ps(-0.f);
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        const __m128 cx = _mm_loadu_ps(v.cx + i);
+        const __m128 cy = _mm_loadu_ps(v.cy + i);
+        const __m128 cz = _mm_loadu_ps(v.cz + i);
+        const __m128 ex = _mm_loadu_ps(v.ex + i);
+        const __m128 ey = _mm_loadu_ps(v.ey + i);
+        const __m128 ez = _mm_loadu_ps(v.ez + i);
+        const __m128 sphere_radius = _mm_loadu_ps(v.radius + i);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p)
+        {
+            const __m128 nx = _mm_set1_ps(planes.nx[p]);
+            const __m128 ny = _mm_set1_ps(planes.ny[p]);
+            const __m128 nz = _mm_set1_ps(planes.nz[p]);
+            const __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)),
+                _mm_add_ps(_mm_mul_ps(nz, cz), _mm_set1_ps(planes.d[p])));
+            __m128 radius = sphere_radius;
+            if (volume == CullVolume::Box)
+            {
+                radius = _mm_add_ps(
+                    _mm_add_ps(
+                        _mm_mul_ps(_mm_andnot_ps(sign_mask, nx), ex),
+                        _mm_mul_ps(_mm_andnot_ps(sign_mask, ny), ey)),
+                    _mm_mul_ps(_mm_andnot_ps(sign_mask, nz), ez));
+            }
+            // distance + radius >= 0
+            inside = _mm_and_ps(
+                inside,
+                _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+        }
+        appendMask(
+            static_cast<uint32_t>(_mm_movemask_ps(inside)), i, visible);
+    }
+    cullScalar(planes, v, volume, i, end, visible);
+}
+#endif
+
+#if CPU_CULLER_AVX2
+CPU_CULLER_TARGET_AVX2 void cullAvx2(
+    const CullPlanes& planes,
+    const VolumeArrays& v,
+    CullVolume volume,
+    std::size_t begin,
+    std::size_t end,
+    std::vector<uint32_t>& visible)
+{
+    const __m256 sign_mask = _mm256_set1_ps(-0.f);
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8)
+    {
+        const __m256 cx = _mm256_loadu_ps(v.cx + i);
+        const __m256 cy = _mm256_loadu_ps(v.cy + i);
+        const __m256 cz = _mm256_loadu_ps(v.cz + i);
+        const __m256 ex = _mm256_loadu_ps(v.ex + i);
+        const __m256 ey = _mm256_loadu_ps(v.ey + i);
+        const __m256 ez = _mm256_loadu_ps(v.ez + i);
+        const __m256 sphere_radius = _mm256_loadu_ps(v.radius + i);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p)
+        {
+            const __m256 nx = _mm256_set1_ps(planes.nx[p]);
+            const __m256 ny = _mm256_set1_ps(planes.ny[p]);
+            const __m256 nz = _mm256_set1_ps(planes.nz[p]);
+            const __m256 distance = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(nx, cx), _mm256_mul_ps(ny, cy)),
+                _mm256_add_ps(
+                    _mm256_mul_ps(nz, cz), _mm256_set1_ps(planes.d[p])));
+            __m256 radius = sphere_radius;
+            if (volume == CullVolume::Box)
+            {
+                radius = _mm256_add_ps(
+                    _mm256_add_ps(
+                        _mm256_mul_ps(_mm256_andnot_ps(sign_mask, nx), ex),
+                        _mm256_mul_ps(_mm256_andnot_ps(sign_mask, ny), ey)),
+                    _mm256_mul_ps(_mm256_andnot_ps(sign_mask, nz), ez));
+            }
+            inside = _mm256_and_ps(
+                inside,
+                _mm256_cmp_ps(
+                    _mm256_add_ps(distance, radius),
+                    _mm256_setzero_ps(),
+                    _CMP_GE_OQ));
+        }
+        appendMask(
+            static_cast<uint32_t>(_mm256_movemask_ps(inside)), i, visible);
+    }
+    cullScalar(planes, v, volume, i, end, visible);
+}
+#endif
+
+} // namespace
+
+void BoundingVolumes::reserve(std::size_t count)
+{
+    for (auto* array : {&center_x_,
+                        &center_y_,
+                        &center_z_,
+                        &extent_x_,
+                        &extent_y_,
+                        &extent_z_,
+                        &radius_})
+    {
+        array->reserve(count);
+    }
+}
+
+void BoundingVolumes::clear()
+{
+    for (auto* array : {&center_x_,
+                        &center_y_,
+                        &center_z_,
+                        &extent_x_,
+                        &extent_y_,
+                        &extent_z_,
+                        &radius_})
+    {
+        array->clear();
+    }
+}
+
+void BoundingVolumes::add(const glm::vec3& center, const glm::vec3& extent)
+{
+    center_x_.push_back(center.x);
+    center_y_.push_back(center.y);
+    center_z_.push_back(center.z);
+    extent_x_.push_back(extent.x);
+    extent_y_.push_back(extent.y);
+    extent_z_.push_back(extent.z);
+    radius_.push_back(std::sqrt(
+        extent.x * extent.x + extent.y * extent.y + extent.z * extent.z));
+}
+
+CpuCuller::CpuCuller(ThreadPool& thread_pool, std::size_t chunk_size)
+    : thread_pool_(thread_pool)
+    , chunk_size_(chunk_size)
+{
+}
+
+CullIsa CpuCuller::bestIsa()
+{
+    if (isaSupported(CullIsa::Avx2))
+    {
+        return CullIsa::Avx2;
+    }
+    if (isaSupported(CullIsa::Sse2))
+    {
+        return CullIsa::Sse2;
+    }
+    return CullIsa::Scalar;
+}
+
+bool CpuCuller::isaSupported(CullIsa isa)
+{
+    switch (isa)
+    {
+    case CullIsa::Scalar:
+        return true;
+    case CullIsa::Sse2:
+#if CPU_CULLER_SSE2
+        return true;
+#else
+        return false;
+#endif
+    case CullIsa::Avx2:
+#if CPU_CULLER_AVX2 && defined(__GNUC__)
+        return __builtin_cpu_supports("avx2") != 0;
+#elif CPU_CULLER_AVX2
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+void CpuCuller::cull(
+    const Frustum& frustum,
+    const BoundingVolumes& volumes,
+    CullVolume volume,
+    CullIsa isa,
+    std::vector<uint32_t>& visible)
+{
+    const CullPlanes planes = makeCullPlanes(frustum);
+    const VolumeArrays arrays = {volumes.center_x_.data(),
+                                 volumes.center_y_.data(),
+                                 volumes.center_z_.data(),
+                                 volumes.extent_x_.data(),
+                                 volumes.extent_y_.data(),
+                                 volumes.extent_z_.data(),
+                                 volumes.radius_.data()};
+    if (!isaSupported(isa))
+    {
+        isa = bestIsa();
+    }
+
+    const std::size_t count = volumes.size();
+    const std::size_t chunks_num = (count + chunk_size_ - 1) / chunk_size_;
+    if (chunk_visible_.size() < chunks_num)
+    {
+        chunk_visible_.resize(chunks_num);
+    }
+
+    thread_pool_.parallelFor(
+        count,
+        chunk_size_,
+        [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            std::vector<uint32_t>& out = chunk_visible_[chunk];
+            out.clear();
+            switch (isa)
+            {
+#if CPU_CULLER_AVX2
+            case CullIsa::Avx2:
+                cullAvx2(planes, arrays, volume, begin, end, out);
+                break;
+#endif
+#if CPU_CULLER_SSE2
+            case CullIsa::Sse2:
+                cullSse2(planes, arrays, volume, begin, end, out);
+                break;
+#endif
+            default:
+                cullScalar(planes, arrays, volume, begin, end, out);
+                break;
+            }
+        });
+
+    visible.clear();
+    for (std::size_t chunk = 0; chunk < chunks_num; ++chunk)
+    {
+        visible.insert(
+            visible.end(),
+            chunk_visible_[chunk].begin(),
+            chunk_visible_[chunk].end());
+    }
+}
+
+const char* toString(CullVolume volume)
+{
+    switch (volume)
+    {
+    case CullVolume::Sphere:
+        return "sphere";
+    case CullVolume::Box:
+        return "box";
+    }
+    return "unknown";
+}
+
+const char* toString(CullIsa isa)
+{
+    switch (isa)
+    {
+    case CullIsa::Scalar:
+        return "scalar";
+    case CullIsa::Sse2:
+        return "sse2";
+    case CullIsa::Avx2:
+        return "avx2";
+    }
+    return "unknown";
+}
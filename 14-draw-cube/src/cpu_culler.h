@@ -0,0 +1,109 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "frustum.h"
+#include "thread_pool.h"
+
+/**
+ * World space bounding volumes of objects in structure of arrays layout,
+ * so a SIMD register holds one component of several objects. Every object
+ * has an axis aligned box (center, half extent) and the sphere around it.
+ */
+class BoundingVolumes
+{
+public:
+    void reserve(std::size_t count);
+    void clear();
+    void add(const glm::vec3& center, const glm::vec3& extent);
+
+    std::size_t size() const { return center_x_.size(); }
+
+private:
+    friend class CpuCuller;
+
+    std::vector<float> center_x_;
+    std::vector<float> center_y_;
+    std::vector<float> center_z_;
+    std::vector<float> extent_x_;
+    std::vector<float> extent_y_;
+    std::vector<float> extent_z_;
+    std::vector<float> radius_;
+};
+
+enum class CullVolume
+{
+    Sphere,
+    Box,
+};
+
+/** Instruction set of the culling kernel. */
+enum class CullIsa
+{
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+/**
+ * Frustum culling of bounding volumes on the CPU. The volumes are split
+ * into chunks that the threads of the pool test independently; the visible
+ * indices of every chunk are merged in order, so the output is the same
+ * for any thread count.
+ */
+class CpuCuller
+{
+public:
+    static constexpr std::size_t c_default_chunk_size = 4096;
+
+    explicit CpuCuller(
+        ThreadPool& thread_pool,
+        std::size_t chunk_size = c_default_chunk_size);
+
+    /** Best kernel the CPU runs, picked at runtime where possible. */
+    static CullIsa bestIsa();
+    static bool isaSupported(CullIsa isa);
+
+    /** Replaces visible with the ascending indices of the visible volumes. */
+    void cull(
+        const Frustum& frustum,
+        const BoundingVolumes& volumes,
+        CullVolume volume,
+        CullIsa isa,
+        std::vector<uint32_t>& visible);
+
+private:
+    ThreadPool& thread_pool_;
+    const std::size_t chunk_size_;
+    std::vector<std::vector<uint32_t>> chunk_visible_;
+};
+
+const char* toString(CullVolume volume);
+const char* toString(CullIsa isa);
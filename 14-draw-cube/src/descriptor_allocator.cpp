@@ -0,0 +1,353 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "descriptor_allocator.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "file_utils.h"
+
+namespace {
+
+struct PoolRatio
+{
+    VkDescriptorType type;
+    float per_set;
+};
+
+// Descriptors of each type per set in a new pool.
+const PoolRatio c_pool_ratios[] = {
+    {VK_DESCRIPTOR_TYPE_SAMPLER, 0.5f},
+    {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f},
+    {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 4.0f},
+    {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f},
+    {VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, 1.0f},
+    {VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, 1.0f},
+    {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2.0f},
+    {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2.0f},
+    {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f},
+    {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1.0f},
+    {VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 0.5f},
+};
+
+uint32_t poolDescriptorsNum(std::size_t ratio_index, uint32_t sets_num)
+{
+    return std::max(
+        1u,
+        static_cast<uint32_t>(c_pool_ratios[ratio_index].per_set * sets_num));
+}
+
+// Types the pools hold none of map past the end of c_pool_ratios.
+std::size_t ratioIndex(VkDescriptorType type)
+{
+    return static_cast<std::size_t>(std::distance(
+        std::begin(c_pool_ratios),
+        std::find_if(
+            std::begin(c_pool_ratios),
+            std::end(c_pool_ratios),
+            [type](const PoolRatio& ratio) { return ratio.type == type; })));
+}
+
+} // namespace
+
+DescriptorAllocator::DescriptorAllocator(
+    VkDevice device, uint32_t sets_per_pool)
+    : device_(device)
+    , sets_per_pool_(std::clamp(sets_per_pool, 1u, c_max_sets_per_pool))
+    , descriptors_left_(std::size(c_pool_ratios))
+{
+}
+
+DescriptorAllocator::~DescriptorAllocator()
+{
+    for (const Pool& pool : used_pools_)
+    {
+        vkDestroyDescriptorPool(device_, pool.pool, nullptr);
+    }
+    for (const Pool& pool : free_pools_)
+    {
+        vkDestroyDescriptorPool(device_, pool.pool, nullptr);
+    }
+}
+
+VkResult DescriptorAllocator::allocate(
+    VkDescriptorSetLayout layout,
+    const std::vector<VkDescriptorPoolSize>& layout_sizes,
+    VkDescriptorSet& set)
+{
+    VkDescriptorSetAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.pSetLayouts = &layout;
+
+    for (bool retried = false;; retried = true)
+    {
+        if (VkResult result = selectPool(layout_sizes); result != VK_SUCCESS)
+        {
+            return result;
+        }
+
+        alloc_info.descriptorPool = current_pool_;
+        VkResult result = vkAllocateDescriptorSets(device_, &alloc_info, &set);
+        if (result == VK_SUCCESS)
+        {
+            --sets_left_;
+            for (const VkDescriptorPoolSize& size : layout_sizes)
+            {
+                descriptors_left_[ratioIndex(size.type)] -=
+                    size.descriptorCount;
+            }
+            return VK_SUCCESS;
+        }
+
+        // A device that reports a full pool the counts missed gets one more
+        // pool, a fresh pool that can't hold the set never will.
+        if (retried || (result != VK_ERROR_OUT_OF_POOL_MEMORY &&
+                        result != VK_ERROR_FRAGMENTED_POOL))
+        {
+            return result;
+        }
+        sets_left_ = 0;
+    }
+}
+
+VkResult DescriptorAllocator::reset()
+{
+    for (const Pool& pool : used_pools_)
+    {
+        if (VkResult result = vkResetDescriptorPool(device_, pool.pool, 0);
+            result != VK_SUCCESS)
+        {
+            return result;
+        }
+        free_pools_.push_back(pool);
+    }
+    used_pools_.clear();
+    current_pool_ = VK_NULL_HANDLE;
+    sets_left_ = 0;
+    return VK_SUCCESS;
+}
+
+VkResult DescriptorAllocator::selectPool(
+    const std::vector<VkDescriptorPoolSize>& layout_sizes)
+{
+    while (!fits(layout_sizes))
+    {
+        const bool fresh_pool = free_pools_.empty();
+        if (VkResult result = nextPool(); result != VK_SUCCESS)
+        {
+            return result;
+        }
+        if (fresh_pool && !fits(layout_sizes))
+        {
+            return VK_ERROR_OUT_OF_POOL_MEMORY;
+        }
+    }
+    return VK_SUCCESS;
+}
+
+bool DescriptorAllocator::fits(
+    const std::vector<VkDescriptorPoolSize>& layout_sizes) const
+{
+    if (sets_left_ == 0)
+    {
+        return false;
+    }
+
+    // A layout may list a type more than once, one entry per binding.
+    uint32_t needed[std::size(c_pool_ratios)] = {};
+    for (const VkDescriptorPoolSize& size : layout_sizes)
+    {
+        const std::size_t index = ratioIndex(size.type);
+        if (index == std::size(c_pool_ratios))
+        {
+            return false;
+        }
+        needed[index] += size.descriptorCount;
+        if (needed[index] > descriptors_left_[index])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+VkResult DescriptorAllocator::nextPool()
+{
+    // Reused pools come out of free_pools_ in creation order, the largest
+    // ones last.
+    if (!free_pools_.empty())
+    {
+        const Pool pool = free_pools_.front();
+        free_pools_.erase(free_pools_.begin());
+        used_pools_.push_back(pool);
+        current_pool_ = pool.pool;
+        sets_left_ = pool.max_sets;
+        for (std::size_t i = 0; i < std::size(c_pool_ratios); ++i)
+        {
+            descriptors_left_[i] = poolDescriptorsNum(i, pool.max_sets);
+        }
+        return VK_SUCCESS;
+    }
+
+    VkDescriptorPoolSize pool_sizes[std::size(c_pool_ratios)] = {};
+    for (std::size_t i = 0; i < std::size(c_pool_ratios); ++i)
+    {
+        pool_sizes[i].type = c_pool_ratios[i].type;
+        pool_sizes[i].descriptorCount = poolDescriptorsNum(i, sets_per_pool_);
+    }
+
+    VkDescriptorPoolCreateInfo pool_info = {};
+    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.maxSets = sets_per_pool_;
+    pool_info.poolSizeCount = static_cast<uint32_t>(std::size(pool_sizes));
+    pool_info.pPoolSizes = pool_sizes;
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    if (VkResult result =
+            vkCreateDescriptorPool(device_, &pool_info, nullptr, &pool);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+    current_pool_ = pool;
+    used_pools_.push_back({pool, sets_per_pool_});
+    sets_left_ = sets_per_pool_;
+    for (std::size_t i = 0; i < std::size(c_pool_ratios); ++i)
+    {
+        descriptors_left_[i] = pool_sizes[i].descriptorCount;
+    }
+    sets_per_pool_ = std::min(sets_per_pool_ * 2, c_max_sets_per_pool);
+    return VK_SUCCESS;
+}
+
+DescriptorSetCache::DescriptorSetCache(
+    VkDevice device, DescriptorAllocator& allocator)
+    : device_(device)
+    , allocator_(allocator)
+{
+}
+
+VkResult DescriptorSetCache::get(
+    VkDescriptorSetLayout layout,
+    const std::vector<DescriptorBufferBinding>& buffers,
+    const std::vector<DescriptorImageBinding>& images,
+    VkDescriptorSet& set)
+{
+    // Layout, then every binding in the order given; callers that list
+    // the same bindings in another order just get a second set.
+    std::vector<uint64_t> key;
+    key.reserve(1 + buffers.size() * 5 + images.size() * 5);
+    key.push_back(reinterpret_cast<uint64_t>(layout));
+    for (const DescriptorBufferBinding& buffer : buffers)
+    {
+        key.push_back(buffer.binding);
+        key.push_back(buffer.type);
+        key.push_back(reinterpret_cast<uint64_t>(buffer.info.buffer));
+        key.push_back(buffer.info.offset);
+        key.push_back(buffer.info.range);
+    }
+    for (const DescriptorImageBinding& image : images)
+    {
+        key.push_back(image.binding);
+        key.push_back(image.type);
+        key.push_back(reinterpret_cast<uint64_t>(image.info.sampler));
+        key.push_back(reinterpret_cast<uint64_t>(image.info.imageView));
+        key.push_back(image.info.imageLayout);
+    }
+
+    auto it = sets_.find(key);
+    if (it != sets_.end())
+    {
+        ++hits_;
+        set = it->second;
+        return VK_SUCCESS;
+    }
+
+    // Every binding holds one descriptor.
+    std::vector<VkDescriptorPoolSize> layout_sizes;
+    layout_sizes.reserve(buffers.size() + images.size());
+    for (const DescriptorBufferBinding& buffer : buffers)
+    {
+        layout_sizes.push_back({buffer.type, 1});
+    }
+    for (const DescriptorImageBinding& image : images)
+    {
+        layout_sizes.push_back({image.type, 1});
+    }
+
+    if (VkResult result = allocator_.allocate(layout, layout_sizes, set);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    std::vector<VkWriteDescriptorSet> writes;
+    writes.reserve(buffers.size() + images.size());
+    for (const DescriptorBufferBinding& buffer : buffers)
+    {
+        VkWriteDescriptorSet write = {};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = set;
+        write.dstBinding = buffer.binding;
+        write.descriptorCount = 1;
+        write.descriptorType = buffer.type;
+        write.pBufferInfo = &buffer.info;
+        writes.push_back(write);
+    }
+    for (const DescriptorImageBinding& image : images)
+    {
+        VkWriteDescriptorSet write = {};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = set;
+        write.dstBinding = image.binding;
+        write.descriptorCount = 1;
+        write.descriptorType = image.type;
+        write.pImageInfo = &image.info;
+        writes.push_back(write);
+    }
+    vkUpdateDescriptorSets(
+        device_,
+        static_cast<uint32_t>(writes.size()),
+        writes.data(),
+        0,
+        nullptr);
+    ++writes_;
+
+    sets_.emplace(std::move(key), set);
+    return VK_SUCCESS;
+}
+
+void DescriptorSetCache::writeStats(std::ostream& out) const
+{
+    out << "Descriptor sets: " << sets_.size() << " cached, " << writes_
+        << " written, " << hits_ << " reused" << std::endl;
+}
+
+std::size_t DescriptorSetCache::KeyHash::operator()(
+    const std::vector<uint64_t>& key) const
+{
+    return static_cast<std::size_t>(
+        fnv1a(key.data(), key.size() * sizeof(uint64_t)));
+}
@@ -0,0 +1,155 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Hands out descriptor sets of any layout from a growing list of pools.
+ * A pool that runs out of sets or descriptors is retired and the next
+ * one, twice as large up to c_max_sets_per_pool, takes over. reset()
+ * returns every set at once and keeps the pools for reuse, which makes
+ * one allocator per frame in flight a cheap home for transient sets.
+ *
+ * Pool sizes follow fixed per type ratios; a layout that needs more of
+ * one type than a fresh pool holds can't be allocated.
+ *
+ * The sets and descriptors left in the current pool are counted, and a set
+ * that would overflow it goes to the next pool right away: only Vulkan 1.1
+ * and VK_KHR_maintenance1 promise VK_ERROR_OUT_OF_POOL_MEMORY for a full
+ * pool, on other 1.0 devices allocating from it is undefined.
+ */
+class DescriptorAllocator
+{
+public:
+    static constexpr uint32_t c_max_sets_per_pool = 4096;
+
+    explicit DescriptorAllocator(VkDevice device, uint32_t sets_per_pool = 64);
+    ~DescriptorAllocator();
+
+    DescriptorAllocator(const DescriptorAllocator&) = delete;
+    DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+    /** layout_sizes counts the descriptors of each type in the layout. */
+    VkResult allocate(
+        VkDescriptorSetLayout layout,
+        const std::vector<VkDescriptorPoolSize>& layout_sizes,
+        VkDescriptorSet& set);
+
+    /**
+     * Frees all sets of the allocator. None of them may be used by a
+     * pending command buffer.
+     */
+    VkResult reset();
+
+    uint32_t poolsNum() const
+    {
+        return static_cast<uint32_t>(used_pools_.size() + free_pools_.size());
+    }
+
+private:
+    struct Pool
+    {
+        VkDescriptorPool pool = VK_NULL_HANDLE;
+        uint32_t max_sets = 0;
+    };
+
+    /** Makes the first pool the set fits in current. */
+    VkResult selectPool(const std::vector<VkDescriptorPoolSize>& layout_sizes);
+    VkResult nextPool();
+    bool fits(const std::vector<VkDescriptorPoolSize>& layout_sizes) const;
+
+    VkDevice device_;
+    uint32_t sets_per_pool_;
+
+    VkDescriptorPool current_pool_ = VK_NULL_HANDLE;
+    uint32_t sets_left_ = 0;
+    // Left in the current pool, by pool size ratio.
+    std::vector<uint32_t> descriptors_left_;
+    std::vector<Pool> used_pools_;
+    std::vector<Pool> free_pools_;
+};
+
+struct DescriptorBufferBinding
+{
+    uint32_t binding = 0;
+    VkDescriptorType type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    VkDescriptorBufferInfo info = {};
+};
+
+struct DescriptorImageBinding
+{
+    uint32_t binding = 0;
+    VkDescriptorType type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    VkDescriptorImageInfo info = {};
+};
+
+/**
+ * Descriptor sets keyed by their layout and the resources bound to them.
+ * Asking again for the same combination returns the set written the first
+ * time, so steady state frames don't call vkUpdateDescriptorSets at all.
+ * The bindings given must cover every binding of the layout.
+ *
+ * Sets are never freed individually: clear() the cache together with a
+ * reset() of its allocator, and before a bound resource is destroyed and
+ * its handle could be reused.
+ */
+class DescriptorSetCache
+{
+public:
+    DescriptorSetCache(VkDevice device, DescriptorAllocator& allocator);
+
+    DescriptorSetCache(const DescriptorSetCache&) = delete;
+    DescriptorSetCache& operator=(const DescriptorSetCache&) = delete;
+
+    VkResult get(
+        VkDescriptorSetLayout layout,
+        const std::vector<DescriptorBufferBinding>& buffers,
+        const std::vector<DescriptorImageBinding>& images,
+        VkDescriptorSet& set);
+
+    void clear() { sets_.clear(); }
+
+    void writeStats(std::ostream& out) const;
+
+private:
+    struct KeyHash
+    {
+        std::size_t operator()(const std::vector<uint64_t>& key) const;
+    };
+
+    VkDevice device_;
+    DescriptorAllocator& allocator_;
+
+    std::unordered_map<std::vector<uint64_t>, VkDescriptorSet, KeyHash> sets_;
+    uint64_t hits_ = 0;
+    uint64_t writes_ = 0;
+};
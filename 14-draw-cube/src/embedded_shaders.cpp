@@ -0,0 +1,1220 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "embedded_shaders.h"
+
+/**
+ *  #version 400
+ *  #extension GL_ARB_separate_shader_objects : enable
+ *  #extension GL_ARB_shading_language_420pack : enable
+ *  layout (std140, binding = 0) uniform bufferVals {
+ *      mat4 mvp;
+ *  } u_buffer_vals;
+ *  layout (location = 0) in vec4 in_pos;
+ *  layout (location = 1) in vec4 in_color;
+ *  layout (location = 0) out vec4 out_color;
+ *  void main() {
+ *     out_color = in_color;
+ *     gl_Position = u_buffer_vals.mvp * in_pos;
+ *  }
+ */
+const std::vector<uint8_t> c_vert_shader = {
+    0x03, 0x02, 0x23, 0x07, 0x00, 0x00, 0x01, 0x00, 0x06, 0x00, 0x08, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x47, 0x4C, 0x53, 0x4C, 0x2E, 0x73, 0x74, 0x64, 0x2E, 0x34, 0x35, 0x30,
+    0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00,
+    0x1C, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x90, 0x01, 0x00, 0x00, 0x04, 0x00, 0x09, 0x00, 0x47, 0x4C, 0x5F, 0x41,
+    0x52, 0x42, 0x5F, 0x73, 0x65, 0x70, 0x61, 0x72, 0x61, 0x74, 0x65, 0x5F,
+    0x73, 0x68, 0x61, 0x64, 0x65, 0x72, 0x5F, 0x6F, 0x62, 0x6A, 0x65, 0x63,
+    0x74, 0x73, 0x00, 0x00, 0x04, 0x00, 0x09, 0x00, 0x47, 0x4C, 0x5F, 0x41,
+    0x52, 0x42, 0x5F, 0x73, 0x68, 0x61, 0x64, 0x69, 0x6E, 0x67, 0x5F, 0x6C,
+    0x61, 0x6E, 0x67, 0x75, 0x61, 0x67, 0x65, 0x5F, 0x34, 0x32, 0x30, 0x70,
+    0x61, 0x63, 0x6B, 0x00, 0x05, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x6F, 0x75, 0x74, 0x5F, 0x63, 0x6F, 0x6C, 0x6F,
+    0x72, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0x69, 0x6E, 0x5F, 0x63, 0x6F, 0x6C, 0x6F, 0x72, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x06, 0x00, 0x10, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x50,
+    0x65, 0x72, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78, 0x00, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x06, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x67, 0x6C, 0x5F, 0x50, 0x6F, 0x73, 0x69, 0x74, 0x69, 0x6F, 0x6E, 0x00,
+    0x06, 0x00, 0x07, 0x00, 0x10, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x67, 0x6C, 0x5F, 0x50, 0x6F, 0x69, 0x6E, 0x74, 0x53, 0x69, 0x7A, 0x65,
+    0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x07, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x43, 0x6C, 0x69, 0x70, 0x44,
+    0x69, 0x73, 0x74, 0x61, 0x6E, 0x63, 0x65, 0x00, 0x05, 0x00, 0x03, 0x00,
+    0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00,
+    0x16, 0x00, 0x00, 0x00, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x56, 0x61,
+    0x6C, 0x73, 0x00, 0x00, 0x06, 0x00, 0x04, 0x00, 0x16, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x6D, 0x76, 0x70, 0x00, 0x05, 0x00, 0x06, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x75, 0x5F, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72,
+    0x5F, 0x76, 0x61, 0x6C, 0x73, 0x00, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00,
+    0x1C, 0x00, 0x00, 0x00, 0x69, 0x6E, 0x5F, 0x70, 0x6F, 0x73, 0x00, 0x00,
+    0x47, 0x00, 0x04, 0x00, 0x09, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x48, 0x00, 0x04, 0x00,
+    0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x05, 0x00, 0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00, 0x16, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x18, 0x00, 0x00, 0x00,
+    0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x47, 0x00, 0x04, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x13, 0x00, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x21, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x16, 0x00, 0x03, 0x00, 0x06, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x17, 0x00, 0x04, 0x00, 0x07, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x15, 0x00, 0x04, 0x00,
+    0x0D, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x2B, 0x00, 0x04, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x04, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x05, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x0F, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x15, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x04, 0x00,
+    0x15, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x03, 0x00, 0x16, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x04, 0x00, 0x17, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x16, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x17, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x19, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x36, 0x00, 0x05, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0xF8, 0x00, 0x02, 0x00, 0x05, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0x3E, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x05, 0x00, 0x19, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x15, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x07, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x00, 0x00,
+    0x1C, 0x00, 0x00, 0x00, 0x91, 0x00, 0x05, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x05, 0x00, 0x08, 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00,
+    0x12, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00,
+    0x1F, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0xFD, 0x00, 0x01, 0x00,
+    0x38, 0x00, 0x01, 0x00,
+};
+
+/**
+ *  #version 450
+ *  layout (push_constant) uniform PushConstants {
+ *      mat4 mvp;
+ *  } u_push;
+ *  layout (location = 0) in vec4 in_pos;
+ *  layout (location = 1) in vec4 in_color;
+ *  layout (location = 0) out vec4 out_color;
+ *  void main() {
+ *     out_color = in_color;
+ *     gl_Position = u_push.mvp * in_pos;
+ *  }
+ */
+const std::vector<uint8_t> c_push_constant_vert_shader = {
+    0x03, 0x02, 0x23, 0x07, 0x00, 0x00, 0x01, 0x00, 0x06, 0x00, 0x08, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x47, 0x4C, 0x53, 0x4C, 0x2E, 0x73, 0x74, 0x64, 0x2E, 0x34, 0x35, 0x30,
+    0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0xC2, 0x01, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x6F, 0x75, 0x74, 0x5F, 0x63, 0x6F, 0x6C, 0x6F,
+    0x72, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x69, 0x6E, 0x5F, 0x63, 0x6F, 0x6C, 0x6F, 0x72, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x06, 0x00, 0x07, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x50,
+    0x65, 0x72, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78, 0x00, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x06, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x67, 0x6C, 0x5F, 0x50, 0x6F, 0x73, 0x69, 0x74, 0x69, 0x6F, 0x6E, 0x00,
+    0x06, 0x00, 0x07, 0x00, 0x07, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x67, 0x6C, 0x5F, 0x50, 0x6F, 0x69, 0x6E, 0x74, 0x53, 0x69, 0x7A, 0x65,
+    0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x07, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x43, 0x6C, 0x69, 0x70, 0x44,
+    0x69, 0x73, 0x74, 0x61, 0x6E, 0x63, 0x65, 0x00, 0x05, 0x00, 0x03, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x06, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x50, 0x75, 0x73, 0x68, 0x43, 0x6F, 0x6E, 0x73,
+    0x74, 0x61, 0x6E, 0x74, 0x73, 0x00, 0x00, 0x00, 0x06, 0x00, 0x04, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6D, 0x76, 0x70, 0x00,
+    0x05, 0x00, 0x04, 0x00, 0x09, 0x00, 0x00, 0x00, 0x75, 0x5F, 0x70, 0x75,
+    0x73, 0x68, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x69, 0x6E, 0x5F, 0x70, 0x6F, 0x73, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x47, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x05, 0x00, 0x07, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x04, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x05, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x13, 0x00, 0x02, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x21, 0x00, 0x03, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x16, 0x00, 0x03, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x17, 0x00, 0x04, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0x0E, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00,
+    0x0E, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x04, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x0D, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x15, 0x00, 0x04, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x2B, 0x00, 0x04, 0x00, 0x10, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x04, 0x00, 0x12, 0x00, 0x00, 0x00,
+    0x0C, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x05, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00,
+    0x12, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x15, 0x00, 0x04, 0x00, 0x14, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x15, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x04, 0x00,
+    0x16, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x03, 0x00, 0x08, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x04, 0x00, 0x17, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x17, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x36, 0x00, 0x05, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0xF8, 0x00, 0x02, 0x00, 0x19, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x0D, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x3E, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x05, 0x00, 0x18, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x16, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x91, 0x00, 0x05, 0x00, 0x0D, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x05, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00,
+    0x1F, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0xFD, 0x00, 0x01, 0x00,
+    0x38, 0x00, 0x01, 0x00,
+};
+
+/**
+ *  #version 450
+ *  layout (std430, binding = 0) readonly buffer Transforms {
+ *      mat4 mvp[];
+ *  } u_transforms;
+ *  layout (location = 0) in vec4 in_pos;
+ *  layout (location = 1) in vec4 in_color;
+ *  layout (location = 0) out vec4 out_color;
+ *  void main() {
+ *     out_color = in_color;
+ *     gl_Position = u_transforms.mvp[gl_InstanceIndex] * in_pos;
+ *  }
+ */
+const std::vector<uint8_t> c_storage_buffer_vert_shader = {
+    0x03, 0x02, 0x23, 0x07, 0x00, 0x00, 0x01, 0x00, 0x06, 0x00, 0x08, 0x00,
+    0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x47, 0x4C, 0x53, 0x4C, 0x2E, 0x73, 0x74, 0x64, 0x2E, 0x34, 0x35, 0x30,
+    0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0xC2, 0x01, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x05, 0x00, 0x03, 0x00, 0x00, 0x00, 0x6F, 0x75, 0x74, 0x5F,
+    0x63, 0x6F, 0x6C, 0x6F, 0x72, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x69, 0x6E, 0x5F, 0x63, 0x6F, 0x6C, 0x6F, 0x72,
+    0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x06, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x67, 0x6C, 0x5F, 0x50, 0x65, 0x72, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78,
+    0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x06, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x50, 0x6F, 0x73, 0x69, 0x74,
+    0x69, 0x6F, 0x6E, 0x00, 0x06, 0x00, 0x07, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x50, 0x6F, 0x69, 0x6E, 0x74,
+    0x53, 0x69, 0x7A, 0x65, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x07, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x43,
+    0x6C, 0x69, 0x70, 0x44, 0x69, 0x73, 0x74, 0x61, 0x6E, 0x63, 0x65, 0x00,
+    0x05, 0x00, 0x03, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x05, 0x00, 0x09, 0x00, 0x00, 0x00, 0x54, 0x72, 0x61, 0x6E,
+    0x73, 0x66, 0x6F, 0x72, 0x6D, 0x73, 0x00, 0x00, 0x06, 0x00, 0x04, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6D, 0x76, 0x70, 0x00,
+    0x05, 0x00, 0x06, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x75, 0x5F, 0x74, 0x72,
+    0x61, 0x6E, 0x73, 0x66, 0x6F, 0x72, 0x6D, 0x73, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x07, 0x00, 0x07, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x49,
+    0x6E, 0x73, 0x74, 0x61, 0x6E, 0x63, 0x65, 0x49, 0x6E, 0x64, 0x65, 0x78,
+    0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x69, 0x6E, 0x5F, 0x70, 0x6F, 0x73, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x47, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x05, 0x00, 0x08, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x04, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x48, 0x00, 0x04, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x47, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x47, 0x00, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x21, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x00, 0x00,
+    0x13, 0x00, 0x02, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x21, 0x00, 0x03, 0x00,
+    0x0D, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x16, 0x00, 0x03, 0x00,
+    0x0E, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x17, 0x00, 0x04, 0x00,
+    0x0F, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x04, 0x00, 0x10, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x0F, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x15, 0x00, 0x04, 0x00, 0x12, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00,
+    0x12, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x1C, 0x00, 0x04, 0x00, 0x14, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x05, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x0F, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x04, 0x00, 0x15, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x15, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x15, 0x00, 0x04, 0x00,
+    0x16, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x2B, 0x00, 0x04, 0x00, 0x16, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x04, 0x00, 0x18, 0x00, 0x00, 0x00,
+    0x0F, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x03, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x03, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x19, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x19, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0x1A, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00,
+    0x1A, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x04, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x36, 0x00, 0x05, 0x00,
+    0x0C, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0D, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x02, 0x00, 0x1C, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x1D, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00, 0x16, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00,
+    0x1B, 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x17, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x91, 0x00, 0x05, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x22, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00,
+    0x23, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0xFD, 0x00, 0x01, 0x00,
+    0x38, 0x00, 0x01, 0x00,
+};
+
+/**
+ *  #version 450
+ *  #extension GL_EXT_nonuniform_qualifier : require
+ *  layout (push_constant) uniform PushConstants {
+ *      uint transforms;
+ *  } u_push;
+ *  layout (std430, binding = 0) readonly buffer Transforms {
+ *      mat4 mvp[];
+ *  } u_buffers[];
+ *  layout (location = 0) in vec4 in_pos;
+ *  layout (location = 1) in vec4 in_color;
+ *  layout (location = 0) out vec4 out_color;
+ *  void main() {
+ *     out_color = in_color;
+ *     mat4 mvp = u_buffers[u_push.transforms].mvp[gl_InstanceIndex];
+ *     gl_Position = mvp * in_pos;
+ *  }
+ */
+const std::vector<uint8_t> c_bindless_vert_shader = {
+    0x03, 0x02, 0x23, 0x07, 0x00, 0x00, 0x01, 0x00, 0x06, 0x00, 0x08, 0x00,
+    0x2B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x11, 0x00, 0x02, 0x00, 0xB6, 0x14, 0x00, 0x00,
+    0x0A, 0x00, 0x08, 0x00, 0x53, 0x50, 0x56, 0x5F, 0x45, 0x58, 0x54, 0x5F,
+    0x64, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x6F, 0x72, 0x5F, 0x69,
+    0x6E, 0x64, 0x65, 0x78, 0x69, 0x6E, 0x67, 0x00, 0x0B, 0x00, 0x06, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x47, 0x4C, 0x53, 0x4C, 0x2E, 0x73, 0x74, 0x64,
+    0x2E, 0x34, 0x35, 0x30, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x03, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x0A, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E,
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x00, 0xC2, 0x01, 0x00, 0x00,
+    0x04, 0x00, 0x08, 0x00, 0x47, 0x4C, 0x5F, 0x45, 0x58, 0x54, 0x5F, 0x6E,
+    0x6F, 0x6E, 0x75, 0x6E, 0x69, 0x66, 0x6F, 0x72, 0x6D, 0x5F, 0x71, 0x75,
+    0x61, 0x6C, 0x69, 0x66, 0x69, 0x65, 0x72, 0x00, 0x05, 0x00, 0x04, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x05, 0x00, 0x03, 0x00, 0x00, 0x00, 0x6F, 0x75, 0x74, 0x5F,
+    0x63, 0x6F, 0x6C, 0x6F, 0x72, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x69, 0x6E, 0x5F, 0x63, 0x6F, 0x6C, 0x6F, 0x72,
+    0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x06, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x67, 0x6C, 0x5F, 0x50, 0x65, 0x72, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78,
+    0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x06, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x50, 0x6F, 0x73, 0x69, 0x74,
+    0x69, 0x6F, 0x6E, 0x00, 0x06, 0x00, 0x07, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x50, 0x6F, 0x69, 0x6E, 0x74,
+    0x53, 0x69, 0x7A, 0x65, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x07, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x43,
+    0x6C, 0x69, 0x70, 0x44, 0x69, 0x73, 0x74, 0x61, 0x6E, 0x63, 0x65, 0x00,
+    0x05, 0x00, 0x03, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x05, 0x00, 0x09, 0x00, 0x00, 0x00, 0x54, 0x72, 0x61, 0x6E,
+    0x73, 0x66, 0x6F, 0x72, 0x6D, 0x73, 0x00, 0x00, 0x06, 0x00, 0x04, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6D, 0x76, 0x70, 0x00,
+    0x05, 0x00, 0x05, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x75, 0x5F, 0x62, 0x75,
+    0x66, 0x66, 0x65, 0x72, 0x73, 0x00, 0x00, 0x00, 0x05, 0x00, 0x06, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x50, 0x75, 0x73, 0x68, 0x43, 0x6F, 0x6E, 0x73,
+    0x74, 0x61, 0x6E, 0x74, 0x73, 0x00, 0x00, 0x00, 0x06, 0x00, 0x06, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x74, 0x72, 0x61, 0x6E,
+    0x73, 0x66, 0x6F, 0x72, 0x6D, 0x73, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00,
+    0x0C, 0x00, 0x00, 0x00, 0x75, 0x5F, 0x70, 0x75, 0x73, 0x68, 0x00, 0x00,
+    0x05, 0x00, 0x07, 0x00, 0x06, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x49,
+    0x6E, 0x73, 0x74, 0x61, 0x6E, 0x63, 0x65, 0x49, 0x6E, 0x64, 0x65, 0x78,
+    0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x69, 0x6E, 0x5F, 0x70, 0x6F, 0x73, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x47, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x05, 0x00, 0x08, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x0D, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x04, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x48, 0x00, 0x04, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x47, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x47, 0x00, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x21, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x00, 0x00, 0x13, 0x00, 0x02, 0x00,
+    0x0E, 0x00, 0x00, 0x00, 0x21, 0x00, 0x03, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x0E, 0x00, 0x00, 0x00, 0x16, 0x00, 0x03, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x17, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x12, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x12, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x15, 0x00, 0x04, 0x00, 0x14, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x15, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x04, 0x00,
+    0x16, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x05, 0x00, 0x08, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x17, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x17, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x15, 0x00, 0x04, 0x00, 0x18, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x04, 0x00, 0x1A, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x03, 0x00, 0x0D, 0x00, 0x00, 0x00,
+    0x1A, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x0D, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x03, 0x00, 0x1B, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0x1C, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00,
+    0x1C, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x03, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x04, 0x00, 0x1D, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x1D, 0x00, 0x00, 0x00,
+    0x0C, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x04, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x1F, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x36, 0x00, 0x05, 0x00, 0x0E, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0xF8, 0x00, 0x02, 0x00, 0x21, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x3E, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x05, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00,
+    0x0C, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x18, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x41, 0x00, 0x07, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x26, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00,
+    0x19, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x1A, 0x00, 0x00, 0x00, 0x27, 0x00, 0x00, 0x00, 0x26, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x91, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x29, 0x00, 0x00, 0x00, 0x27, 0x00, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x05, 0x00, 0x12, 0x00, 0x00, 0x00, 0x2A, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00,
+    0x2A, 0x00, 0x00, 0x00, 0x29, 0x00, 0x00, 0x00, 0xFD, 0x00, 0x01, 0x00,
+    0x38, 0x00, 0x01, 0x00,
+};
+
+/**
+ *  #version 450
+ *  layout (push_constant) uniform PushConstants {
+ *      mat4 view_projection;
+ *  } u_push;
+ *  layout (location = 0) in vec4 in_pos;
+ *  layout (location = 1) in vec4 in_color;
+ *  layout (location = 2) in mat4 in_model;
+ *  layout (location = 6) in vec4 in_instance_color;
+ *  layout (location = 0) out vec4 out_color;
+ *  void main() {
+ *     out_color = in_color * in_instance_color;
+ *     gl_Position = u_push.view_projection * (in_model * in_pos);
+ *  }
+ */
+const std::vector<uint8_t> c_instanced_vert_shader = {
+    0x03, 0x02, 0x23, 0x07, 0x00, 0x00, 0x01, 0x00, 0x06, 0x00, 0x08, 0x00,
+    0x27, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x47, 0x4C, 0x53, 0x4C, 0x2E, 0x73, 0x74, 0x64, 0x2E, 0x34, 0x35, 0x30,
+    0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x00, 0xC2, 0x01, 0x00, 0x00,
+    0x05, 0x00, 0x04, 0x00, 0x02, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E,
+    0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x6F, 0x75, 0x74, 0x5F, 0x63, 0x6F, 0x6C, 0x6F, 0x72, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x05, 0x00, 0x04, 0x00, 0x00, 0x00, 0x69, 0x6E, 0x5F, 0x63,
+    0x6F, 0x6C, 0x6F, 0x72, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x06, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x50, 0x65, 0x72, 0x56, 0x65,
+    0x72, 0x74, 0x65, 0x78, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x06, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x50,
+    0x6F, 0x73, 0x69, 0x74, 0x69, 0x6F, 0x6E, 0x00, 0x06, 0x00, 0x07, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x50,
+    0x6F, 0x69, 0x6E, 0x74, 0x53, 0x69, 0x7A, 0x65, 0x00, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x07, 0x00, 0x09, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x67, 0x6C, 0x5F, 0x43, 0x6C, 0x69, 0x70, 0x44, 0x69, 0x73, 0x74, 0x61,
+    0x6E, 0x63, 0x65, 0x00, 0x05, 0x00, 0x03, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x06, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x50, 0x75, 0x73, 0x68, 0x43, 0x6F, 0x6E, 0x73, 0x74, 0x61, 0x6E, 0x74,
+    0x73, 0x00, 0x00, 0x00, 0x06, 0x00, 0x07, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x76, 0x69, 0x65, 0x77, 0x5F, 0x70, 0x72, 0x6F,
+    0x6A, 0x65, 0x63, 0x74, 0x69, 0x6F, 0x6E, 0x00, 0x05, 0x00, 0x04, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x75, 0x5F, 0x70, 0x75, 0x73, 0x68, 0x00, 0x00,
+    0x05, 0x00, 0x05, 0x00, 0x07, 0x00, 0x00, 0x00, 0x69, 0x6E, 0x5F, 0x6D,
+    0x6F, 0x64, 0x65, 0x6C, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x07, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x69, 0x6E, 0x5F, 0x69, 0x6E, 0x73, 0x74, 0x61,
+    0x6E, 0x63, 0x65, 0x5F, 0x63, 0x6F, 0x6C, 0x6F, 0x72, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x04, 0x00, 0x06, 0x00, 0x00, 0x00, 0x69, 0x6E, 0x5F, 0x70,
+    0x6F, 0x73, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x05, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x47, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x47, 0x00, 0x04, 0x00, 0x06, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x05, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00,
+    0x0A, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x13, 0x00, 0x02, 0x00,
+    0x0C, 0x00, 0x00, 0x00, 0x21, 0x00, 0x03, 0x00, 0x0D, 0x00, 0x00, 0x00,
+    0x0C, 0x00, 0x00, 0x00, 0x16, 0x00, 0x03, 0x00, 0x0E, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x17, 0x00, 0x04, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x0E, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x10, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x15, 0x00, 0x04, 0x00, 0x12, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00, 0x12, 0x00, 0x00, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x04, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x05, 0x00, 0x09, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x0E, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x15, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x15, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x15, 0x00, 0x04, 0x00, 0x16, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00,
+    0x16, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x04, 0x00, 0x18, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x03, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0x19, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00,
+    0x19, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x04, 0x00, 0x1A, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x1B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x36, 0x00, 0x05, 0x00,
+    0x0C, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0D, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x02, 0x00, 0x1C, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x85, 0x00, 0x05, 0x00,
+    0x0F, 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x1F, 0x00, 0x00, 0x00, 0x41, 0x00, 0x05, 0x00, 0x1A, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x18, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00, 0x18, 0x00, 0x00, 0x00,
+    0x22, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x0F, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x91, 0x00, 0x05, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00,
+    0x22, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00, 0x91, 0x00, 0x05, 0x00,
+    0x0F, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00,
+    0x24, 0x00, 0x00, 0x00, 0x41, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x26, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00,
+    0x3E, 0x00, 0x03, 0x00, 0x26, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00,
+    0xFD, 0x00, 0x01, 0x00, 0x38, 0x00, 0x01, 0x00,
+};
+
+/**
+ *  #version 450
+ *  layout (local_size_x = 64) in;
+ *  layout (push_constant) uniform PushConstants {
+ *      vec4 planes[6];
+ *      uint instance_count;
+ *  } u_push;
+ *  layout (std430, binding = 0) readonly buffer Instances {
+ *      uint words[];
+ *  } u_instances;
+ *  layout (std430, binding = 1) writeonly buffer VisibleInstances {
+ *      uint words[];
+ *  } u_visible;
+ *  layout (std430, binding = 2) buffer DrawCommand {
+ *      uint index_count;
+ *      uint instance_count;
+ *      uint first_index;
+ *      int vertex_offset;
+ *      uint first_instance;
+ *  } u_draw;
+ *  // InstanceData: a column major mat4 model and a packed color.
+ *  const uint c_instance_words = 17;
+ *  void main() {
+ *     uint id = gl_GlobalInvocationID.x;
+ *     if (id < u_push.instance_count) {
+ *        uint base = id * c_instance_words;
+ *        uint words[c_instance_words];
+ *        for (uint i = 0; i < c_instance_words; ++i)
+ *           words[i] = u_instances.words[base + i];
+ *        // The model space bounding box is [-1, 1]^3.
+ *        vec3 center = uintBitsToFloat(uvec3(words[12], words[13], words[14]));
+ *        vec3 extent =
+ *           abs(uintBitsToFloat(uvec3(words[0], words[1], words[2]))) +
+ *           abs(uintBitsToFloat(uvec3(words[4], words[5], words[6]))) +
+ *           abs(uintBitsToFloat(uvec3(words[8], words[9], words[10])));
+ *        bool visible = true;
+ *        for (int i = 0; i < 6; ++i) {
+ *           vec4 plane = u_push.planes[i];
+ *           visible = visible && dot(plane.xyz, center) + plane.w >=
+ *                                -dot(abs(plane.xyz), extent);
+ *        }
+ *        if (visible) {
+ *           uint slot = atomicAdd(u_draw.instance_count, 1);
+ *           for (uint i = 0; i < c_instance_words; ++i)
+ *              u_visible.words[slot * c_instance_words + i] = words[i];
+ *        }
+ *     }
+ *  }
+ */
+const std::vector<uint8_t> c_cull_comp_shader = {
+    0x03, 0x02, 0x23, 0x07, 0x00, 0x00, 0x01, 0x00, 0x06, 0x00, 0x08, 0x00,
+    0xEE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x47, 0x4C, 0x53, 0x4C, 0x2E, 0x73, 0x74, 0x64, 0x2E, 0x34, 0x35, 0x30,
+    0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x06, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x10, 0x00, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0xC2, 0x01, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x08, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x47, 0x6C, 0x6F, 0x62, 0x61,
+    0x6C, 0x49, 0x6E, 0x76, 0x6F, 0x63, 0x61, 0x74, 0x69, 0x6F, 0x6E, 0x49,
+    0x44, 0x00, 0x00, 0x00, 0x05, 0x00, 0x06, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x50, 0x75, 0x73, 0x68, 0x43, 0x6F, 0x6E, 0x73, 0x74, 0x61, 0x6E, 0x74,
+    0x73, 0x00, 0x00, 0x00, 0x06, 0x00, 0x05, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x70, 0x6C, 0x61, 0x6E, 0x65, 0x73, 0x00, 0x00,
+    0x06, 0x00, 0x07, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x69, 0x6E, 0x73, 0x74, 0x61, 0x6E, 0x63, 0x65, 0x5F, 0x63, 0x6F, 0x75,
+    0x6E, 0x74, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x75, 0x5F, 0x70, 0x75, 0x73, 0x68, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x49, 0x6E, 0x73, 0x74, 0x61, 0x6E, 0x63, 0x65,
+    0x73, 0x00, 0x00, 0x00, 0x06, 0x00, 0x05, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x77, 0x6F, 0x72, 0x64, 0x73, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x05, 0x00, 0x07, 0x00, 0x00, 0x00, 0x75, 0x5F, 0x69, 0x6E,
+    0x73, 0x74, 0x61, 0x6E, 0x63, 0x65, 0x73, 0x00, 0x05, 0x00, 0x07, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x56, 0x69, 0x73, 0x69, 0x62, 0x6C, 0x65, 0x49,
+    0x6E, 0x73, 0x74, 0x61, 0x6E, 0x63, 0x65, 0x73, 0x00, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x05, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x77, 0x6F, 0x72, 0x64, 0x73, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x75, 0x5F, 0x76, 0x69, 0x73, 0x69, 0x62, 0x6C,
+    0x65, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x44, 0x72, 0x61, 0x77, 0x43, 0x6F, 0x6D, 0x6D, 0x61, 0x6E, 0x64, 0x00,
+    0x06, 0x00, 0x06, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x69, 0x6E, 0x64, 0x65, 0x78, 0x5F, 0x63, 0x6F, 0x75, 0x6E, 0x74, 0x00,
+    0x06, 0x00, 0x07, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x69, 0x6E, 0x73, 0x74, 0x61, 0x6E, 0x63, 0x65, 0x5F, 0x63, 0x6F, 0x75,
+    0x6E, 0x74, 0x00, 0x00, 0x06, 0x00, 0x06, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x66, 0x69, 0x72, 0x73, 0x74, 0x5F, 0x69, 0x6E,
+    0x64, 0x65, 0x78, 0x00, 0x06, 0x00, 0x07, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x5F, 0x6F,
+    0x66, 0x66, 0x73, 0x65, 0x74, 0x00, 0x00, 0x00, 0x06, 0x00, 0x07, 0x00,
+    0x0A, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x66, 0x69, 0x72, 0x73,
+    0x74, 0x5F, 0x69, 0x6E, 0x73, 0x74, 0x61, 0x6E, 0x63, 0x65, 0x00, 0x00,
+    0x05, 0x00, 0x04, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x75, 0x5F, 0x64, 0x72,
+    0x61, 0x77, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x0C, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x05, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00,
+    0x60, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x0D, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x48, 0x00, 0x04, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x05, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x47, 0x00, 0x04, 0x00, 0x07, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x05, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x0A, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x05, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x23, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
+    0x0A, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x13, 0x00, 0x02, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x21, 0x00, 0x03, 0x00,
+    0x0F, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x14, 0x00, 0x02, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x15, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x15, 0x00, 0x04, 0x00,
+    0x12, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x16, 0x00, 0x03, 0x00, 0x13, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x17, 0x00, 0x04, 0x00, 0x14, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x17, 0x00, 0x04, 0x00, 0x15, 0x00, 0x00, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x17, 0x00, 0x04, 0x00,
+    0x16, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x2B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+    0x2B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00, 0x12, 0x00, 0x00, 0x00,
+    0x1B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00,
+    0x12, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x2B, 0x00, 0x04, 0x00, 0x12, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00, 0x12, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00,
+    0x12, 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x2B, 0x00, 0x04, 0x00, 0x12, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x21, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x2B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x24, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x2B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x26, 0x00, 0x00, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x27, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x2B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x29, 0x00, 0x00, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x2A, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00,
+    0x2B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x2C, 0x00, 0x00, 0x00,
+    0x0E, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x2D, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0x2E, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x1C, 0x00, 0x04, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00,
+    0x19, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x0C, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x2F, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x2F, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0x30, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x31, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x1D, 0x00, 0x03, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x03, 0x00, 0x06, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x04, 0x00, 0x32, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x32, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x03, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x33, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x33, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x07, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x12, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x34, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x34, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0x35, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x36, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x36, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x36, 0x00, 0x05, 0x00, 0x0E, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0xF8, 0x00, 0x02, 0x00, 0x37, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x16, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x51, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00,
+    0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x00, 0x05, 0x00,
+    0x31, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x1C, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x00, 0x00, 0x3A, 0x00, 0x00, 0x00, 0xB0, 0x00, 0x05, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x00, 0x00, 0xF7, 0x00, 0x03, 0x00, 0x3D, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFA, 0x00, 0x04, 0x00, 0x3C, 0x00, 0x00, 0x00,
+    0x3E, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x02, 0x00,
+    0x3E, 0x00, 0x00, 0x00, 0x84, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x3F, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x41, 0x00, 0x00, 0x00,
+    0x40, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x42, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x43, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00,
+    0x43, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x45, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x46, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x45, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x47, 0x00, 0x00, 0x00,
+    0x46, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x48, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x49, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x48, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x4A, 0x00, 0x00, 0x00,
+    0x49, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x4B, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x4C, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x4B, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x4D, 0x00, 0x00, 0x00,
+    0x4C, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x4E, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x4F, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x4E, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00,
+    0x4F, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x51, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x52, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x51, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x53, 0x00, 0x00, 0x00,
+    0x52, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x54, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x55, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x54, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x56, 0x00, 0x00, 0x00,
+    0x55, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x57, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x26, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x58, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x57, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x59, 0x00, 0x00, 0x00,
+    0x58, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x5A, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x27, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x5B, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x5A, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x5C, 0x00, 0x00, 0x00,
+    0x5B, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x5D, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x5E, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x5D, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x5F, 0x00, 0x00, 0x00,
+    0x5E, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x60, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x29, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x61, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x60, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x62, 0x00, 0x00, 0x00,
+    0x61, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x63, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x2A, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x63, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x65, 0x00, 0x00, 0x00,
+    0x64, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x66, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x67, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x66, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x68, 0x00, 0x00, 0x00,
+    0x67, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x69, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x2C, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x6A, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x69, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x6B, 0x00, 0x00, 0x00,
+    0x6A, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x6C, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x2D, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x6D, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x6C, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x6E, 0x00, 0x00, 0x00,
+    0x6D, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0x6F, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x2E, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x6F, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00, 0x71, 0x00, 0x00, 0x00,
+    0x70, 0x00, 0x00, 0x00, 0x7C, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0x72, 0x00, 0x00, 0x00, 0x41, 0x00, 0x00, 0x00, 0x7C, 0x00, 0x04, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x73, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00,
+    0x7C, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00, 0x74, 0x00, 0x00, 0x00,
+    0x47, 0x00, 0x00, 0x00, 0x50, 0x00, 0x06, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x75, 0x00, 0x00, 0x00, 0x72, 0x00, 0x00, 0x00, 0x73, 0x00, 0x00, 0x00,
+    0x74, 0x00, 0x00, 0x00, 0x7C, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0x76, 0x00, 0x00, 0x00, 0x4D, 0x00, 0x00, 0x00, 0x7C, 0x00, 0x04, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x77, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00,
+    0x7C, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00,
+    0x53, 0x00, 0x00, 0x00, 0x50, 0x00, 0x06, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x79, 0x00, 0x00, 0x00, 0x76, 0x00, 0x00, 0x00, 0x77, 0x00, 0x00, 0x00,
+    0x78, 0x00, 0x00, 0x00, 0x7C, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0x7A, 0x00, 0x00, 0x00, 0x59, 0x00, 0x00, 0x00, 0x7C, 0x00, 0x04, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x7B, 0x00, 0x00, 0x00, 0x5C, 0x00, 0x00, 0x00,
+    0x7C, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00, 0x7C, 0x00, 0x00, 0x00,
+    0x5F, 0x00, 0x00, 0x00, 0x50, 0x00, 0x06, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x7D, 0x00, 0x00, 0x00, 0x7A, 0x00, 0x00, 0x00, 0x7B, 0x00, 0x00, 0x00,
+    0x7C, 0x00, 0x00, 0x00, 0x7C, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0x7E, 0x00, 0x00, 0x00, 0x65, 0x00, 0x00, 0x00, 0x7C, 0x00, 0x04, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x68, 0x00, 0x00, 0x00,
+    0x7C, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00,
+    0x6B, 0x00, 0x00, 0x00, 0x50, 0x00, 0x06, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x81, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x00, 0x7F, 0x00, 0x00, 0x00,
+    0x80, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x82, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x75, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x83, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x79, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x84, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x7D, 0x00, 0x00, 0x00, 0x81, 0x00, 0x05, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x85, 0x00, 0x00, 0x00, 0x82, 0x00, 0x00, 0x00, 0x83, 0x00, 0x00, 0x00,
+    0x81, 0x00, 0x05, 0x00, 0x14, 0x00, 0x00, 0x00, 0x86, 0x00, 0x00, 0x00,
+    0x85, 0x00, 0x00, 0x00, 0x84, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00,
+    0x30, 0x00, 0x00, 0x00, 0x87, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x1B, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x15, 0x00, 0x00, 0x00, 0x88, 0x00, 0x00, 0x00, 0x87, 0x00, 0x00, 0x00,
+    0x4F, 0x00, 0x08, 0x00, 0x14, 0x00, 0x00, 0x00, 0x89, 0x00, 0x00, 0x00,
+    0x88, 0x00, 0x00, 0x00, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x51, 0x00, 0x05, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x8A, 0x00, 0x00, 0x00, 0x88, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x94, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0x8B, 0x00, 0x00, 0x00, 0x89, 0x00, 0x00, 0x00, 0x81, 0x00, 0x00, 0x00,
+    0x81, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00, 0x8C, 0x00, 0x00, 0x00,
+    0x8B, 0x00, 0x00, 0x00, 0x8A, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x06, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0x8D, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x89, 0x00, 0x00, 0x00, 0x94, 0x00, 0x05, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x8E, 0x00, 0x00, 0x00, 0x8D, 0x00, 0x00, 0x00,
+    0x86, 0x00, 0x00, 0x00, 0x7F, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0x8F, 0x00, 0x00, 0x00, 0x8E, 0x00, 0x00, 0x00, 0xBE, 0x00, 0x05, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x90, 0x00, 0x00, 0x00, 0x8C, 0x00, 0x00, 0x00,
+    0x8F, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00, 0x30, 0x00, 0x00, 0x00,
+    0x91, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00,
+    0x1C, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00, 0x15, 0x00, 0x00, 0x00,
+    0x92, 0x00, 0x00, 0x00, 0x91, 0x00, 0x00, 0x00, 0x4F, 0x00, 0x08, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0x93, 0x00, 0x00, 0x00, 0x92, 0x00, 0x00, 0x00,
+    0x92, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x51, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0x94, 0x00, 0x00, 0x00, 0x92, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x94, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00, 0x95, 0x00, 0x00, 0x00,
+    0x93, 0x00, 0x00, 0x00, 0x81, 0x00, 0x00, 0x00, 0x81, 0x00, 0x05, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x96, 0x00, 0x00, 0x00, 0x95, 0x00, 0x00, 0x00,
+    0x94, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x97, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x93, 0x00, 0x00, 0x00, 0x94, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0x98, 0x00, 0x00, 0x00, 0x97, 0x00, 0x00, 0x00, 0x86, 0x00, 0x00, 0x00,
+    0x7F, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00, 0x99, 0x00, 0x00, 0x00,
+    0x98, 0x00, 0x00, 0x00, 0xBE, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x9A, 0x00, 0x00, 0x00, 0x96, 0x00, 0x00, 0x00, 0x99, 0x00, 0x00, 0x00,
+    0xA7, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00, 0x9B, 0x00, 0x00, 0x00,
+    0x90, 0x00, 0x00, 0x00, 0x9A, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00,
+    0x30, 0x00, 0x00, 0x00, 0x9C, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x1B, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x15, 0x00, 0x00, 0x00, 0x9D, 0x00, 0x00, 0x00, 0x9C, 0x00, 0x00, 0x00,
+    0x4F, 0x00, 0x08, 0x00, 0x14, 0x00, 0x00, 0x00, 0x9E, 0x00, 0x00, 0x00,
+    0x9D, 0x00, 0x00, 0x00, 0x9D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x51, 0x00, 0x05, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x9F, 0x00, 0x00, 0x00, 0x9D, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x94, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0xA0, 0x00, 0x00, 0x00, 0x9E, 0x00, 0x00, 0x00, 0x81, 0x00, 0x00, 0x00,
+    0x81, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00, 0xA1, 0x00, 0x00, 0x00,
+    0xA0, 0x00, 0x00, 0x00, 0x9F, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x06, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0xA2, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x9E, 0x00, 0x00, 0x00, 0x94, 0x00, 0x05, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0xA3, 0x00, 0x00, 0x00, 0xA2, 0x00, 0x00, 0x00,
+    0x86, 0x00, 0x00, 0x00, 0x7F, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0xA4, 0x00, 0x00, 0x00, 0xA3, 0x00, 0x00, 0x00, 0xBE, 0x00, 0x05, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0xA5, 0x00, 0x00, 0x00, 0xA1, 0x00, 0x00, 0x00,
+    0xA4, 0x00, 0x00, 0x00, 0xA7, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0xA6, 0x00, 0x00, 0x00, 0x9B, 0x00, 0x00, 0x00, 0xA5, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x30, 0x00, 0x00, 0x00, 0xA7, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00,
+    0x3D, 0x00, 0x04, 0x00, 0x15, 0x00, 0x00, 0x00, 0xA8, 0x00, 0x00, 0x00,
+    0xA7, 0x00, 0x00, 0x00, 0x4F, 0x00, 0x08, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0xA9, 0x00, 0x00, 0x00, 0xA8, 0x00, 0x00, 0x00, 0xA8, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x51, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00, 0xAA, 0x00, 0x00, 0x00,
+    0xA8, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x94, 0x00, 0x05, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0xAB, 0x00, 0x00, 0x00, 0xA9, 0x00, 0x00, 0x00,
+    0x81, 0x00, 0x00, 0x00, 0x81, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0xAC, 0x00, 0x00, 0x00, 0xAB, 0x00, 0x00, 0x00, 0xAA, 0x00, 0x00, 0x00,
+    0x0C, 0x00, 0x06, 0x00, 0x14, 0x00, 0x00, 0x00, 0xAD, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0xA9, 0x00, 0x00, 0x00,
+    0x94, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00, 0xAE, 0x00, 0x00, 0x00,
+    0xAD, 0x00, 0x00, 0x00, 0x86, 0x00, 0x00, 0x00, 0x7F, 0x00, 0x04, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0xAF, 0x00, 0x00, 0x00, 0xAE, 0x00, 0x00, 0x00,
+    0xBE, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00, 0xB0, 0x00, 0x00, 0x00,
+    0xAC, 0x00, 0x00, 0x00, 0xAF, 0x00, 0x00, 0x00, 0xA7, 0x00, 0x05, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0xB1, 0x00, 0x00, 0x00, 0xA6, 0x00, 0x00, 0x00,
+    0xB0, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00, 0x30, 0x00, 0x00, 0x00,
+    0xB2, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00,
+    0x1F, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00, 0x15, 0x00, 0x00, 0x00,
+    0xB3, 0x00, 0x00, 0x00, 0xB2, 0x00, 0x00, 0x00, 0x4F, 0x00, 0x08, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0xB4, 0x00, 0x00, 0x00, 0xB3, 0x00, 0x00, 0x00,
+    0xB3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x51, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0xB5, 0x00, 0x00, 0x00, 0xB3, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x94, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00, 0xB6, 0x00, 0x00, 0x00,
+    0xB4, 0x00, 0x00, 0x00, 0x81, 0x00, 0x00, 0x00, 0x81, 0x00, 0x05, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0xB7, 0x00, 0x00, 0x00, 0xB6, 0x00, 0x00, 0x00,
+    0xB5, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0xB8, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0xB4, 0x00, 0x00, 0x00, 0x94, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0xB9, 0x00, 0x00, 0x00, 0xB8, 0x00, 0x00, 0x00, 0x86, 0x00, 0x00, 0x00,
+    0x7F, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00, 0xBA, 0x00, 0x00, 0x00,
+    0xB9, 0x00, 0x00, 0x00, 0xBE, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0xBB, 0x00, 0x00, 0x00, 0xB7, 0x00, 0x00, 0x00, 0xBA, 0x00, 0x00, 0x00,
+    0xA7, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00, 0xBC, 0x00, 0x00, 0x00,
+    0xB1, 0x00, 0x00, 0x00, 0xBB, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00,
+    0x30, 0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+    0x1B, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x15, 0x00, 0x00, 0x00, 0xBE, 0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 0x00,
+    0x4F, 0x00, 0x08, 0x00, 0x14, 0x00, 0x00, 0x00, 0xBF, 0x00, 0x00, 0x00,
+    0xBE, 0x00, 0x00, 0x00, 0xBE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x51, 0x00, 0x05, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x00, 0xBE, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x94, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0xC1, 0x00, 0x00, 0x00, 0xBF, 0x00, 0x00, 0x00, 0x81, 0x00, 0x00, 0x00,
+    0x81, 0x00, 0x05, 0x00, 0x13, 0x00, 0x00, 0x00, 0xC2, 0x00, 0x00, 0x00,
+    0xC1, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x06, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0xC3, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0xBF, 0x00, 0x00, 0x00, 0x94, 0x00, 0x05, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0xC4, 0x00, 0x00, 0x00, 0xC3, 0x00, 0x00, 0x00,
+    0x86, 0x00, 0x00, 0x00, 0x7F, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00,
+    0xC5, 0x00, 0x00, 0x00, 0xC4, 0x00, 0x00, 0x00, 0xBE, 0x00, 0x05, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0xC6, 0x00, 0x00, 0x00, 0xC2, 0x00, 0x00, 0x00,
+    0xC5, 0x00, 0x00, 0x00, 0xA7, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0xC7, 0x00, 0x00, 0x00, 0xBC, 0x00, 0x00, 0x00, 0xC6, 0x00, 0x00, 0x00,
+    0xF7, 0x00, 0x03, 0x00, 0xC8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFA, 0x00, 0x04, 0x00, 0xC7, 0x00, 0x00, 0x00, 0xC9, 0x00, 0x00, 0x00,
+    0xC8, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x02, 0x00, 0xC9, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x05, 0x00, 0x35, 0x00, 0x00, 0x00, 0xCA, 0x00, 0x00, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0xEA, 0x00, 0x07, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0xCB, 0x00, 0x00, 0x00, 0xCA, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00,
+    0x84, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00,
+    0xCB, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00,
+    0x35, 0x00, 0x00, 0x00, 0xCD, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x1B, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00,
+    0xCD, 0x00, 0x00, 0x00, 0x41, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0xCE, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00,
+    0xCF, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00,
+    0xCE, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00, 0xCF, 0x00, 0x00, 0x00,
+    0x44, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0xD0, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0xD1, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0xD0, 0x00, 0x00, 0x00,
+    0x3E, 0x00, 0x03, 0x00, 0xD1, 0x00, 0x00, 0x00, 0x47, 0x00, 0x00, 0x00,
+    0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00, 0xD2, 0x00, 0x00, 0x00,
+    0xCC, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00,
+    0x35, 0x00, 0x00, 0x00, 0xD3, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x1B, 0x00, 0x00, 0x00, 0xD2, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00,
+    0xD3, 0x00, 0x00, 0x00, 0x4A, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0xD4, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00,
+    0x23, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00,
+    0xD5, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00,
+    0xD4, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00, 0xD5, 0x00, 0x00, 0x00,
+    0x4D, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0xD6, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0xD7, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0xD6, 0x00, 0x00, 0x00,
+    0x3E, 0x00, 0x03, 0x00, 0xD7, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00,
+    0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00, 0xD8, 0x00, 0x00, 0x00,
+    0xCC, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00,
+    0x35, 0x00, 0x00, 0x00, 0xD9, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x1B, 0x00, 0x00, 0x00, 0xD8, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00,
+    0xD9, 0x00, 0x00, 0x00, 0x53, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0xDA, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00,
+    0x25, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00,
+    0xDB, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00,
+    0xDA, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00, 0xDB, 0x00, 0x00, 0x00,
+    0x56, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0xDC, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x26, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0xDD, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0xDC, 0x00, 0x00, 0x00,
+    0x3E, 0x00, 0x03, 0x00, 0xDD, 0x00, 0x00, 0x00, 0x59, 0x00, 0x00, 0x00,
+    0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00, 0xDE, 0x00, 0x00, 0x00,
+    0xCC, 0x00, 0x00, 0x00, 0x27, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00,
+    0x35, 0x00, 0x00, 0x00, 0xDF, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x1B, 0x00, 0x00, 0x00, 0xDE, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00,
+    0xDF, 0x00, 0x00, 0x00, 0x5C, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00,
+    0x28, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00,
+    0xE1, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00,
+    0xE0, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00, 0xE1, 0x00, 0x00, 0x00,
+    0x5F, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0xE2, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x29, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0xE3, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0xE2, 0x00, 0x00, 0x00,
+    0x3E, 0x00, 0x03, 0x00, 0xE3, 0x00, 0x00, 0x00, 0x62, 0x00, 0x00, 0x00,
+    0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00, 0xE4, 0x00, 0x00, 0x00,
+    0xCC, 0x00, 0x00, 0x00, 0x2A, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00,
+    0x35, 0x00, 0x00, 0x00, 0xE5, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x1B, 0x00, 0x00, 0x00, 0xE4, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00,
+    0xE5, 0x00, 0x00, 0x00, 0x65, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0xE6, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00,
+    0x2B, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00,
+    0xE7, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00,
+    0xE6, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00, 0xE7, 0x00, 0x00, 0x00,
+    0x68, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00,
+    0xE8, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x2C, 0x00, 0x00, 0x00,
+    0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00, 0xE9, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0xE8, 0x00, 0x00, 0x00,
+    0x3E, 0x00, 0x03, 0x00, 0xE9, 0x00, 0x00, 0x00, 0x6B, 0x00, 0x00, 0x00,
+    0x80, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00, 0xEA, 0x00, 0x00, 0x00,
+    0xCC, 0x00, 0x00, 0x00, 0x2D, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00,
+    0x35, 0x00, 0x00, 0x00, 0xEB, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x1B, 0x00, 0x00, 0x00, 0xEA, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00,
+    0xEB, 0x00, 0x00, 0x00, 0x6E, 0x00, 0x00, 0x00, 0x80, 0x00, 0x05, 0x00,
+    0x11, 0x00, 0x00, 0x00, 0xEC, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00,
+    0x2E, 0x00, 0x00, 0x00, 0x41, 0x00, 0x06, 0x00, 0x35, 0x00, 0x00, 0x00,
+    0xED, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00,
+    0xEC, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00, 0xED, 0x00, 0x00, 0x00,
+    0x71, 0x00, 0x00, 0x00, 0xF9, 0x00, 0x02, 0x00, 0xC8, 0x00, 0x00, 0x00,
+    0xF8, 0x00, 0x02, 0x00, 0xC8, 0x00, 0x00, 0x00, 0xF9, 0x00, 0x02, 0x00,
+    0x3D, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x02, 0x00, 0x3D, 0x00, 0x00, 0x00,
+    0xFD, 0x00, 0x01, 0x00, 0x38, 0x00, 0x01, 0x00,
+};
+
+/**
+ *  #version 400
+ *  #extension GL_ARB_separate_shader_objects : enable
+ *  #extension GL_ARB_shading_language_420pack : enable
+ *  layout (location = 0) in vec4 in_color;
+ *  layout (location = 0) out vec4 out_color;
+ *  void main() {
+ *     out_color = in_color;
+ *  }
+ */
+const std::vector<uint8_t> c_frag_shader = {
+    0x03, 0x02, 0x23, 0x07, 0x00, 0x00, 0x01, 0x00, 0x06, 0x00, 0x08, 0x00,
+    0x0D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x02, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x47, 0x4C, 0x53, 0x4C, 0x2E, 0x73, 0x74, 0x64, 0x2E, 0x34, 0x35, 0x30,
+    0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x07, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x10, 0x00, 0x03, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x90, 0x01, 0x00, 0x00, 0x04, 0x00, 0x09, 0x00,
+    0x47, 0x4C, 0x5F, 0x41, 0x52, 0x42, 0x5F, 0x73, 0x65, 0x70, 0x61, 0x72,
+    0x61, 0x74, 0x65, 0x5F, 0x73, 0x68, 0x61, 0x64, 0x65, 0x72, 0x5F, 0x6F,
+    0x62, 0x6A, 0x65, 0x63, 0x74, 0x73, 0x00, 0x00, 0x04, 0x00, 0x09, 0x00,
+    0x47, 0x4C, 0x5F, 0x41, 0x52, 0x42, 0x5F, 0x73, 0x68, 0x61, 0x64, 0x69,
+    0x6E, 0x67, 0x5F, 0x6C, 0x61, 0x6E, 0x67, 0x75, 0x61, 0x67, 0x65, 0x5F,
+    0x34, 0x32, 0x30, 0x70, 0x61, 0x63, 0x6B, 0x00, 0x05, 0x00, 0x04, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x05, 0x00, 0x09, 0x00, 0x00, 0x00, 0x6F, 0x75, 0x74, 0x5F,
+    0x63, 0x6F, 0x6C, 0x6F, 0x72, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x69, 0x6E, 0x5F, 0x63, 0x6F, 0x6C, 0x6F, 0x72,
+    0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x09, 0x00, 0x00, 0x00,
+    0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
+    0x0B, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x13, 0x00, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00, 0x21, 0x00, 0x03, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x16, 0x00, 0x03, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x17, 0x00, 0x04, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
+    0x0A, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x3B, 0x00, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x36, 0x00, 0x05, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0xF8, 0x00, 0x02, 0x00, 0x05, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
+    0x3E, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00,
+    0xFD, 0x00, 0x01, 0x00, 0x38, 0x00, 0x01, 0x00,
+};
@@ -0,0 +1,64 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+constexpr uint64_t c_fnv1a_seed = 14695981039346656037ull;
+
+/**
+ * FNV-1a over the bytes. Pass the result of a previous call as hash to
+ * continue over several ranges. Inline since the hash tables of the
+ * caches call it on every lookup.
+ */
+inline uint64_t fnv1a(
+    const void* data, std::size_t size, uint64_t hash = c_fnv1a_seed)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+struct FileChunk
+{
+    const void* data;
+    std::size_t size;
+};
+
+/**
+ * Writes the chunks one after another to a temporary file next to path and
+ * renames it over path, so readers see either the old or the new contents.
+ * The temporary name is unique per thread, concurrent writers of the same
+ * path don't interleave. Returns false and removes the temporary file when
+ * either step fails.
+ */
+bool writeFileAtomically(
+    const std::string& path, std::initializer_list<FileChunk> chunks);
@@ -0,0 +1,148 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "file_watcher.h"
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <system_error>
+#include <thread>
+#endif
+
+#if defined(__linux__)
+
+FileWatcher::~FileWatcher()
+{
+    if (fd_ >= 0)
+    {
+        // Removes the watch as well.
+        close(fd_);
+    }
+}
+
+bool FileWatcher::watch(const std::string& dir)
+{
+    fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd_ < 0)
+    {
+        return false;
+    }
+    return inotify_add_watch(
+               fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) >=
+           0;
+}
+
+std::vector<std::string> FileWatcher::poll(std::chrono::milliseconds timeout)
+{
+    std::vector<std::string> changed;
+
+    pollfd poll_fd = {};
+    poll_fd.fd = fd_;
+    poll_fd.events = POLLIN;
+    if (::poll(&poll_fd, 1, static_cast<int>(timeout.count())) <= 0)
+    {
+        return changed;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    while (true)
+    {
+        const ssize_t size = read(fd_, buffer, sizeof(buffer));
+        if (size <= 0)
+        {
+            break;
+        }
+        for (ssize_t offset = 0; offset < size;)
+        {
+            const auto* event =
+                reinterpret_cast<const inotify_event*>(buffer + offset);
+            if (event->len > 0 && !(event->mask & IN_ISDIR))
+            {
+                const std::string name = event->name;
+                if (std::find(changed.begin(), changed.end(), name) ==
+                    changed.end())
+                {
+                    changed.push_back(name);
+                }
+            }
+            offset += sizeof(inotify_event) + event->len;
+        }
+    }
+    return changed;
+}
+
+#else
+
+FileWatcher::~FileWatcher() = default;
+
+bool FileWatcher::watch(const std::string& dir)
+{
+    std::error_code error;
+    if (!std::filesystem::is_directory(dir, error))
+    {
+        return false;
+    }
+    dir_ = dir;
+    scan(nullptr);
+    return true;
+}
+
+std::vector<std::string> FileWatcher::poll(std::chrono::milliseconds timeout)
+{
+    std::this_thread::sleep_for(timeout);
+    std::vector<std::string> changed;
+    scan(&changed);
+    return changed;
+}
+
+void FileWatcher::scan(std::vector<std::string>* changed)
+{
+    std::error_code error;
+    for (const auto& entry :
+         std::filesystem::directory_iterator(dir_, error))
+    {
+        if (!entry.is_regular_file(error))
+        {
+            continue;
+        }
+        const std::string name = entry.path().filename().string();
+        const auto write_time = entry.last_write_time(error);
+        auto it = write_times_.find(name);
+        if (it == write_times_.end() || it->second != write_time)
+        {
+            write_times_[name] = write_time;
+            if (changed != nullptr)
+            {
+                changed->push_back(name);
+            }
+        }
+    }
+}
+
+#endif
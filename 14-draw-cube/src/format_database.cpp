@@ -0,0 +1,213 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "format_database.h"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "file_utils.h"
+
+namespace {
+
+constexpr uint32_t c_file_magic = 0x44464B56; // "VKFD"
+
+struct FileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vendor_id;
+    uint32_t device_id;
+    uint32_t driver_version;
+    uint32_t formats_num;
+    uint64_t checksum;
+};
+
+struct FileRecord
+{
+    uint32_t format;
+    uint32_t linear_tiling_features;
+    uint32_t optimal_tiling_features;
+    uint32_t buffer_features;
+};
+
+static_assert(sizeof(FileRecord) == 16, "Packed record");
+
+} // namespace
+
+const std::vector<VkFormat> FormatDatabase::c_depth_formats = {
+    VK_FORMAT_D32_SFLOAT,
+    VK_FORMAT_D24_UNORM_S8_UINT,
+    VK_FORMAT_D16_UNORM,
+};
+
+FormatDatabase::FormatDatabase(
+    VkPhysicalDevice physical_device,
+    const VkPhysicalDeviceProperties& physical_device_props)
+    : physical_device_(physical_device)
+    , physical_device_props_(physical_device_props)
+{
+}
+
+FormatDatabaseLoad FormatDatabase::load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return FormatDatabaseLoad::Missing;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    const std::string bytes = contents.str();
+
+    FileHeader header = {};
+    if (bytes.size() < sizeof(header))
+    {
+        return FormatDatabaseLoad::Corrupt;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    const std::size_t records_size = bytes.size() - sizeof(header);
+    const char* records = bytes.data() + sizeof(header);
+    if (header.magic != c_file_magic || header.version != c_file_version ||
+        records_size != header.formats_num * sizeof(FileRecord) ||
+        header.checksum != fnv1a(records, records_size))
+    {
+        return FormatDatabaseLoad::Corrupt;
+    }
+    if (header.vendor_id != physical_device_props_.vendorID ||
+        header.device_id != physical_device_props_.deviceID ||
+        header.driver_version != physical_device_props_.driverVersion)
+    {
+        return FormatDatabaseLoad::OtherDevice;
+    }
+
+    for (uint32_t i = 0; i < header.formats_num; ++i)
+    {
+        FileRecord record = {};
+        std::memcpy(&record, records + i * sizeof(record), sizeof(record));
+        VkFormatProperties& props =
+            formats_[static_cast<VkFormat>(record.format)];
+        props.linearTilingFeatures = record.linear_tiling_features;
+        props.optimalTilingFeatures = record.optimal_tiling_features;
+        props.bufferFeatures = record.buffer_features;
+    }
+    return FormatDatabaseLoad::Warm;
+}
+
+bool FormatDatabase::save(const std::string& path)
+{
+    if (!dirty_)
+    {
+        return true;
+    }
+
+    std::vector<FileRecord> records;
+    records.reserve(formats_.size());
+    for (const auto& format : formats_)
+    {
+        FileRecord record = {};
+        record.format = static_cast<uint32_t>(format.first);
+        record.linear_tiling_features = format.second.linearTilingFeatures;
+        record.optimal_tiling_features = format.second.optimalTilingFeatures;
+        record.buffer_features = format.second.bufferFeatures;
+        records.push_back(record);
+    }
+
+    FileHeader header = {};
+    header.magic = c_file_magic;
+    header.version = c_file_version;
+    header.vendor_id = physical_device_props_.vendorID;
+    header.device_id = physical_device_props_.deviceID;
+    header.driver_version = physical_device_props_.driverVersion;
+    header.formats_num = static_cast<uint32_t>(records.size());
+    header.checksum =
+        fnv1a(records.data(), records.size() * sizeof(FileRecord));
+
+    if (!writeFileAtomically(
+            path,
+            {{&header, sizeof(header)},
+             {records.data(), records.size() * sizeof(FileRecord)}}))
+    {
+        return false;
+    }
+    dirty_ = false;
+    return true;
+}
+
+const VkFormatProperties& FormatDatabase::properties(VkFormat format)
+{
+    auto found = formats_.find(format);
+    if (found != formats_.end())
+    {
+        return found->second;
+    }
+
+    VkFormatProperties props = {};
+    vkGetPhysicalDeviceFormatProperties(physical_device_, format, &props);
+    ++queries_num_;
+    dirty_ = true;
+    return formats_.emplace(format, props).first->second;
+}
+
+FormatChoice FormatDatabase::select(
+    const std::vector<VkFormat>& candidates, VkFormatFeatureFlags features)
+{
+    FormatChoice choice;
+    for (VkFormat format : candidates)
+    {
+        if ((properties(format).optimalTilingFeatures & features) == features)
+        {
+            choice.format = format;
+            choice.tiling = VK_IMAGE_TILING_OPTIMAL;
+            return choice;
+        }
+    }
+    for (VkFormat format : candidates)
+    {
+        if ((properties(format).linearTilingFeatures & features) == features)
+        {
+            choice.format = format;
+            choice.tiling = VK_IMAGE_TILING_LINEAR;
+            return choice;
+        }
+    }
+    return choice;
+}
+
+const char* toString(FormatDatabaseLoad load)
+{
+    switch (load)
+    {
+    case FormatDatabaseLoad::Warm:
+        return "warm";
+    case FormatDatabaseLoad::Missing:
+        return "missing";
+    case FormatDatabaseLoad::Corrupt:
+        return "corrupt";
+    case FormatDatabaseLoad::OtherDevice:
+        return "other device";
+    }
+    return "unknown";
+}
@@ -0,0 +1,108 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+enum class FormatDatabaseLoad
+{
+    Warm,
+    Missing,
+    Corrupt,
+    OtherDevice,
+};
+
+const char* toString(FormatDatabaseLoad load);
+
+struct FormatChoice
+{
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkImageTiling tiling = VK_IMAGE_TILING_MAX_ENUM;
+
+    bool found() const { return format != VK_FORMAT_UNDEFINED; }
+};
+
+/**
+ * The format properties of one physical device, each format queried at
+ * most once and optionally kept in a file between runs, so a warm start
+ * makes no vkGetPhysicalDeviceFormatProperties calls at all. The file is
+ * tied to the vendor, device and driver version; a driver update may
+ * change what the formats support, so it starts over.
+ */
+class FormatDatabase
+{
+public:
+    static constexpr uint32_t c_file_version = 1;
+
+    /** Depth formats from the most precise down to the smallest. */
+    static const std::vector<VkFormat> c_depth_formats;
+
+    FormatDatabase(
+        VkPhysicalDevice physical_device,
+        const VkPhysicalDeviceProperties& physical_device_props);
+
+    FormatDatabase(const FormatDatabase&) = delete;
+    FormatDatabase& operator=(const FormatDatabase&) = delete;
+
+    /** Anything that doesn't match this device leaves the database empty. */
+    FormatDatabaseLoad load(const std::string& path);
+
+    /**
+     * Writes through a temporary file and a rename. Returns true when the
+     * file is up to date, also when nothing was queried since the load.
+     */
+    bool save(const std::string& path);
+
+    const VkFormatProperties& properties(VkFormat format);
+
+    /**
+     * The first of candidates that supports features with optimal tiling.
+     * Linear tiling is the slow path on every GPU, the first candidate that
+     * supports features with it is only picked when none does with optimal.
+     */
+    FormatChoice select(
+        const std::vector<VkFormat>& candidates, VkFormatFeatureFlags features);
+
+    uint32_t formatsNum() const
+    {
+        return static_cast<uint32_t>(formats_.size());
+    }
+    uint32_t queriesNum() const { return queries_num_; }
+
+private:
+    VkPhysicalDevice physical_device_;
+    const VkPhysicalDeviceProperties& physical_device_props_;
+
+    // Ordered, so the same contents always serialise to the same bytes.
+    std::map<VkFormat, VkFormatProperties> formats_;
+    uint32_t queries_num_ = 0;
+    bool dirty_ = false;
+};
@@ -0,0 +1,184 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "frame_profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+double toMs(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// Nearest rank percentile of sorted values.
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0.0;
+    }
+    const auto rank = static_cast<std::size_t>(
+        std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+void writeJsonString(std::ostream& out, const std::string& value)
+{
+    out << '"';
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << '\\';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+void writeSummary(std::ostream& out, std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    const double mean =
+        values.empty()
+            ? 0.0
+            : std::accumulate(values.begin(), values.end(), 0.0) /
+                  static_cast<double>(values.size());
+
+    out << "{\"mean\": " << mean << ", \"p50\": " << percentile(values, 50)
+        << ", \"p95\": " << percentile(values, 95)
+        << ", \"p99\": " << percentile(values, 99)
+        << ", \"max\": " << (values.empty() ? 0.0 : values.back()) << "}";
+}
+
+} // namespace
+
+const char* toString(FrameStage stage)
+{
+    switch (stage)
+    {
+    case FrameStage::FenceWait:
+        return "fence_wait";
+    case FrameStage::Acquire:
+        return "acquire";
+    case FrameStage::Record:
+        return "record";
+    case FrameStage::Submit:
+        return "submit";
+    case FrameStage::Present:
+        return "present";
+    case FrameStage::Count:
+        break;
+    }
+    return "unknown";
+}
+
+FrameProfiler::FrameProfiler(uint64_t warmup_frames, uint64_t measured_frames)
+    : warmup_frames_(warmup_frames)
+    , measured_frames_(measured_frames)
+{
+    frame_times_ms_.reserve(measured_frames_);
+    for (auto& times : stage_times_ms_)
+    {
+        times.reserve(measured_frames_);
+    }
+}
+
+void FrameProfiler::beginFrame()
+{
+    frame_start_ = Clock::now();
+    last_mark_ = frame_start_;
+    current_stages_ms_.fill(0.0);
+
+    if (frames_ == warmup_frames_)
+    {
+        measure_start_ = frame_start_;
+    }
+}
+
+void FrameProfiler::endStage(FrameStage stage)
+{
+    const auto now = Clock::now();
+    current_stages_ms_[static_cast<std::size_t>(stage)] += toMs(now - last_mark_);
+    last_mark_ = now;
+}
+
+void FrameProfiler::endFrame()
+{
+    const auto now = Clock::now();
+    if (frames_++ < warmup_frames_ || done())
+    {
+        return;
+    }
+
+    frame_times_ms_.push_back(toMs(now - frame_start_));
+    for (std::size_t i = 0; i < c_stages_num; ++i)
+    {
+        stage_times_ms_[i].push_back(current_stages_ms_[i]);
+    }
+
+    measure_end_ = now;
+    ++measured_;
+}
+
+void FrameProfiler::writeJsonReport(
+    std::ostream& out,
+    const std::vector<std::pair<std::string, std::string>>& properties) const
+{
+    const double total_s = measured_ == 0 ? 0.0
+                                          : toMs(measure_end_ - measure_start_) /
+                                                1000.0;
+
+    out << "{\n";
+    for (const auto& property : properties)
+    {
+        out << "  ";
+        writeJsonString(out, property.first);
+        out << ": ";
+        writeJsonString(out, property.second);
+        out << ",\n";
+    }
+    out << "  \"warmup_frames\": " << warmup_frames_ << ",\n";
+    out << "  \"measured_frames\": " << measured_ << ",\n";
+    out << "  \"total_seconds\": " << total_s << ",\n";
+    out << "  \"fps\": "
+        << (total_s > 0.0 ? static_cast<double>(measured_) / total_s : 0.0)
+        << ",\n";
+    out << "  \"frame_ms\": ";
+    writeSummary(out, frame_times_ms_);
+    out << ",\n";
+    out << "  \"stage_ms\": {\n";
+    for (std::size_t i = 0; i < c_stages_num; ++i)
+    {
+        out << "    \"" << toString(static_cast<FrameStage>(i)) << "\": ";
+        writeSummary(out, stage_times_ms_[i]);
+        out << (i + 1 < c_stages_num ? ",\n" : "\n");
+    }
+    out << "  }\n";
+    out << "}" << std::endl;
+}
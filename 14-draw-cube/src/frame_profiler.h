@@ -0,0 +1,93 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum class FrameStage
+{
+    FenceWait,
+    Acquire,
+    Record,
+    Submit,
+    Present,
+    Count,
+};
+
+/**
+ * CPU side frame time benchmark. Every frame is split into stages that are
+ * closed in loop order; the first warmup_frames frames are discarded.
+ */
+class FrameProfiler
+{
+public:
+    FrameProfiler(uint64_t warmup_frames, uint64_t measured_frames);
+
+    void beginFrame();
+    /** Attributes the time since the previous mark to the stage. */
+    void endStage(FrameStage stage);
+    void endFrame();
+
+    bool done() const { return measured_ >= measured_frames_; }
+
+    /**
+     * Writes mean, p50, p95, p99 and max of the frame and stage times in
+     * milliseconds together with the frame rate. The properties are written
+     * as additional top level string fields to identify the run.
+     */
+    void writeJsonReport(
+        std::ostream& out,
+        const std::vector<std::pair<std::string, std::string>>& properties)
+        const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t c_stages_num =
+        static_cast<std::size_t>(FrameStage::Count);
+
+    const uint64_t warmup_frames_;
+    const uint64_t measured_frames_;
+
+    uint64_t frames_ = 0;
+    uint64_t measured_ = 0;
+
+    Clock::time_point frame_start_;
+    Clock::time_point last_mark_;
+    Clock::time_point measure_start_;
+    Clock::time_point measure_end_;
+    std::array<double, c_stages_num> current_stages_ms_ = {};
+
+    std::vector<double> frame_times_ms_;
+    std::array<std::vector<double>, c_stages_num> stage_times_ms_;
+};
+
+const char* toString(FrameStage stage);
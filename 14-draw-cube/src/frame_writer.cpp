@@ -0,0 +1,140 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "frame_writer.h"
+
+#include <cstdio>
+#include <iostream>
+#include <utility>
+
+FrameWriter::FrameWriter(std::string directory, std::size_t max_pending_frames)
+    : directory_(std::move(directory))
+    , max_pending_frames_(max_pending_frames)
+    , thread_(&FrameWriter::run, this)
+{
+}
+
+FrameWriter::~FrameWriter()
+{
+    finish();
+}
+
+void FrameWriter::finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    queue_changed_.notify_all();
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+}
+
+void FrameWriter::write(
+    uint64_t frame_number,
+    uint32_t width,
+    uint32_t height,
+    std::vector<uint8_t> rgba)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    queue_changed_.wait(
+        lock, [this] { return queue_.size() < max_pending_frames_; });
+    queue_.push_back(Frame{frame_number, width, height, std::move(rgba)});
+    lock.unlock();
+    queue_changed_.notify_all();
+}
+
+uint64_t FrameWriter::writtenFrames() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_frames_;
+}
+
+uint64_t FrameWriter::failedFrames() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_frames_;
+}
+
+void FrameWriter::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;)
+    {
+        queue_changed_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (queue_.empty())
+        {
+            // Only reached when stopping, pending frames are always drained.
+            return;
+        }
+
+        Frame frame = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+        queue_changed_.notify_all();
+
+        const bool written = writePpm(frame);
+
+        lock.lock();
+        ++(written ? written_frames_ : failed_frames_);
+    }
+}
+
+bool FrameWriter::writePpm(const Frame& frame) const
+{
+    char file_name[32] = {};
+    std::snprintf(
+        file_name,
+        sizeof(file_name),
+        "frame_%06llu.ppm",
+        static_cast<unsigned long long>(frame.number));
+    const std::string path = directory_ + "/" + file_name;
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        std::cerr << "Failed to open '" << path << "' for writing." << std::endl;
+        return false;
+    }
+
+    std::fprintf(file, "P6\n%u %u\n255\n", frame.width, frame.height);
+
+    std::vector<uint8_t> row(frame.width * 3);
+    bool written = true;
+    for (uint32_t y = 0; y < frame.height && written; ++y)
+    {
+        const uint8_t* src = frame.rgba.data() + y * frame.width * 4;
+        for (uint32_t x = 0; x < frame.width; ++x)
+        {
+            row[x * 3 + 0] = src[x * 4 + 0];
+            row[x * 3 + 1] = src[x * 4 + 1];
+            row[x * 3 + 2] = src[x * 4 + 2];
+        }
+        written = std::fwrite(row.data(), 1, row.size(), file) == row.size();
+    }
+
+    return std::fclose(file) == 0 && written;
+}
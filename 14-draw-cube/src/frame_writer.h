@@ -0,0 +1,91 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Writes read back frames to disk as binary PPM files on a background thread,
+ * so the render loop never waits for the file system. Frames are expected in
+ * tightly packed RGBA8 layout.
+ */
+class FrameWriter
+{
+public:
+    FrameWriter(std::string directory, std::size_t max_pending_frames);
+    ~FrameWriter();
+
+    FrameWriter(const FrameWriter&) = delete;
+    FrameWriter& operator=(const FrameWriter&) = delete;
+
+    /**
+     * Queues a frame for writing. Blocks only when max_pending_frames are
+     * already waiting, which bounds memory when the disk can't keep up.
+     */
+    void write(
+        uint64_t frame_number,
+        uint32_t width,
+        uint32_t height,
+        std::vector<uint8_t> rgba);
+
+    /**
+     * Writes all queued frames and stops the background thread. No frames
+     * can be queued afterwards.
+     */
+    void finish();
+
+    uint64_t writtenFrames() const;
+    uint64_t failedFrames() const;
+
+private:
+    struct Frame
+    {
+        uint64_t number;
+        uint32_t width;
+        uint32_t height;
+        std::vector<uint8_t> rgba;
+    };
+
+    void run();
+    bool writePpm(const Frame& frame) const;
+
+    const std::string directory_;
+    const std::size_t max_pending_frames_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable queue_changed_;
+    std::deque<Frame> queue_;
+    bool stop_ = false;
+    uint64_t written_frames_ = 0;
+    uint64_t failed_frames_ = 0;
+
+    std::thread thread_;
+};
@@ -0,0 +1,369 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "gpu_culler.h"
+
+#include <array>
+
+namespace {
+
+constexpr uint32_t c_bindings_num = 3;
+
+} // namespace
+
+GpuCuller::GpuCuller(VkDevice device, MemoryAllocator& memory_allocator)
+    : device_(device)
+    , memory_allocator_(memory_allocator)
+{
+}
+
+GpuCuller::~GpuCuller()
+{
+    for (Set& set : sets_)
+    {
+        if (set.visible_buf != VK_NULL_HANDLE)
+        {
+            vkDestroyBuffer(device_, set.visible_buf, nullptr);
+        }
+        memory_allocator_.free(set.visible_mem);
+        if (set.draw_buf != VK_NULL_HANDLE)
+        {
+            vkDestroyBuffer(device_, set.draw_buf, nullptr);
+        }
+        memory_allocator_.free(set.draw_mem);
+    }
+    if (pipeline_ != VK_NULL_HANDLE)
+    {
+        vkDestroyPipeline(device_, pipeline_, nullptr);
+    }
+    if (pipeline_layout_ != VK_NULL_HANDLE)
+    {
+        vkDestroyPipelineLayout(device_, pipeline_layout_, nullptr);
+    }
+    if (desc_pool_ != VK_NULL_HANDLE)
+    {
+        // Frees the descriptor sets as well.
+        vkDestroyDescriptorPool(device_, desc_pool_, nullptr);
+    }
+    if (desc_set_layout_ != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorSetLayout(device_, desc_set_layout_, nullptr);
+    }
+}
+
+VkResult GpuCuller::create(
+    const std::vector<uint8_t>& shader_code,
+    VkBuffer instances,
+    uint32_t instance_count,
+    VkDeviceSize instance_size,
+    uint32_t index_count,
+    uint32_t sets_num,
+    VkPipelineCache pipeline_cache)
+{
+    instance_count_ = instance_count;
+    index_count_ = index_count;
+    pipeline_cache_ = pipeline_cache;
+
+    std::array<VkDescriptorSetLayoutBinding, c_bindings_num> layout_bindings =
+        {};
+    for (uint32_t i = 0; i < layout_bindings.size(); ++i)
+    {
+        layout_bindings[i].binding = i;
+        layout_bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        layout_bindings[i].descriptorCount = 1;
+        layout_bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo desc_set_layout_info = {};
+    desc_set_layout_info.sType =
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    desc_set_layout_info.bindingCount =
+        static_cast<uint32_t>(layout_bindings.size());
+    desc_set_layout_info.pBindings = layout_bindings.data();
+    if (VkResult result = vkCreateDescriptorSetLayout(
+            device_, &desc_set_layout_info, nullptr, &desc_set_layout_);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkPushConstantRange push_constant_range = {};
+    push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    push_constant_range.offset = 0;
+    push_constant_range.size = sizeof(PushConstants);
+
+    VkPipelineLayoutCreateInfo pipeline_layout_info = {};
+    pipeline_layout_info.sType =
+        VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipeline_layout_info.setLayoutCount = 1;
+    pipeline_layout_info.pSetLayouts = &desc_set_layout_;
+    pipeline_layout_info.pushConstantRangeCount = 1;
+    pipeline_layout_info.pPushConstantRanges = &push_constant_range;
+    if (VkResult result = vkCreatePipelineLayout(
+            device_, &pipeline_layout_info, nullptr, &pipeline_layout_);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    if (VkResult result = createPipeline(shader_code, pipeline_);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkDescriptorPoolSize pool_size = {};
+    pool_size.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    pool_size.descriptorCount =
+        sets_num * static_cast<uint32_t>(layout_bindings.size());
+
+    VkDescriptorPoolCreateInfo desc_pool_info = {};
+    desc_pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    desc_pool_info.maxSets = sets_num;
+    desc_pool_info.poolSizeCount = 1;
+    desc_pool_info.pPoolSizes = &pool_size;
+    if (VkResult result = vkCreateDescriptorPool(
+            device_, &desc_pool_info, nullptr, &desc_pool_);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    // The shader treats instances as plain words, so the visible instances
+    // keep the stride of the input and can be bound as a vertex buffer.
+    sets_.resize(sets_num);
+    for (Set& set : sets_)
+    {
+        if (VkResult result = createBuffer(
+                instance_size * instance_count,
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                set.visible_buf,
+                set.visible_mem);
+            result != VK_SUCCESS)
+        {
+            return result;
+        }
+        if (VkResult result = createBuffer(
+                sizeof(VkDrawIndexedIndirectCommand),
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                    VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                    VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                set.draw_buf,
+                set.draw_mem);
+            result != VK_SUCCESS)
+        {
+            return result;
+        }
+
+        VkDescriptorSetAllocateInfo desc_set_info = {};
+        desc_set_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        desc_set_info.descriptorPool = desc_pool_;
+        desc_set_info.descriptorSetCount = 1;
+        desc_set_info.pSetLayouts = &desc_set_layout_;
+        if (VkResult result =
+                vkAllocateDescriptorSets(device_, &desc_set_info, &set.desc_set);
+            result != VK_SUCCESS)
+        {
+            return result;
+        }
+
+        std::array<VkDescriptorBufferInfo, 3> buffer_infos = {};
+        buffer_infos[0].buffer = instances;
+        buffer_infos[1].buffer = set.visible_buf;
+        buffer_infos[2].buffer = set.draw_buf;
+        std::array<VkWriteDescriptorSet, 3> writes = {};
+        for (uint32_t i = 0; i < writes.size(); ++i)
+        {
+            buffer_infos[i].offset = 0;
+            buffer_infos[i].range = VK_WHOLE_SIZE;
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = set.desc_set;
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pBufferInfo = &buffer_infos[i];
+        }
+        vkUpdateDescriptorSets(
+            device_,
+            static_cast<uint32_t>(writes.size()),
+            writes.data(),
+            0,
+            nullptr);
+    }
+    return VK_SUCCESS;
+}
+
+VkResult GpuCuller::createPipeline(
+    const std::vector<uint8_t>& shader_code, VkPipeline& pipeline) const
+{
+    VkShaderModuleCreateInfo shader_module_info = {};
+    shader_module_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    shader_module_info.codeSize = shader_code.size();
+    shader_module_info.pCode =
+        reinterpret_cast<const uint32_t*>(shader_code.data());
+    VkShaderModule shader_module = VK_NULL_HANDLE;
+    if (VkResult result = vkCreateShaderModule(
+            device_, &shader_module_info, nullptr, &shader_module);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkComputePipelineCreateInfo pipeline_info = {};
+    pipeline_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipeline_info.stage.sType =
+        VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipeline_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipeline_info.stage.module = shader_module;
+    pipeline_info.stage.pName = "main";
+    pipeline_info.layout = pipeline_layout_;
+    VkResult pipeline_result = vkCreateComputePipelines(
+        device_, pipeline_cache_, 1, &pipeline_info, nullptr, &pipeline);
+    vkDestroyShaderModule(device_, shader_module, nullptr);
+    return pipeline_result;
+}
+
+bool GpuCuller::checkInterface(
+    const ShaderReflection& reflection, std::string& error)
+{
+    if (reflection.stage != VK_SHADER_STAGE_COMPUTE_BIT)
+    {
+        error = "The cull shader is not a compute shader.";
+        return false;
+    }
+    for (const DescriptorBinding& binding : reflection.bindings)
+    {
+        if (binding.set != 0 || binding.binding >= c_bindings_num ||
+            binding.type != VK_DESCRIPTOR_TYPE_STORAGE_BUFFER ||
+            binding.count != 1)
+        {
+            error = "Binding '" + binding.name + "' (set " +
+                std::to_string(binding.set) + ", binding " +
+                std::to_string(binding.binding) +
+                ") is not one of the culler's storage buffers.";
+            return false;
+        }
+    }
+    if (reflection.has_push_constants &&
+        reflection.push_constants.size > sizeof(PushConstants))
+    {
+        error = "The push constants take " +
+            std::to_string(reflection.push_constants.size) +
+            " bytes, the culler provides " +
+            std::to_string(sizeof(PushConstants)) + ".";
+        return false;
+    }
+    return true;
+}
+
+VkPipeline GpuCuller::swapPipeline(VkPipeline pipeline)
+{
+    VkPipeline previous = pipeline_;
+    pipeline_ = pipeline;
+    return previous;
+}
+
+void GpuCuller::record(
+    VkCommandBuffer cmd_buffer, uint32_t set, const Frustum& frustum)
+{
+    const Set& current = sets_[set];
+
+    VkDrawIndexedIndirectCommand draw = {};
+    draw.indexCount = index_count_;
+    draw.instanceCount = 0;
+    draw.firstIndex = 0;
+    draw.vertexOffset = 0;
+    draw.firstInstance = 0;
+    vkCmdUpdateBuffer(cmd_buffer, current.draw_buf, 0, sizeof(draw), &draw);
+
+    VkBufferMemoryBarrier reset_barrier = {};
+    reset_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    reset_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    reset_barrier.dstAccessMask =
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    reset_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    reset_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    reset_barrier.buffer = current.draw_buf;
+    reset_barrier.offset = 0;
+    reset_barrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(
+        cmd_buffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        0,
+        nullptr,
+        1,
+        &reset_barrier,
+        0,
+        nullptr);
+
+    PushConstants push_constants = {};
+    push_constants.frustum = frustum;
+    push_constants.instance_count = instance_count_;
+
+    vkCmdBindPipeline(cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_);
+    vkCmdBindDescriptorSets(
+        cmd_buffer,
+        VK_PIPELINE_BIND_POINT_COMPUTE,
+        pipeline_layout_,
+        0,
+        1,
+        &current.desc_set,
+        0,
+        nullptr);
+    vkCmdPushConstants(
+        cmd_buffer,
+        pipeline_layout_,
+        VK_SHADER_STAGE_COMPUTE_BIT,
+        0,
+        sizeof(push_constants),
+        &push_constants);
+    vkCmdDispatch(
+        cmd_buffer,
+        (instance_count_ + c_workgroup_size - 1) / c_workgroup_size,
+        1,
+        1);
+}
+
+VkResult GpuCuller::createBuffer(
+    VkDeviceSize size,
+    VkBufferUsageFlags usage,
+    VkBuffer& buffer,
+    MemoryAllocation& allocation)
+{
+    VkBufferCreateInfo buf_info = {};
+    buf_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buf_info.usage = usage;
+    buf_info.size = size;
+    buf_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (VkResult result = vkCreateBuffer(device_, &buf_info, nullptr, &buffer);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+    return memory_allocator_.allocateBuffer(
+        buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0, allocation);
+}
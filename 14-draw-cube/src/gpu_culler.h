@@ -0,0 +1,147 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "frustum.h"
+#include "memory_allocator.h"
+#include "shader_reflection.h"
+
+/**
+ * GPU driven culling of an instanced draw. A compute dispatch tests the
+ * bounding box of every instance against the frustum and appends the
+ * visible instances to a compacted instance buffer, counting them in the
+ * instanceCount of a VkDrawIndexedIndirectCommand. vkCmdDrawIndexedIndirect
+ * then consumes both without a round trip through the CPU.
+ *
+ * The cull shader defines the instance layout, an object space bounding
+ * box of [-1, 1]^3 and the bindings: 0 instances, 1 visible instances,
+ * 2 draw command; the push constants hold the planes and the count.
+ *
+ * Every resource set owns its output buffers, so a set must not be culled
+ * again before the fence of the frame that drew from it has been waited on.
+ */
+class GpuCuller
+{
+public:
+    static constexpr uint32_t c_workgroup_size = 64;
+
+    GpuCuller(VkDevice device, MemoryAllocator& memory_allocator);
+    ~GpuCuller();
+
+    GpuCuller(const GpuCuller&) = delete;
+    GpuCuller& operator=(const GpuCuller&) = delete;
+
+    /**
+     * instances needs STORAGE_BUFFER usage and holds instance_count
+     * records of instance_size bytes. Every surviving instance is drawn
+     * with the first index_count indices. pipeline_cache may be
+     * VK_NULL_HANDLE and is used for the pipelines of createPipeline() too.
+     */
+    VkResult create(
+        const std::vector<uint8_t>& shader_code,
+        VkBuffer instances,
+        uint32_t instance_count,
+        VkDeviceSize instance_size,
+        uint32_t index_count,
+        uint32_t sets_num,
+        VkPipelineCache pipeline_cache);
+
+    /**
+     * Builds a pipeline for another version of the cull shader against the
+     * existing layout. Doesn't touch the culler state, so it may run on a
+     * different thread than record().
+     */
+    VkResult createPipeline(
+        const std::vector<uint8_t>& shader_code, VkPipeline& pipeline) const;
+
+    /**
+     * Checks that a cull shader fits the fixed layout: a compute shader
+     * using only the three storage buffers of set 0 and push constants
+     * within the culler's range.
+     */
+    static bool checkInterface(
+        const ShaderReflection& reflection, std::string& error);
+
+    /**
+     * Makes pipeline current and returns the previous one, which the caller
+     * destroys once no command buffer using it is pending.
+     */
+    VkPipeline swapPipeline(VkPipeline pipeline);
+
+    /**
+     * Resets the draw command of the set and culls into it. Must be
+     * recorded outside of a render pass; the caller makes the results
+     * visible to the indirect and vertex input stages of the draws.
+     */
+    void record(
+        VkCommandBuffer cmd_buffer, uint32_t set, const Frustum& frustum);
+
+    VkBuffer visibleInstances(uint32_t set) const
+    {
+        return sets_[set].visible_buf;
+    }
+    VkBuffer drawCommand(uint32_t set) const { return sets_[set].draw_buf; }
+
+private:
+    struct PushConstants
+    {
+        Frustum frustum;
+        uint32_t instance_count;
+    };
+
+    struct Set
+    {
+        VkBuffer visible_buf = VK_NULL_HANDLE;
+        MemoryAllocation visible_mem;
+        VkBuffer draw_buf = VK_NULL_HANDLE;
+        MemoryAllocation draw_mem;
+        VkDescriptorSet desc_set = VK_NULL_HANDLE;
+    };
+
+    VkResult createBuffer(
+        VkDeviceSize size,
+        VkBufferUsageFlags usage,
+        VkBuffer& buffer,
+        MemoryAllocation& allocation);
+
+    VkDevice device_;
+    MemoryAllocator& memory_allocator_;
+
+    uint32_t instance_count_ = 0;
+    uint32_t index_count_ = 0;
+
+    VkDescriptorSetLayout desc_set_layout_ = VK_NULL_HANDLE;
+    VkDescriptorPool desc_pool_ = VK_NULL_HANDLE;
+    VkPipelineCache pipeline_cache_ = VK_NULL_HANDLE;
+    VkPipelineLayout pipeline_layout_ = VK_NULL_HANDLE;
+    VkPipeline pipeline_ = VK_NULL_HANDLE;
+    std::vector<Set> sets_;
+};
@@ -0,0 +1,332 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "gpu_profiler.h"
+
+#include <algorithm>
+
+namespace {
+
+// Counters are returned in the order of their flag bits.
+constexpr VkQueryPipelineStatisticFlags c_pipeline_statistics =
+    VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+constexpr uint32_t c_pipeline_statistics_num = 3;
+
+} // namespace
+
+GpuProfiler::~GpuProfiler()
+{
+    destroy();
+}
+
+VkResult GpuProfiler::create(
+    VkDevice device,
+    const VkPhysicalDeviceProperties& physical_device_props,
+    uint32_t timestamp_valid_bits,
+    bool pipeline_statistics,
+    uint32_t sets_num,
+    uint32_t max_scopes)
+{
+    destroy();
+    if (timestamp_valid_bits == 0 || sets_num == 0 || max_scopes == 0)
+    {
+        return VK_SUCCESS;
+    }
+
+    device_ = device;
+    timestamp_period_ns_ = physical_device_props.limits.timestampPeriod;
+    timestamp_mask_ = timestamp_valid_bits >= 64
+                          ? UINT64_MAX
+                          : (uint64_t(1) << timestamp_valid_bits) - 1;
+    max_scopes_ = max_scopes;
+    pipeline_statistics_ = pipeline_statistics;
+
+    sets_.resize(sets_num);
+    for (auto& set : sets_)
+    {
+        VkQueryPoolCreateInfo timestamp_pool_info = {};
+        timestamp_pool_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        timestamp_pool_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        timestamp_pool_info.queryCount = 2 * max_scopes_;
+        if (VkResult result = vkCreateQueryPool(
+                device_, &timestamp_pool_info, nullptr, &set.timestamp_pool);
+            result != VK_SUCCESS)
+        {
+            destroy();
+            return result;
+        }
+
+        if (pipeline_statistics_)
+        {
+            VkQueryPoolCreateInfo statistics_pool_info = {};
+            statistics_pool_info.sType =
+                VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            statistics_pool_info.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+            statistics_pool_info.queryCount = max_scopes_;
+            statistics_pool_info.pipelineStatistics = c_pipeline_statistics;
+            if (VkResult result = vkCreateQueryPool(
+                    device_,
+                    &statistics_pool_info,
+                    nullptr,
+                    &set.statistics_pool);
+                result != VK_SUCCESS)
+            {
+                destroy();
+                return result;
+            }
+        }
+    }
+    return VK_SUCCESS;
+}
+
+void GpuProfiler::destroy()
+{
+    for (auto& set : sets_)
+    {
+        if (set.timestamp_pool != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(device_, set.timestamp_pool, nullptr);
+        }
+        if (set.statistics_pool != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(device_, set.statistics_pool, nullptr);
+        }
+    }
+    sets_.clear();
+    device_ = VK_NULL_HANDLE;
+}
+
+void GpuProfiler::beginFrame(VkCommandBuffer cmd_buffer, uint32_t set)
+{
+    if (!enabled())
+    {
+        return;
+    }
+
+    recording_set_ = set;
+    QuerySet& query_set = sets_[set];
+    query_set.scopes.clear();
+    query_set.statistics_queries_num = 0;
+    query_set.pending = false;
+
+    vkCmdResetQueryPool(cmd_buffer, query_set.timestamp_pool, 0, 2 * max_scopes_);
+    if (query_set.statistics_pool != VK_NULL_HANDLE)
+    {
+        vkCmdResetQueryPool(cmd_buffer, query_set.statistics_pool, 0, max_scopes_);
+    }
+}
+
+uint32_t GpuProfiler::beginScope(
+    VkCommandBuffer cmd_buffer, const char* name, bool statistics)
+{
+    if (!enabled())
+    {
+        return c_no_scope;
+    }
+
+    QuerySet& query_set = sets_[recording_set_];
+    if (query_set.scopes.size() >= max_scopes_)
+    {
+        return c_no_scope;
+    }
+
+    const auto scope = static_cast<uint32_t>(query_set.scopes.size());
+    uint32_t statistics_query = c_no_scope;
+    if (statistics && query_set.statistics_pool != VK_NULL_HANDLE)
+    {
+        statistics_query = query_set.statistics_queries_num++;
+    }
+    query_set.scopes.push_back({name, statistics_query});
+
+    vkCmdWriteTimestamp(
+        cmd_buffer,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+        query_set.timestamp_pool,
+        2 * scope);
+    if (statistics_query != c_no_scope)
+    {
+        vkCmdBeginQuery(
+            cmd_buffer, query_set.statistics_pool, statistics_query, 0);
+    }
+    return scope;
+}
+
+void GpuProfiler::endScope(VkCommandBuffer cmd_buffer, uint32_t scope)
+{
+    if (!enabled() || scope == c_no_scope)
+    {
+        return;
+    }
+
+    QuerySet& query_set = sets_[recording_set_];
+    const uint32_t statistics_query = query_set.scopes[scope].statistics_query;
+    if (statistics_query != c_no_scope)
+    {
+        vkCmdEndQuery(cmd_buffer, query_set.statistics_pool, statistics_query);
+    }
+    vkCmdWriteTimestamp(
+        cmd_buffer,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        query_set.timestamp_pool,
+        2 * scope + 1);
+}
+
+void GpuProfiler::submitted(uint32_t set)
+{
+    if (enabled())
+    {
+        sets_[set].pending = true;
+    }
+}
+
+bool GpuProfiler::collect(uint32_t set)
+{
+    if (!enabled() || !sets_[set].pending || sets_[set].scopes.empty())
+    {
+        return false;
+    }
+
+    QuerySet& query_set = sets_[set];
+    const auto scopes_num = static_cast<uint32_t>(query_set.scopes.size());
+
+    // Every query is followed by its availability word, nothing blocks.
+    const VkQueryResultFlags result_flags =
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT;
+
+    std::vector<uint64_t> timestamps(2 * scopes_num * 2);
+    VkResult result = vkGetQueryPoolResults(
+        device_,
+        query_set.timestamp_pool,
+        0,
+        2 * scopes_num,
+        timestamps.size() * sizeof(uint64_t),
+        timestamps.data(),
+        2 * sizeof(uint64_t),
+        result_flags);
+    if (result != VK_SUCCESS && result != VK_NOT_READY)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < 2 * scopes_num; ++i)
+    {
+        if (timestamps[2 * i + 1] == 0)
+        {
+            return false;
+        }
+    }
+
+    const uint32_t stride = c_pipeline_statistics_num + 1;
+    std::vector<uint64_t> statistics(query_set.statistics_queries_num * stride);
+    if (!statistics.empty())
+    {
+        result = vkGetQueryPoolResults(
+            device_,
+            query_set.statistics_pool,
+            0,
+            query_set.statistics_queries_num,
+            statistics.size() * sizeof(uint64_t),
+            statistics.data(),
+            stride * sizeof(uint64_t),
+            result_flags);
+        if (result != VK_SUCCESS && result != VK_NOT_READY)
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < query_set.statistics_queries_num; ++i)
+        {
+            if (statistics[i * stride + c_pipeline_statistics_num] == 0)
+            {
+                return false;
+            }
+        }
+    }
+
+    query_set.pending = false;
+    latest_results_.resize(scopes_num);
+    for (uint32_t i = 0; i < scopes_num; ++i)
+    {
+        const Scope& scope = query_set.scopes[i];
+        GpuScopeResult& scope_result = latest_results_[i];
+        scope_result = {};
+        scope_result.name = scope.name;
+
+        // Masking handles counters that wrapped between the two timestamps.
+        const uint64_t ticks =
+            (timestamps[2 * (2 * i + 1)] - timestamps[2 * (2 * i)]) &
+            timestamp_mask_;
+        scope_result.gpu_ms =
+            static_cast<double>(ticks) * timestamp_period_ns_ / 1000000.0;
+
+        if (scope.statistics_query != c_no_scope)
+        {
+            const uint64_t* counters =
+                &statistics[scope.statistics_query * stride];
+            scope_result.has_statistics = true;
+            scope_result.vertex_shader_invocations = counters[0];
+            scope_result.clipping_primitives = counters[1];
+            scope_result.fragment_shader_invocations = counters[2];
+        }
+
+        auto totals = std::find_if(
+            totals_.begin(), totals_.end(), [&](const ScopeTotals& t) {
+                return t.name == scope_result.name;
+            });
+        if (totals == totals_.end())
+        {
+            totals = totals_.insert(totals_.end(), ScopeTotals{});
+            totals->name = scope_result.name;
+        }
+        ++totals->frames;
+        totals->gpu_ms += scope_result.gpu_ms;
+        totals->has_statistics |= scope_result.has_statistics;
+        totals->vertex_shader_invocations +=
+            scope_result.vertex_shader_invocations;
+        totals->clipping_primitives += scope_result.clipping_primitives;
+        totals->fragment_shader_invocations +=
+            scope_result.fragment_shader_invocations;
+    }
+    return true;
+}
+
+void GpuProfiler::writeSummary(std::ostream& out) const
+{
+    for (const auto& totals : totals_)
+    {
+        const auto frames = static_cast<double>(totals.frames);
+        out << "GPU " << totals.name << ": " << totals.gpu_ms / frames
+            << " ms";
+        if (totals.has_statistics)
+        {
+            out << ", vertex invocations: "
+                << totals.vertex_shader_invocations / totals.frames
+                << ", clipping primitives: "
+                << totals.clipping_primitives / totals.frames
+                << ", fragment invocations: "
+                << totals.fragment_shader_invocations / totals.frames;
+        }
+        out << " (" << totals.frames << " frames)" << std::endl;
+    }
+}
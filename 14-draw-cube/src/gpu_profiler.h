@@ -0,0 +1,153 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/** GPU time and optional pipeline statistics of one profiled scope. */
+struct GpuScopeResult
+{
+    std::string name;
+    double gpu_ms = 0.0;
+    bool has_statistics = false;
+    uint64_t vertex_shader_invocations = 0;
+    uint64_t clipping_primitives = 0;
+    uint64_t fragment_shader_invocations = 0;
+};
+
+/**
+ * Measures command buffer scopes on the GPU with timestamp pairs and
+ * pipeline statistics queries.
+ *
+ * Queries are grouped into sets, one per command buffer that can be pending
+ * at the same time. A set is reset and filled while its command buffer is
+ * recorded and read back without waiting once that command buffer has
+ * finished executing, which in a frames in flight ring is a few frames later.
+ */
+class GpuProfiler
+{
+public:
+    static constexpr uint32_t c_no_scope = UINT32_MAX;
+
+    GpuProfiler() = default;
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    /**
+     * timestamp_valid_bits comes from the queue family the command buffers
+     * are submitted to. Pipeline statistics need the pipelineStatisticsQuery
+     * device feature to be enabled.
+     */
+    VkResult create(
+        VkDevice device,
+        const VkPhysicalDeviceProperties& physical_device_props,
+        uint32_t timestamp_valid_bits,
+        bool pipeline_statistics,
+        uint32_t sets_num,
+        uint32_t max_scopes);
+    void destroy();
+
+    /** False when the queue doesn't support timestamps. */
+    bool enabled() const { return !sets_.empty(); }
+    uint32_t setsNum() const { return static_cast<uint32_t>(sets_.size()); }
+
+    /**
+     * Starts recording into the set. Records the query resets, so it has to
+     * be called outside of a render pass.
+     */
+    void beginFrame(VkCommandBuffer cmd_buffer, uint32_t set);
+
+    /**
+     * Returns c_no_scope when the set is out of queries. Scopes collecting
+     * statistics must not nest, only one query of a type can be active.
+     */
+    uint32_t beginScope(
+        VkCommandBuffer cmd_buffer, const char* name, bool statistics);
+    void endScope(VkCommandBuffer cmd_buffer, uint32_t scope);
+
+    /** Marks the command buffer recorded into the set as submitted. */
+    void submitted(uint32_t set);
+
+    /**
+     * Reads back the results of the last submission of the set without
+     * waiting. Returns false when there is nothing new or the results aren't
+     * available yet.
+     */
+    bool collect(uint32_t set);
+
+    const std::vector<GpuScopeResult>& latestResults() const
+    {
+        return latest_results_;
+    }
+
+    /** Writes per scope averages over all collected frames. */
+    void writeSummary(std::ostream& out) const;
+
+private:
+    struct Scope
+    {
+        std::string name;
+        uint32_t statistics_query;
+    };
+
+    struct QuerySet
+    {
+        VkQueryPool timestamp_pool = VK_NULL_HANDLE;
+        VkQueryPool statistics_pool = VK_NULL_HANDLE;
+        std::vector<Scope> scopes;
+        uint32_t statistics_queries_num = 0;
+        bool pending = false;
+    };
+
+    struct ScopeTotals
+    {
+        std::string name;
+        uint64_t frames = 0;
+        double gpu_ms = 0.0;
+        uint64_t vertex_shader_invocations = 0;
+        uint64_t clipping_primitives = 0;
+        uint64_t fragment_shader_invocations = 0;
+        bool has_statistics = false;
+    };
+
+    VkDevice device_ = VK_NULL_HANDLE;
+    double timestamp_period_ns_ = 1.0;
+    uint64_t timestamp_mask_ = 0;
+    uint32_t max_scopes_ = 0;
+    bool pipeline_statistics_ = false;
+
+    std::vector<QuerySet> sets_;
+    uint32_t recording_set_ = 0;
+
+    std::vector<GpuScopeResult> latest_results_;
+    std::vector<ScopeTotals> totals_;
+};
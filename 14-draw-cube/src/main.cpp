@@ -24,15 +24,49 @@
 
 #include <GLFW/glfw3.h>
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <random>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
 #include <set>
 #include <shaderc/shaderc.hpp>
+#include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "bindless_heap.h"
+#include "cpu_culler.h"
+#include "descriptor_allocator.h"
+#include "embedded_shaders.h"
+#include "frame_profiler.h"
+#include "format_database.h"
+#include "frame_writer.h"
+#include "frustum.h"
+#include "gpu_culler.h"
+#include "gpu_profiler.h"
+#include "memory_allocator.h"
+#include "mesh_optimizer.h"
+#include "pipeline_cache.h"
+#include "pipeline_factory.h"
+#include "pipeline_layout_cache.h"
+#include "render_graph.h"
+#include "shader_manager.h"
+#include "shader_reflection.h"
+#include "shader_reloader.h"
+#include "staging_uploader.h"
+#include "thread_pool.h"
+#include "uniform_ring.h"
+#include "vertex_format.h"
+
 #define FAIL_IF_NOT_SUCCESS(FunctionCall, ActionName)                     \
     if (VkResult result = (FunctionCall); result != VK_SUCCESS)           \
     {                                                                     \
@@ -44,185 +78,56 @@
 constexpr uint32_t c_width = 640;
 constexpr uint32_t c_height = 480;
 
+/**
+ * Number of frames the CPU may record ahead of the GPU. Every frame in flight
+ * owns its own command buffer, fence and semaphores, so recording of frame N+1
+ * overlaps GPU execution of frame N.
+ */
+constexpr uint32_t c_default_frames_in_flight = 2;
+constexpr uint32_t c_max_frames_in_flight = 8;
+
+constexpr uint64_t c_default_headless_frames = 100;
+constexpr std::size_t c_max_pending_dumped_frames = 8;
+
+constexpr uint64_t c_default_bench_warmup_frames = 60;
+constexpr uint64_t c_default_bench_frames = 600;
+
+constexpr uint32_t c_gpu_profiler_max_scopes = 8;
+
+const char* const c_default_shader_cache_dir = "shader_cache";
+const char* const c_default_pipeline_cache_path = "pipeline_cache.bin";
+const char* const c_default_format_db_path = "format_db.bin";
+
+/** Objects scattered around the view and passes per kernel of --cull-bench. */
+constexpr uint32_t c_cull_bench_objects = 1000000;
+constexpr uint32_t c_cull_bench_passes = 100;
+
+/**
+ * Every object gets its own MVP in the uniform ring, spaced by
+ * minUniformBufferOffsetAlignment, so this bounds the ring at a few dozen
+ * megabytes per frame.
+ */
+constexpr uint32_t c_max_objects = 100000;
+
+/** Instances only cost a model matrix and a color each in a static buffer. */
+constexpr uint32_t c_max_instances = 1000000;
+
+// Requested array sizes of the bindless heap, clamped to the device limits.
+constexpr uint32_t c_bindless_heap_buffers = 4096;
+constexpr uint32_t c_bindless_heap_images = 4096;
+
 const glm::mat4 c_clip(
     glm::vec4(1.f, 0.f, 0.f, 0.f),
     glm::vec4(0.f, -1.f, 0.f, 0.f),
     glm::vec4(0.f, 0.f, .5f, 0.f),
     glm::vec4(0.f, 0.f, .5f, 1.f));
 
-const glm::mat4 c_mvp = c_clip *
-                        glm::perspective(glm::radians(45.f), 1.f, .1f, 100.f) *
-                        glm::lookAt(
-                            glm::vec3(-5.f, 3.f, -10.f),
-                            glm::vec3(0.f, 0.f, 0.f),
-                            glm::vec3(0.f, -1.f, 0.f)) *
-                        glm::mat4(1.f);
-
-/**
- *  #version 400
- *  #extension GL_ARB_separate_shader_objects : enable
- *  #extension GL_ARB_shading_language_420pack : enable
- *  layout (std140, binding = 0) uniform bufferVals {
- *      mat4 mvp;
- *  } u_buffer_vals;
- *  layout (location = 0) in vec4 in_pos;
- *  layout (location = 1) in vec4 in_color;
- *  layout (location = 0) out vec4 out_color;
- *  void main() {
- *     out_color = in_color;
- *     gl_Position = u_buffer_vals.mvp * in_pos;
- *  }
- */
-const std::vector<uint8_t> c_vert_shader = {
-    0x03, 0x02, 0x23, 0x07, 0x00, 0x00, 0x01, 0x00, 0x06, 0x00, 0x08, 0x00,
-    0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x02, 0x00,
-    0x01, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00,
-    0x47, 0x4C, 0x53, 0x4C, 0x2E, 0x73, 0x74, 0x64, 0x2E, 0x34, 0x35, 0x30,
-    0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x01, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x04, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00,
-    0x09, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00,
-    0x1C, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x00,
-    0x90, 0x01, 0x00, 0x00, 0x04, 0x00, 0x09, 0x00, 0x47, 0x4C, 0x5F, 0x41,
-    0x52, 0x42, 0x5F, 0x73, 0x65, 0x70, 0x61, 0x72, 0x61, 0x74, 0x65, 0x5F,
-    0x73, 0x68, 0x61, 0x64, 0x65, 0x72, 0x5F, 0x6F, 0x62, 0x6A, 0x65, 0x63,
-    0x74, 0x73, 0x00, 0x00, 0x04, 0x00, 0x09, 0x00, 0x47, 0x4C, 0x5F, 0x41,
-    0x52, 0x42, 0x5F, 0x73, 0x68, 0x61, 0x64, 0x69, 0x6E, 0x67, 0x5F, 0x6C,
-    0x61, 0x6E, 0x67, 0x75, 0x61, 0x67, 0x65, 0x5F, 0x34, 0x32, 0x30, 0x70,
-    0x61, 0x63, 0x6B, 0x00, 0x05, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00,
-    0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00,
-    0x09, 0x00, 0x00, 0x00, 0x6F, 0x75, 0x74, 0x5F, 0x63, 0x6F, 0x6C, 0x6F,
-    0x72, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00, 0x0B, 0x00, 0x00, 0x00,
-    0x69, 0x6E, 0x5F, 0x63, 0x6F, 0x6C, 0x6F, 0x72, 0x00, 0x00, 0x00, 0x00,
-    0x05, 0x00, 0x06, 0x00, 0x10, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x50,
-    0x65, 0x72, 0x56, 0x65, 0x72, 0x74, 0x65, 0x78, 0x00, 0x00, 0x00, 0x00,
-    0x06, 0x00, 0x06, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x67, 0x6C, 0x5F, 0x50, 0x6F, 0x73, 0x69, 0x74, 0x69, 0x6F, 0x6E, 0x00,
-    0x06, 0x00, 0x07, 0x00, 0x10, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
-    0x67, 0x6C, 0x5F, 0x50, 0x6F, 0x69, 0x6E, 0x74, 0x53, 0x69, 0x7A, 0x65,
-    0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x07, 0x00, 0x10, 0x00, 0x00, 0x00,
-    0x02, 0x00, 0x00, 0x00, 0x67, 0x6C, 0x5F, 0x43, 0x6C, 0x69, 0x70, 0x44,
-    0x69, 0x73, 0x74, 0x61, 0x6E, 0x63, 0x65, 0x00, 0x05, 0x00, 0x03, 0x00,
-    0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00,
-    0x16, 0x00, 0x00, 0x00, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x56, 0x61,
-    0x6C, 0x73, 0x00, 0x00, 0x06, 0x00, 0x04, 0x00, 0x16, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x6D, 0x76, 0x70, 0x00, 0x05, 0x00, 0x06, 0x00,
-    0x18, 0x00, 0x00, 0x00, 0x75, 0x5F, 0x62, 0x75, 0x66, 0x66, 0x65, 0x72,
-    0x5F, 0x76, 0x61, 0x6C, 0x73, 0x00, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00,
-    0x1C, 0x00, 0x00, 0x00, 0x69, 0x6E, 0x5F, 0x70, 0x6F, 0x73, 0x00, 0x00,
-    0x47, 0x00, 0x04, 0x00, 0x09, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x0B, 0x00, 0x00, 0x00,
-    0x1E, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
-    0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00,
-    0x01, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
-    0x48, 0x00, 0x05, 0x00, 0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
-    0x0B, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00,
-    0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x48, 0x00, 0x04, 0x00,
-    0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
-    0x48, 0x00, 0x05, 0x00, 0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x00, 0x05, 0x00,
-    0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
-    0x10, 0x00, 0x00, 0x00, 0x47, 0x00, 0x03, 0x00, 0x16, 0x00, 0x00, 0x00,
-    0x02, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x18, 0x00, 0x00, 0x00,
-    0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
-    0x18, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x47, 0x00, 0x04, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x13, 0x00, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00,
-    0x21, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
-    0x16, 0x00, 0x03, 0x00, 0x06, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
-    0x17, 0x00, 0x04, 0x00, 0x07, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
-    0x04, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00,
-    0x03, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00,
-    0x08, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
-    0x20, 0x00, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
-    0x07, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00,
-    0x0B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x15, 0x00, 0x04, 0x00,
-    0x0D, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x2B, 0x00, 0x04, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
-    0x01, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x04, 0x00, 0x0F, 0x00, 0x00, 0x00,
-    0x06, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x05, 0x00,
-    0x10, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
-    0x0F, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0x11, 0x00, 0x00, 0x00,
-    0x03, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00,
-    0x11, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
-    0x15, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
-    0x01, 0x00, 0x00, 0x00, 0x2B, 0x00, 0x04, 0x00, 0x13, 0x00, 0x00, 0x00,
-    0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x04, 0x00,
-    0x15, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
-    0x1E, 0x00, 0x03, 0x00, 0x16, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00,
-    0x20, 0x00, 0x04, 0x00, 0x17, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
-    0x16, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x17, 0x00, 0x00, 0x00,
-    0x18, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
-    0x19, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00,
-    0x3B, 0x00, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00,
-    0x01, 0x00, 0x00, 0x00, 0x36, 0x00, 0x05, 0x00, 0x02, 0x00, 0x00, 0x00,
-    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
-    0xF8, 0x00, 0x02, 0x00, 0x05, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
-    0x07, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
-    0x3E, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00,
-    0x41, 0x00, 0x05, 0x00, 0x19, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x00,
-    0x18, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
-    0x15, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x00,
-    0x3D, 0x00, 0x04, 0x00, 0x07, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x00, 0x00,
-    0x1C, 0x00, 0x00, 0x00, 0x91, 0x00, 0x05, 0x00, 0x07, 0x00, 0x00, 0x00,
-    0x1E, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x00, 0x00,
-    0x41, 0x00, 0x05, 0x00, 0x08, 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00,
-    0x12, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x03, 0x00,
-    0x1F, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0xFD, 0x00, 0x01, 0x00,
-    0x38, 0x00, 0x01, 0x00,
-};
-
-/**
- *  #version 400
- *  #extension GL_ARB_separate_shader_objects : enable
- *  #extension GL_ARB_shading_language_420pack : enable
- *  layout (location = 0) in vec4 in_color;
- *  layout (location = 0) out vec4 out_color;
- *  void main() {
- *     out_color = in_color;
- *  }
- */
-const std::vector<uint8_t> c_frag_shader = {
-    0x03, 0x02, 0x23, 0x07, 0x00, 0x00, 0x01, 0x00, 0x06, 0x00, 0x08, 0x00,
-    0x0D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x02, 0x00,
-    0x01, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00,
-    0x47, 0x4C, 0x53, 0x4C, 0x2E, 0x73, 0x74, 0x64, 0x2E, 0x34, 0x35, 0x30,
-    0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x01, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x07, 0x00, 0x04, 0x00, 0x00, 0x00,
-    0x04, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00,
-    0x09, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x10, 0x00, 0x03, 0x00,
-    0x04, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00,
-    0x02, 0x00, 0x00, 0x00, 0x90, 0x01, 0x00, 0x00, 0x04, 0x00, 0x09, 0x00,
-    0x47, 0x4C, 0x5F, 0x41, 0x52, 0x42, 0x5F, 0x73, 0x65, 0x70, 0x61, 0x72,
-    0x61, 0x74, 0x65, 0x5F, 0x73, 0x68, 0x61, 0x64, 0x65, 0x72, 0x5F, 0x6F,
-    0x62, 0x6A, 0x65, 0x63, 0x74, 0x73, 0x00, 0x00, 0x04, 0x00, 0x09, 0x00,
-    0x47, 0x4C, 0x5F, 0x41, 0x52, 0x42, 0x5F, 0x73, 0x68, 0x61, 0x64, 0x69,
-    0x6E, 0x67, 0x5F, 0x6C, 0x61, 0x6E, 0x67, 0x75, 0x61, 0x67, 0x65, 0x5F,
-    0x34, 0x32, 0x30, 0x70, 0x61, 0x63, 0x6B, 0x00, 0x05, 0x00, 0x04, 0x00,
-    0x04, 0x00, 0x00, 0x00, 0x6D, 0x61, 0x69, 0x6E, 0x00, 0x00, 0x00, 0x00,
-    0x05, 0x00, 0x05, 0x00, 0x09, 0x00, 0x00, 0x00, 0x6F, 0x75, 0x74, 0x5F,
-    0x63, 0x6F, 0x6C, 0x6F, 0x72, 0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00,
-    0x0B, 0x00, 0x00, 0x00, 0x69, 0x6E, 0x5F, 0x63, 0x6F, 0x6C, 0x6F, 0x72,
-    0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00, 0x09, 0x00, 0x00, 0x00,
-    0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x04, 0x00,
-    0x0B, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x13, 0x00, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00, 0x21, 0x00, 0x03, 0x00,
-    0x03, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x16, 0x00, 0x03, 0x00,
-    0x06, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x17, 0x00, 0x04, 0x00,
-    0x07, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
-    0x20, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
-    0x07, 0x00, 0x00, 0x00, 0x3B, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00,
-    0x09, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00,
-    0x0A, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
-    0x3B, 0x00, 0x04, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
-    0x01, 0x00, 0x00, 0x00, 0x36, 0x00, 0x05, 0x00, 0x02, 0x00, 0x00, 0x00,
-    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
-    0xF8, 0x00, 0x02, 0x00, 0x05, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x04, 0x00,
-    0x07, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00,
-    0x3E, 0x00, 0x03, 0x00, 0x09, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00,
-    0xFD, 0x00, 0x01, 0x00, 0x38, 0x00, 0x01, 0x00,
-};
+const glm::mat4 c_view_projection =
+    c_clip * glm::perspective(glm::radians(45.f), 1.f, .1f, 100.f) *
+    glm::lookAt(
+        glm::vec3(-5.f, 3.f, -10.f),
+        glm::vec3(0.f, 0.f, 0.f),
+        glm::vec3(0.f, -1.f, 0.f));
 
 const float c_cube_vertices[][6] = {
     // red face
@@ -271,51 +176,654 @@ const float c_cube_vertices[][6] = {
 
 namespace {
 
-std::pair<bool, uint32_t> findMemoryTypeIndex(
-    const VkPhysicalDeviceMemoryProperties& physical_device_mem_props,
-    const VkMemoryRequirements& mem_reqs,
-    VkMemoryPropertyFlags prop_flags)
+/** How per-object MVPs reach the vertex shader. */
+enum class TransformPath
+{
+    PushConstant,
+    DynamicUniform,
+    StorageBuffer,
+    // One instanced draw, model matrices and colors come from a per-instance
+    // vertex stream and the view projection from a push constant.
+    Instanced,
+    // The instanced draw, culled by a compute pass that writes the visible
+    // instances and an indirect draw command.
+    GpuCulled,
+    // One instanced draw, the transforms are a storage buffer of a bindless
+    // heap that the vertex shader picks by a push constant index.
+    Bindless,
+};
+
+const char* toString(TransformPath path)
+{
+    switch (path)
+    {
+    case TransformPath::PushConstant:
+        return "push";
+    case TransformPath::DynamicUniform:
+        return "ubo";
+    case TransformPath::StorageBuffer:
+        return "ssbo";
+    case TransformPath::Instanced:
+        return "instanced";
+    case TransformPath::GpuCulled:
+        return "indirect";
+    case TransformPath::Bindless:
+        return "bindless";
+    }
+    return "unknown";
+}
+
+/** Per-instance vertex stream layout, bound at binding 1. */
+struct InstanceData
+{
+    glm::mat4 model;
+    // RGBA8, multiplied with the vertex color.
+    uint32_t color;
+};
+
+// The cull shader copies instances as c_instance_words plain words.
+static_assert(
+    sizeof(InstanceData) == 17 * sizeof(uint32_t),
+    "InstanceData must match the layout of the cull shader");
+
+struct Options
+{
+    uint32_t frames_in_flight = c_default_frames_in_flight;
+    uint32_t object_count = 1;
+    TransformPath transforms = TransformPath::PushConstant;
+    // Colors are packed to RGBA8 whenever positions are quantized.
+    PositionEncoding vertex_positions = PositionEncoding::Snorm16;
+    bool static_recording = false;
+    bool headless = false;
+    // 0 renders until the window is closed.
+    uint64_t frame_count = 0;
+    std::string dump_dir;
+    bool bench = false;
+    uint64_t bench_warmup_frames = c_default_bench_warmup_frames;
+    uint64_t bench_frames = c_default_bench_frames;
+    // Empty writes the report to stdout and everything else to stderr.
+    std::string bench_output;
+    bool gpu_profile = false;
+    // Culls objects on the CPU before the per-object draw loops.
+    bool cpu_cull = false;
+    CullIsa cull_isa = CpuCuller::bestIsa();
+    // 0 uses all hardware threads.
+    uint32_t threads = 0;
+    bool cull_bench = false;
+    // Compiles the GLSL files of this directory instead of using the
+    // embedded SPIR-V.
+    std::string shader_dir;
+    // Empty disables the SPIR-V disk cache.
+    std::string shader_cache_dir = c_default_shader_cache_dir;
+    // Rebuilds the pipelines when the files of shader_dir change.
+    bool hot_reload = false;
+    // Empty disables the persistent pipeline cache.
+    std::string pipeline_cache_path = c_default_pipeline_cache_path;
+    // Empty disables the persistent format database.
+    std::string format_db_path = c_default_format_db_path;
+};
+
+struct FrameResources
+{
+    VkCommandBuffer cmd_buffer = VK_NULL_HANDLE;
+    VkFence in_flight_fence = VK_NULL_HANDLE;
+    VkSemaphore image_acquired_semaphore = VK_NULL_HANDLE;
+};
+
+/**
+ * Headless replacement of a swapchain image: the color attachment and a
+ * persistently mapped buffer its contents are copied to at the end of a frame.
+ */
+struct OffscreenTarget
 {
-    uint32_t type_index = std::numeric_limits<uint32_t>::max();
-    uint32_t mem_type_bits = mem_reqs.memoryTypeBits;
+    VkImage image = VK_NULL_HANDLE;
+    MemoryAllocation image_mem;
+    VkBuffer readback_buf = VK_NULL_HANDLE;
+    MemoryAllocation readback_buf_mem;
+    const uint8_t* readback_data = nullptr;
+    // Set while a submitted frame copies into the buffer.
+    bool readback_pending = false;
+    uint64_t readback_frame_number = 0;
+};
 
-    for (uint32_t i = 0; i < physical_device_mem_props.memoryTypeCount; ++i)
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i)
     {
-        if ((mem_type_bits & 1) == 1 &&
-            (physical_device_mem_props.memoryTypes[i].propertyFlags &
-             prop_flags) == prop_flags)
+        const std::string arg = argv[i];
+        if (arg == "--frames-in-flight" && i + 1 < argc)
         {
-            type_index = i;
-            break;
+            options.frames_in_flight = static_cast<uint32_t>(
+                std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--objects" && i + 1 < argc)
+        {
+            options.object_count = static_cast<uint32_t>(
+                std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--transforms" && i + 1 < argc)
+        {
+            const std::string path = argv[++i];
+            if (path == toString(TransformPath::PushConstant))
+            {
+                options.transforms = TransformPath::PushConstant;
+            }
+            else if (path == toString(TransformPath::DynamicUniform))
+            {
+                options.transforms = TransformPath::DynamicUniform;
+            }
+            else if (path == toString(TransformPath::StorageBuffer))
+            {
+                options.transforms = TransformPath::StorageBuffer;
+            }
+            else if (path == toString(TransformPath::Instanced))
+            {
+                options.transforms = TransformPath::Instanced;
+            }
+            else if (path == toString(TransformPath::GpuCulled))
+            {
+                options.transforms = TransformPath::GpuCulled;
+            }
+            else if (path == toString(TransformPath::Bindless))
+            {
+                options.transforms = TransformPath::Bindless;
+            }
+            else
+            {
+                std::cerr << "Unknown transform path '" << path
+                          << "', expected push, ubo, ssbo, instanced, "
+                             "indirect or bindless."
+                          << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--static-recording")
+        {
+            options.static_recording = true;
+        }
+        else if (arg == "--headless")
+        {
+            options.headless = true;
+        }
+        else if (arg == "--frames" && i + 1 < argc)
+        {
+            options.frame_count = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--dump-frames" && i + 1 < argc)
+        {
+            options.dump_dir = argv[++i];
+        }
+        else if (arg == "--bench")
+        {
+            options.bench = true;
+        }
+        else if (arg == "--bench-warmup" && i + 1 < argc)
+        {
+            options.bench_warmup_frames = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--bench-frames" && i + 1 < argc)
+        {
+            options.bench_frames = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--bench-output" && i + 1 < argc)
+        {
+            options.bench_output = argv[++i];
+        }
+        else if (arg == "--gpu-profile")
+        {
+            options.gpu_profile = true;
+        }
+        else if (arg == "--cpu-cull")
+        {
+            options.cpu_cull = true;
+        }
+        else if (arg == "--cull-isa" && i + 1 < argc)
+        {
+            const std::string isa = argv[++i];
+            if (isa == toString(CullIsa::Scalar))
+            {
+                options.cull_isa = CullIsa::Scalar;
+            }
+            else if (isa == toString(CullIsa::Sse2))
+            {
+                options.cull_isa = CullIsa::Sse2;
+            }
+            else if (isa == toString(CullIsa::Avx2))
+            {
+                options.cull_isa = CullIsa::Avx2;
+            }
+            else
+            {
+                std::cerr << "Unknown culling ISA '" << isa
+                          << "', expected scalar, sse2 or avx2." << std::endl;
+                return false;
+            }
+            if (!CpuCuller::isaSupported(options.cull_isa))
+            {
+                std::cerr << "Culling ISA '" << isa
+                          << "' isn't supported by this CPU or build."
+                          << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            options.threads =
+                static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--cull-bench")
+        {
+            options.cull_bench = true;
+        }
+        else if (arg == "--shader-dir" && i + 1 < argc)
+        {
+            options.shader_dir = argv[++i];
+        }
+        else if (arg == "--shader-cache" && i + 1 < argc)
+        {
+            options.shader_cache_dir = argv[++i];
+        }
+        else if (arg == "--hot-reload")
+        {
+            options.hot_reload = true;
+        }
+        else if (arg == "--pipeline-cache" && i + 1 < argc)
+        {
+            options.pipeline_cache_path = argv[++i];
+        }
+        else if (arg == "--format-db" && i + 1 < argc)
+        {
+            options.format_db_path = argv[++i];
+        }
+        else if (arg == "--vertex-format" && i + 1 < argc)
+        {
+            const std::string format = argv[++i];
+            if (format == toString(PositionEncoding::Float32))
+            {
+                options.vertex_positions = PositionEncoding::Float32;
+            }
+            else if (format == toString(PositionEncoding::Snorm16))
+            {
+                options.vertex_positions = PositionEncoding::Snorm16;
+            }
+            else if (format == toString(PositionEncoding::Half))
+            {
+                options.vertex_positions = PositionEncoding::Half;
+            }
+            else
+            {
+                std::cerr << "Unknown vertex format '" << format
+                          << "', expected float, snorm16 or half."
+                          << std::endl;
+                return false;
+            }
+        }
+        else
+        {
+            std::cerr << "Unknown argument '" << arg << "'." << std::endl;
+            return false;
+        }
+    }
+
+    if (options.frames_in_flight == 0 ||
+        options.frames_in_flight > c_max_frames_in_flight)
+    {
+        std::cerr << "Frames in flight must be in range [1, "
+                  << c_max_frames_in_flight << "]." << std::endl;
+        return false;
+    }
+
+    const bool instanced = options.transforms == TransformPath::Instanced ||
+                           options.transforms == TransformPath::GpuCulled;
+    const uint32_t max_objects = instanced ? c_max_instances : c_max_objects;
+    if (options.object_count == 0 || options.object_count > max_objects)
+    {
+        std::cerr << "Objects must be in range [1, " << max_objects << "]."
+                  << std::endl;
+        return false;
+    }
+
+    if (options.cpu_cull && instanced)
+    {
+        std::cerr << "CPU culling applies to the per-object draw paths only."
+                  << std::endl;
+        return false;
+    }
+
+    if (options.hot_reload && options.shader_dir.empty())
+    {
+        std::cerr << "Hot reload needs --shader-dir." << std::endl;
+        return false;
+    }
+
+    if (options.bench)
+    {
+        if (options.bench_frames == 0)
+        {
+            std::cerr << "Benchmark needs at least one measured frame."
+                      << std::endl;
+            return false;
+        }
+        options.frame_count =
+            options.bench_warmup_frames + options.bench_frames;
+    }
+    else if (options.headless && options.frame_count == 0)
+    {
+        options.frame_count = c_default_headless_frames;
+    }
+
+    return true;
+}
+
+/**
+ * Model matrices of a cubic grid of cubes that fills the space of the single
+ * cube, a single object keeps the original unit cube.
+ */
+std::vector<glm::mat4> makeObjectTransforms(uint32_t object_count)
+{
+    if (object_count == 1)
+    {
+        return {glm::mat4(1.f)};
+    }
+
+    const auto side = static_cast<uint32_t>(
+        std::ceil(std::cbrt(static_cast<double>(object_count))));
+    const float cell = 2.f / static_cast<float>(side);
+
+    std::vector<glm::mat4> transforms;
+    transforms.reserve(object_count);
+    for (uint32_t i = 0; i < object_count; ++i)
+    {
+        const glm::vec3 position(
+            -1.f + (static_cast<float>(i % side) + .5f) * cell,
+            -1.f + (static_cast<float>(i / side % side) + .5f) * cell,
+            -1.f + (static_cast<float>(i / side / side) + .5f) * cell);
+        transforms.push_back(glm::scale(
+            glm::translate(glm::mat4(1.f), position), glm::vec3(.35f * cell)));
+    }
+    return transforms;
+}
+
+/** World space boxes of unit cubes placed by the transforms. */
+BoundingVolumes makeBoundingVolumes(const std::vector<glm::mat4>& transforms)
+{
+    BoundingVolumes volumes;
+    volumes.reserve(transforms.size());
+    for (const glm::mat4& transform : transforms)
+    {
+        const glm::vec3 extent =
+            glm::abs(glm::vec3(transform[0])) +
+            glm::abs(glm::vec3(transform[1])) +
+            glm::abs(glm::vec3(transform[2]));
+        volumes.add(glm::vec3(transform[3]), extent);
+    }
+    return volumes;
+}
+
+/**
+ * Times every supported culling kernel on boxes scattered around the
+ * camera, so that only part of them is visible, and prints the throughput.
+ */
+int runCullBenchmark(const Options& options)
+{
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> position(-20.f, 20.f);
+    std::uniform_real_distribution<float> size(.05f, .5f);
+    BoundingVolumes volumes;
+    volumes.reserve(c_cull_bench_objects);
+    for (uint32_t i = 0; i < c_cull_bench_objects; ++i)
+    {
+        volumes.add(
+            glm::vec3(position(random), position(random), position(random)),
+            glm::vec3(size(random), size(random), size(random)));
+    }
+
+    const Frustum frustum = makeFrustum(c_view_projection);
+    ThreadPool thread_pool(options.threads);
+    CpuCuller culler(thread_pool);
+    std::vector<uint32_t> visible;
+
+    std::cout << "Culling " << volumes.size() << " objects on "
+              << thread_pool.size() << " threads, " << c_cull_bench_passes
+              << " passes" << std::endl;
+    for (CullVolume volume : {CullVolume::Sphere, CullVolume::Box})
+    {
+        for (CullIsa isa : {CullIsa::Scalar, CullIsa::Sse2, CullIsa::Avx2})
+        {
+            if (!CpuCuller::isaSupported(isa))
+            {
+                continue;
+            }
+
+            // One untimed pass warms up the caches and the output buffers.
+            culler.cull(frustum, volumes, volume, isa, visible);
+            const auto start = std::chrono::steady_clock::now();
+            for (uint32_t pass = 0; pass < c_cull_bench_passes; ++pass)
+            {
+                culler.cull(frustum, volumes, volume, isa, visible);
+            }
+            const std::chrono::duration<double, std::nano> elapsed =
+                std::chrono::steady_clock::now() - start;
+            const double pass_ns = elapsed.count() / c_cull_bench_passes;
+
+            std::cout << "  " << toString(volume) << " " << toString(isa)
+                      << ": " << volumes.size() / pass_ns
+                      << " objects/ns, " << pass_ns / 1e6 << " ms/pass, "
+                      << visible.size() << " visible" << std::endl;
         }
-        mem_type_bits >>= 1;
     }
+    return EXIT_SUCCESS;
+}
+
+/** Indexed cube mesh ready for upload. */
+struct IndexedMesh
+{
+    std::vector<uint8_t> vertices;
+    std::size_t vertex_size = 0;
+    std::vector<uint32_t> indices;
+    VertexCacheStats source_stats;
+    VertexCacheStats optimized_stats;
+};
+
+VertexFormat makeVertexFormat(PositionEncoding positions)
+{
+    VertexFormat format;
+    format.position = positions;
+    format.color = positions == PositionEncoding::Float32
+                       ? ColorEncoding::Float32
+                       : ColorEncoding::Unorm8;
+    return format;
+}
+
+/**
+ * Encodes the expanded cube vertices into the format, welds them and
+ * optimizes the index order for the post-transform cache and the vertices
+ * for fetch locality. Welding runs on the encoded bytes, so vertices that
+ * quantize to the same value are merged as well.
+ */
+IndexedMesh makeCubeMesh(const VertexFormat& format)
+{
+    const std::size_t vertex_count =
+        sizeof(c_cube_vertices) / sizeof(c_cube_vertices[0]);
+
+    VertexStreams streams;
+    streams.count = vertex_count;
+    streams.stride = sizeof(c_cube_vertices[0]) / sizeof(float);
+    streams.positions = &c_cube_vertices[0][0];
+    streams.colors = &c_cube_vertices[0][3];
+    std::vector<uint8_t> encoded(vertex_count * format.stride());
+    encodeVertices(format, streams, encoded.data());
+
+    IndexedMesh mesh;
+    mesh.vertex_size = format.stride();
+    generateIndexBuffer(
+        encoded.data(),
+        vertex_count,
+        mesh.vertex_size,
+        mesh.vertices,
+        mesh.indices);
+
+    // A non-indexed draw transforms every vertex it submits.
+    mesh.source_stats.triangles = static_cast<uint32_t>(vertex_count / 3);
+    mesh.source_stats.vertices = static_cast<uint32_t>(vertex_count);
+    mesh.source_stats.misses = static_cast<uint32_t>(vertex_count);
+    mesh.source_stats.acmr = 3.0;
+    mesh.source_stats.atvr = 1.0;
+
+    std::size_t unique_count = mesh.vertices.size() / mesh.vertex_size;
+    optimizeVertexCache(mesh.indices, unique_count);
+    unique_count =
+        optimizeVertexFetch(mesh.indices, mesh.vertices, mesh.vertex_size);
+    mesh.optimized_stats = analyzeVertexCache(mesh.indices, unique_count);
+    return mesh;
+}
 
-    return {
-        type_index != std::numeric_limits<uint32_t>::max(),
-        type_index,
+void printMeshStats(const IndexedMesh& mesh, std::ostream& out)
+{
+    const VertexCacheStats& from = mesh.source_stats;
+    const VertexCacheStats& to = mesh.optimized_stats;
+    out << "Mesh: " << to.triangles << " triangles, " << from.vertices
+        << " -> " << to.vertices << " vertices, " << mesh.indices.size()
+        << " indices (" << (fitsShortIndices(to.vertices) ? 16 : 32)
+        << " bit)" << std::endl;
+    out << "  vertex shader runs " << from.misses << " -> " << to.misses
+        << ", ACMR " << from.acmr << " -> " << to.acmr << ", ATVR "
+        << from.atvr << " -> " << to.atvr << " (FIFO "
+        << c_default_vertex_cache_size << ")" << std::endl;
+}
+
+/** Colors the instances with a gradient over their grid position. */
+std::vector<InstanceData> makeInstances(
+    const std::vector<glm::mat4>& transforms)
+{
+    auto to_unorm8 = [](float value) {
+        return static_cast<uint32_t>(std::clamp(value, 0.f, 1.f) * 255.f + .5f);
     };
+
+    std::vector<InstanceData> instances(transforms.size());
+    for (std::size_t i = 0; i < transforms.size(); ++i)
+    {
+        // The translation column holds the cell center in [-1, 1].
+        const glm::vec4& position = transforms[i][3];
+        instances[i].model = transforms[i];
+        instances[i].color = to_unorm8(.5f + .5f * position.x) |
+                             to_unorm8(.5f + .5f * position.y) << 8 |
+                             to_unorm8(.5f + .5f * position.z) << 16 |
+                             255u << 24;
+    }
+    return instances;
+}
+
+bool isInstanceLayerAvailable(const char* layer_name)
+{
+    uint32_t layers_num = 0;
+    if (vkEnumerateInstanceLayerProperties(&layers_num, nullptr) != VK_SUCCESS)
+    {
+        return false;
+    }
+    std::vector<VkLayerProperties> layers(layers_num);
+    if (vkEnumerateInstanceLayerProperties(&layers_num, layers.data()) !=
+        VK_SUCCESS)
+    {
+        return false;
+    }
+
+    return std::any_of(
+        layers.begin(), layers.end(), [layer_name](const auto& layer) {
+            return std::strcmp(layer.layerName, layer_name) == 0;
+        });
+}
+
+bool isInstanceExtensionAvailable(const char* extension_name)
+{
+    uint32_t extensions_num = 0;
+    if (vkEnumerateInstanceExtensionProperties(
+            nullptr, &extensions_num, nullptr) != VK_SUCCESS)
+    {
+        return false;
+    }
+    std::vector<VkExtensionProperties> extensions(extensions_num);
+    if (vkEnumerateInstanceExtensionProperties(
+            nullptr, &extensions_num, extensions.data()) != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    return std::any_of(
+        extensions.begin(),
+        extensions.end(),
+        [extension_name](const auto& extension) {
+            return std::strcmp(extension.extensionName, extension_name) == 0;
+        });
+}
+
+bool isDeviceExtensionAvailable(
+    VkPhysicalDevice physical_device, const char* extension_name)
+{
+    uint32_t extensions_num = 0;
+    if (vkEnumerateDeviceExtensionProperties(
+            physical_device, nullptr, &extensions_num, nullptr) != VK_SUCCESS)
+    {
+        return false;
+    }
+    std::vector<VkExtensionProperties> extensions(extensions_num);
+    if (vkEnumerateDeviceExtensionProperties(
+            physical_device, nullptr, &extensions_num, extensions.data()) !=
+        VK_SUCCESS)
+    {
+        return false;
+    }
+
+    return std::any_of(
+        extensions.begin(),
+        extensions.end(),
+        [extension_name](const auto& extension) {
+            return std::strcmp(extension.extensionName, extension_name) == 0;
+        });
 }
 
 } // namespace
 
 int main(int argc, char** argv)
 {
-    glfwSetErrorCallback([](int err, const char* msg) {
-        std::cerr << "[GLFW](" << std::hex << err << ") " << msg << std::endl;
-    });
-
-    if (GLFW_TRUE != glfwInit())
+    Options options;
+    if (!parseOptions(argc, argv, options))
     {
-        std::cerr << "Failed to init GLFW." << std::endl;
         return EXIT_FAILURE;
     }
 
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-    glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+    // The culling microbenchmark needs neither a window nor a device.
+    if (options.cull_bench)
+    {
+        return runCullBenchmark(options);
+    }
+
+    // A benchmark report on stdout is only parseable with nothing else there.
+    std::ostream& diagnostics =
+        options.bench && options.bench_output.empty() ? std::cerr : std::cout;
 
-    GLFWwindow* window =
-        glfwCreateWindow(c_width, c_height, "Vulkan", nullptr, nullptr);
+    // Headless mode renders into offscreen images and needs neither a window
+    // nor a display server.
+    GLFWwindow* window = nullptr;
+    if (!options.headless)
+    {
+        glfwSetErrorCallback([](int err, const char* msg) {
+            std::cerr << "[GLFW](" << std::hex << err << ") " << msg
+                      << std::endl;
+        });
+
+        if (GLFW_TRUE != glfwInit())
+        {
+            std::cerr << "Failed to init GLFW." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+
+        window =
+            glfwCreateWindow(c_width, c_height, "Vulkan", nullptr, nullptr);
+    }
 
     VkApplicationInfo app_info = {};
     app_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
@@ -323,20 +831,34 @@ int main(int argc, char** argv)
     app_info.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
     app_info.pEngineName = "no engine";
     app_info.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-    app_info.apiVersion = VK_API_VERSION_1_0;
+    // Descriptor indexing is core since 1.2, which the bindless path uses
+    // instead of the extension.
+    const bool bindless = options.transforms == TransformPath::Bindless;
+    app_info.apiVersion = bindless ? VK_API_VERSION_1_2 : VK_API_VERSION_1_0;
 
-    uint32_t glfw_extensions_num = 0;
-    const char** glfw_extensions =
-        glfwGetRequiredInstanceExtensions(&glfw_extensions_num);
+    std::vector<const char*> extensions;
+    if (!options.headless)
+    {
+        uint32_t glfw_extensions_num = 0;
+        const char** glfw_extensions =
+            glfwGetRequiredInstanceExtensions(&glfw_extensions_num);
 
-    std::vector<const char*> extensions(
-        glfw_extensions, glfw_extensions + glfw_extensions_num);
+        extensions.assign(
+            glfw_extensions, glfw_extensions + glfw_extensions_num);
+    }
 
-    extensions.push_back(VK_EXT_DEBUG_REPORT_EXTENSION_NAME);
+    // Render nodes usually have no SDK installed, so validation is only
+    // enabled where it is available.
+    if (isInstanceExtensionAvailable(VK_EXT_DEBUG_REPORT_EXTENSION_NAME))
+    {
+        extensions.push_back(VK_EXT_DEBUG_REPORT_EXTENSION_NAME);
+    }
 
-    const std::vector<const char*> validation_layers = {
-        "VK_LAYER_LUNARG_standard_validation",
-    };
+    std::vector<const char*> validation_layers;
+    if (isInstanceLayerAvailable("VK_LAYER_LUNARG_standard_validation"))
+    {
+        validation_layers.push_back("VK_LAYER_LUNARG_standard_validation");
+    }
 
     VkInstanceCreateInfo instance_info = {};
     instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -351,10 +873,13 @@ int main(int argc, char** argv)
     FAIL_IF_NOT_SUCCESS(
         vkCreateInstance(&instance_info, nullptr, &instance), "CreateInstance");
 
-    VkSurfaceKHR surface = {};
-    FAIL_IF_NOT_SUCCESS(
-        glfwCreateWindowSurface(instance, window, nullptr, &surface),
-        "CreateWindowSurface");
+    VkSurfaceKHR surface = VK_NULL_HANDLE;
+    if (!options.headless)
+    {
+        FAIL_IF_NOT_SUCCESS(
+            glfwCreateWindowSurface(instance, window, nullptr, &surface),
+            "CreateWindowSurface");
+    }
 
     uint32_t physical_devices_num;
     FAIL_IF_NOT_SUCCESS(
@@ -366,17 +891,37 @@ int main(int argc, char** argv)
             instance, &physical_devices_num, physical_devices.data()),
         "EnumeratePhysicalDevices");
 
+    // Integrated GPUs are preferred, but any device will do so that CPU
+    // implementations like lavapipe work on machines without a GPU.
+    auto device_type_rank = [](VkPhysicalDeviceType type) {
+        switch (type)
+        {
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+            return 0;
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+            return 1;
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+            return 2;
+        case VK_PHYSICAL_DEVICE_TYPE_CPU:
+            return 3;
+        default:
+            return 4;
+        }
+    };
+
     uint32_t physical_device_index = std::numeric_limits<uint32_t>::max();
+    int best_device_rank = std::numeric_limits<int>::max();
     for (std::size_t i = 0; i < physical_devices.size(); ++i)
     {
         VkPhysicalDeviceProperties properties = {};
         VkPhysicalDeviceFeatures features = {};
         vkGetPhysicalDeviceProperties(physical_devices[i], &properties);
         vkGetPhysicalDeviceFeatures(physical_devices[i], &features);
-        if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU)
+        const int rank = device_type_rank(properties.deviceType);
+        if (rank < best_device_rank)
         {
             physical_device_index = static_cast<uint32_t>(i);
-            break;
+            best_device_rank = rank;
         }
     }
     if (physical_device_index == std::numeric_limits<uint32_t>::max())
@@ -387,6 +932,12 @@ int main(int argc, char** argv)
 
     VkPhysicalDevice& physical_device = physical_devices[physical_device_index];
 
+    VkPhysicalDeviceProperties physical_device_props = {};
+    vkGetPhysicalDeviceProperties(physical_device, &physical_device_props);
+
+    VkPhysicalDeviceFeatures physical_device_features = {};
+    vkGetPhysicalDeviceFeatures(physical_device, &physical_device_features);
+
     VkPhysicalDeviceMemoryProperties physical_device_mem_prop = {};
     vkGetPhysicalDeviceMemoryProperties(physical_device, &physical_device_mem_prop);
 
@@ -401,9 +952,14 @@ int main(int argc, char** argv)
     uint32_t present_queue_family_index = std::numeric_limits<uint32_t>::max();
     for (std::size_t i = 0; i < queue_families.size(); ++i)
     {
-        VkBool32 present_support = VK_FALSE;
-        vkGetPhysicalDeviceSurfaceSupportKHR(
-            physical_device, i, surface, &present_support);
+        // Nothing is presented in headless mode, the graphics queue takes
+        // the place of the present queue.
+        VkBool32 present_support = VK_TRUE;
+        if (!options.headless)
+        {
+            vkGetPhysicalDeviceSurfaceSupportKHR(
+                physical_device, i, surface, &present_support);
+        }
 
         if (queue_families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
         {
@@ -433,13 +989,34 @@ int main(int argc, char** argv)
         return EXIT_FAILURE;
     }
 
+    // GPU culling dispatches on the graphics queue.
+    if (options.transforms == TransformPath::GpuCulled &&
+        !(queue_families[graphics_queue_family_index].queueFlags &
+          VK_QUEUE_COMPUTE_BIT))
+    {
+        std::cerr << "Graphics queue doesn't support compute, GPU culling "
+                     "is not available."
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
     if (present_queue_family_index == std::numeric_limits<uint32_t>::max())
     {
         std::cerr << "Suitable present queue family not found." << std::endl;
         return EXIT_FAILURE;
     }
 
-    std::vector<VkDeviceQueueCreateInfo> queue_infos;
+    BindlessSupport bindless_support;
+    std::string bindless_error;
+    if (bindless && !queryBindlessSupport(
+                        physical_device, bindless_support, bindless_error))
+    {
+        std::cerr << "Bindless transforms are not available, the device lacks "
+                  << bindless_error << "." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<VkDeviceQueueCreateInfo> queue_infos;
     std::set<uint32_t> unique_queue_family_indices = {
         graphics_queue_family_index,
         present_queue_family_index,
@@ -458,10 +1035,29 @@ int main(int argc, char** argv)
     }
 
     std::vector<const char*> device_extensions;
-    device_extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    if (!options.headless)
+    {
+        device_extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    }
+    // Lets a full descriptor pool report VK_ERROR_OUT_OF_POOL_MEMORY on 1.0
+    // devices, the descriptor allocator counts what's left in its pools too.
+    if (isDeviceExtensionAvailable(
+            physical_device, VK_KHR_MAINTENANCE1_EXTENSION_NAME))
+    {
+        device_extensions.push_back(VK_KHR_MAINTENANCE1_EXTENSION_NAME);
+    }
 
     VkPhysicalDeviceFeatures device_features = {};
     device_features.depthClamp = VK_TRUE;
+    const bool pipeline_statistics =
+        options.gpu_profile && physical_device_features.pipelineStatisticsQuery;
+    device_features.pipelineStatisticsQuery =
+        pipeline_statistics ? VK_TRUE : VK_FALSE;
+    if (bindless)
+    {
+        device_features.shaderStorageBufferArrayDynamicIndexing = VK_TRUE;
+        device_features.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+    }
 
     VkDeviceCreateInfo device_info = {};
     device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -471,6 +1067,10 @@ int main(int argc, char** argv)
         static_cast<uint32_t>(device_extensions.size());
     device_info.ppEnabledExtensionNames = device_extensions.data();
     device_info.pEnabledFeatures = &device_features;
+    if (bindless)
+    {
+        device_info.pNext = &bindless_support.features;
+    }
 
     VkDevice device = {};
     FAIL_IF_NOT_SUCCESS(
@@ -483,6 +1083,15 @@ int main(int argc, char** argv)
     VkQueue graphic_queue = {};
     vkGetDeviceQueue(device, graphics_queue_family_index, 0, &graphic_queue);
 
+    MemoryAllocator memory_allocator(
+        device, physical_device_mem_prop, physical_device_props.limits);
+
+    // Uploads go through the graphics queue, so queue submission order makes
+    // them visible to rendering without ownership transfers.
+    StagingUploader staging_uploader(
+        device, graphic_queue, graphics_queue_family_index, memory_allocator);
+    FAIL_IF_NOT_SUCCESS(staging_uploader.create(), "CreateStagingUploader");
+
     VkCommandPoolCreateInfo cmd_pool_info = {};
     cmd_pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
     cmd_pool_info.queueFamilyIndex = graphics_queue_family_index;
@@ -497,149 +1106,264 @@ int main(int argc, char** argv)
     cmd_buffer_alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     cmd_buffer_alloc_info.commandPool = cmd_pool;
     cmd_buffer_alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    cmd_buffer_alloc_info.commandBufferCount = 1;
+    cmd_buffer_alloc_info.commandBufferCount = options.frames_in_flight;
 
-    VkCommandBuffer cmd_buffer = {};
+    std::vector<VkCommandBuffer> cmd_buffers(options.frames_in_flight);
     FAIL_IF_NOT_SUCCESS(
-        vkAllocateCommandBuffers(device, &cmd_buffer_alloc_info, &cmd_buffer),
+        vkAllocateCommandBuffers(
+            device, &cmd_buffer_alloc_info, cmd_buffers.data()),
         "AllocateCommandBuffers");
 
-    VkSurfaceCapabilitiesKHR surface_capabilities = {};
-    FAIL_IF_NOT_SUCCESS(
-        vkGetPhysicalDeviceSurfaceCapabilitiesKHR(
-            physical_device, surface, &surface_capabilities),
-        "GetPhysicalDeviceSurfaceCapabilities");
+    VkSemaphoreCreateInfo semaphore_info = {};
+    semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-    uint32_t surface_format_num;
-    FAIL_IF_NOT_SUCCESS(
-        vkGetPhysicalDeviceSurfaceFormatsKHR(
-            physical_device, surface, &surface_format_num, nullptr),
-        "GetPhysicalDeviceSurfaceFormats");
-    std::vector<VkSurfaceFormatKHR> surface_formats(surface_format_num);
-    FAIL_IF_NOT_SUCCESS(
-        vkGetPhysicalDeviceSurfaceFormatsKHR(
-            physical_device, surface, &surface_format_num, surface_formats.data()),
-        "GetPhysicalDeviceSurfaceFormats");
+    // Fences start signaled so the first wait on every ring slot falls through.
+    VkFenceCreateInfo fence_info = {};
+    fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fence_info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-    if (surface_formats.empty())
+    std::vector<FrameResources> frames(options.frames_in_flight);
+    for (std::size_t i = 0; i < frames.size(); ++i)
     {
-        std::cerr << "Suitable surface format not found." << std::endl;
-        return EXIT_FAILURE;
+        frames[i].cmd_buffer = cmd_buffers[i];
+        FAIL_IF_NOT_SUCCESS(
+            vkCreateFence(
+                device, &fence_info, nullptr, &frames[i].in_flight_fence),
+            "CreateFence");
+        FAIL_IF_NOT_SUCCESS(
+            vkCreateSemaphore(
+                device,
+                &semaphore_info,
+                nullptr,
+                &frames[i].image_acquired_semaphore),
+            "CreateSemaphore");
     }
 
-    VkSurfaceFormatKHR surface_format = [&surface_formats]() {
-        if (surface_formats.size() == 1 &&
-            surface_formats.front().format == VK_FORMAT_UNDEFINED)
+    // Swapchain images in windowed mode, offscreen images in headless mode.
+    VkFormat color_format = VK_FORMAT_UNDEFINED;
+    std::vector<VkImage> color_images;
+
+    VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+    std::vector<OffscreenTarget> offscreen_targets;
+
+    if (!options.headless)
+    {
+        VkSurfaceCapabilitiesKHR surface_capabilities = {};
+        FAIL_IF_NOT_SUCCESS(
+            vkGetPhysicalDeviceSurfaceCapabilitiesKHR(
+                physical_device, surface, &surface_capabilities),
+            "GetPhysicalDeviceSurfaceCapabilities");
+
+        uint32_t surface_format_num;
+        FAIL_IF_NOT_SUCCESS(
+            vkGetPhysicalDeviceSurfaceFormatsKHR(
+                physical_device, surface, &surface_format_num, nullptr),
+            "GetPhysicalDeviceSurfaceFormats");
+        std::vector<VkSurfaceFormatKHR> surface_formats(surface_format_num);
+        FAIL_IF_NOT_SUCCESS(
+            vkGetPhysicalDeviceSurfaceFormatsKHR(
+                physical_device, surface, &surface_format_num, surface_formats.data()),
+            "GetPhysicalDeviceSurfaceFormats");
+
+        if (surface_formats.empty())
         {
-            return VkSurfaceFormatKHR{VK_FORMAT_B8G8R8A8_UNORM,
-                                      VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
+            std::cerr << "Suitable surface format not found." << std::endl;
+            return EXIT_FAILURE;
         }
-        for (const auto& format : surface_formats)
-        {
-            if (format.format == VK_FORMAT_B8G8R8A8_UNORM &&
-                format.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR)
+
+        VkSurfaceFormatKHR surface_format = [&surface_formats]() {
+            if (surface_formats.size() == 1 &&
+                surface_formats.front().format == VK_FORMAT_UNDEFINED)
             {
-                return format;
+                return VkSurfaceFormatKHR{VK_FORMAT_B8G8R8A8_UNORM,
+                                          VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
             }
-        }
-        return surface_formats.front();
+            for (const auto& format : surface_formats)
+            {
+                if (format.format == VK_FORMAT_B8G8R8A8_UNORM &&
+                    format.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR)
+                {
+                    return format;
+                }
+            }
+            return surface_formats.front();
 
-    }();
+        }();
 
-    uint32_t present_mode_num;
-    FAIL_IF_NOT_SUCCESS(
-        vkGetPhysicalDeviceSurfacePresentModesKHR(
-            physical_device, surface, &present_mode_num, nullptr),
-        "GetPhysicalDeviceSurfacePresentModes");
-    std::vector<VkPresentModeKHR> present_modes(present_mode_num);
-    FAIL_IF_NOT_SUCCESS(
-        vkGetPhysicalDeviceSurfacePresentModesKHR(
-            physical_device, surface, &present_mode_num, present_modes.data()),
-        "GetPhysicalDeviceSurfacePresentModes");
+        uint32_t present_mode_num;
+        FAIL_IF_NOT_SUCCESS(
+            vkGetPhysicalDeviceSurfacePresentModesKHR(
+                physical_device, surface, &present_mode_num, nullptr),
+            "GetPhysicalDeviceSurfacePresentModes");
+        std::vector<VkPresentModeKHR> present_modes(present_mode_num);
+        FAIL_IF_NOT_SUCCESS(
+            vkGetPhysicalDeviceSurfacePresentModesKHR(
+                physical_device, surface, &present_mode_num, present_modes.data()),
+            "GetPhysicalDeviceSurfacePresentModes");
 
-    VkPresentModeKHR present_mode = [&present_modes]() {
-        VkPresentModeKHR best_mode = VK_PRESENT_MODE_FIFO_KHR;
-        for (const auto& mode : present_modes)
-        {
-            if (mode == VK_PRESENT_MODE_MAILBOX_KHR)
+        VkPresentModeKHR present_mode = [&present_modes]() {
+            VkPresentModeKHR best_mode = VK_PRESENT_MODE_FIFO_KHR;
+            for (const auto& mode : present_modes)
             {
-                return mode;
+                if (mode == VK_PRESENT_MODE_MAILBOX_KHR)
+                {
+                    return mode;
+                }
+                else if (mode == VK_PRESENT_MODE_IMMEDIATE_KHR)
+                {
+                    best_mode = mode;
+                }
             }
-            else if (mode == VK_PRESENT_MODE_IMMEDIATE_KHR)
+            return best_mode;
+        }();
+
+        VkExtent2D extent = [&surface_capabilities]() {
+            if (surface_capabilities.currentExtent.width !=
+                std::numeric_limits<uint32_t>::max())
             {
-                best_mode = mode;
+                return surface_capabilities.currentExtent;
             }
+            VkExtent2D actual_extent = {};
+            actual_extent.width = std::clamp(
+                c_width,
+                surface_capabilities.minImageExtent.width,
+                surface_capabilities.maxImageExtent.width);
+            actual_extent.height = std::clamp(
+                c_height,
+                surface_capabilities.minImageExtent.height,
+                surface_capabilities.maxImageExtent.height);
+            return actual_extent;
+        }();
+
+        VkSwapchainCreateInfoKHR swapchain_info = {};
+        swapchain_info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+        swapchain_info.surface = surface;
+        swapchain_info.minImageCount = surface_capabilities.minImageCount;
+        swapchain_info.imageFormat = surface_format.format;
+        swapchain_info.imageColorSpace = surface_format.colorSpace;
+        swapchain_info.imageExtent = extent;
+        swapchain_info.imageArrayLayers = 1;
+        swapchain_info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        swapchain_info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (graphics_queue_family_index != present_queue_family_index)
+        {
+            uint32_t queue_family_indices[] = {
+                graphics_queue_family_index,
+                present_queue_family_index,
+            };
+            swapchain_info.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
+            swapchain_info.queueFamilyIndexCount = 2;
+            swapchain_info.pQueueFamilyIndices = queue_family_indices;
+        }
+        swapchain_info.preTransform = surface_capabilities.currentTransform;
+        swapchain_info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+        swapchain_info.presentMode = present_mode;
+        swapchain_info.clipped = VK_TRUE;
+        swapchain_info.oldSwapchain = VK_NULL_HANDLE;
+
+        FAIL_IF_NOT_SUCCESS(
+            vkCreateSwapchainKHR(device, &swapchain_info, nullptr, &swapchain),
+            "CreateSwapChain");
+
+        uint32_t swapchain_image_num;
+        FAIL_IF_NOT_SUCCESS(
+            vkGetSwapchainImagesKHR(device, swapchain, &swapchain_image_num, nullptr),
+            "GetSwapchainImages");
+        color_images.resize(swapchain_image_num);
+        FAIL_IF_NOT_SUCCESS(
+            vkGetSwapchainImagesKHR(
+                device, swapchain, &swapchain_image_num, color_images.data()),
+            "GetSwapchainImages");
+
+        color_format = surface_format.format;
+    }
+    else
+    {
+        // One offscreen target per ring slot, so a slot's readback buffer is
+        // never overwritten before its fence has been waited on.
+        color_format = VK_FORMAT_R8G8B8A8_UNORM;
+        offscreen_targets.resize(options.frames_in_flight);
+        for (auto& target : offscreen_targets)
+        {
+            VkImageCreateInfo color_image_info = {};
+            color_image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            color_image_info.imageType = VK_IMAGE_TYPE_2D;
+            color_image_info.format = color_format;
+            color_image_info.extent.width = c_width;
+            color_image_info.extent.height = c_height;
+            color_image_info.extent.depth = 1;
+            color_image_info.mipLevels = 1;
+            color_image_info.arrayLayers = 1;
+            color_image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+            color_image_info.samples = VK_SAMPLE_COUNT_1_BIT;
+            color_image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            color_image_info.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                                     VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+            color_image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+            FAIL_IF_NOT_SUCCESS(
+                vkCreateImage(device, &color_image_info, nullptr, &target.image),
+                "CreateImage");
+
+            FAIL_IF_NOT_SUCCESS(
+                memory_allocator.allocateImage(
+                    target.image,
+                    color_image_info.tiling,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                    0,
+                    target.image_mem),
+                "AllocateMemory");
+
+            VkBufferCreateInfo readback_buf_info = {};
+            readback_buf_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            readback_buf_info.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            readback_buf_info.size = c_width * c_height * 4;
+            readback_buf_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+            FAIL_IF_NOT_SUCCESS(
+                vkCreateBuffer(
+                    device, &readback_buf_info, nullptr, &target.readback_buf),
+                "CreateBuffer");
+
+            // CPU reads are much faster from cached memory.
+            FAIL_IF_NOT_SUCCESS(
+                memory_allocator.allocateBuffer(
+                    target.readback_buf,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                    VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+                    target.readback_buf_mem),
+                "AllocateMemory");
+            target.readback_data = target.readback_buf_mem.mapped;
+
+            color_images.push_back(target.image);
         }
-        return best_mode;
-    }();
-
-    VkExtent2D extent = [&surface_capabilities]() {
-        if (surface_capabilities.currentExtent.width !=
-            std::numeric_limits<uint32_t>::max())
-        {
-            return surface_capabilities.currentExtent;
-        }
-        VkExtent2D actual_extent = {};
-        actual_extent.width = std::clamp(
-            c_width,
-            surface_capabilities.minImageExtent.width,
-            surface_capabilities.maxImageExtent.width);
-        actual_extent.height = std::clamp(
-            c_height,
-            surface_capabilities.minImageExtent.height,
-            surface_capabilities.maxImageExtent.height);
-        return actual_extent;
-    }();
-
-    VkSwapchainCreateInfoKHR swapchain_info = {};
-    swapchain_info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-    swapchain_info.surface = surface;
-    swapchain_info.minImageCount = surface_capabilities.minImageCount;
-    swapchain_info.imageFormat = surface_format.format;
-    swapchain_info.imageColorSpace = surface_format.colorSpace;
-    swapchain_info.imageExtent = extent;
-    swapchain_info.imageArrayLayers = 1;
-    swapchain_info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-    swapchain_info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    if (graphics_queue_family_index != present_queue_family_index)
-    {
-        uint32_t queue_family_indices[] = {
-            graphics_queue_family_index,
-            present_queue_family_index,
-        };
-        swapchain_info.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
-        swapchain_info.queueFamilyIndexCount = 2;
-        swapchain_info.pQueueFamilyIndices = queue_family_indices;
     }
-    swapchain_info.preTransform = surface_capabilities.currentTransform;
-    swapchain_info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-    swapchain_info.presentMode = present_mode;
-    swapchain_info.clipped = VK_TRUE;
-    swapchain_info.oldSwapchain = VK_NULL_HANDLE;
 
-    VkSwapchainKHR swapchain = {};
-    FAIL_IF_NOT_SUCCESS(
-        vkCreateSwapchainKHR(device, &swapchain_info, nullptr, &swapchain),
-        "CreateSwapChain");
+    // Present waits on the semaphore signalled by the submit that rendered the
+    // image. It is keyed by swapchain image rather than by ring slot because
+    // the presentation engine only releases it once that image is acquired
+    // again.
+    std::vector<VkSemaphore> render_finished_semaphores(
+        options.headless ? 0 : color_images.size());
+    for (auto& semaphore : render_finished_semaphores)
+    {
+        FAIL_IF_NOT_SUCCESS(
+            vkCreateSemaphore(device, &semaphore_info, nullptr, &semaphore),
+            "CreateSemaphore");
+    }
 
-    uint32_t swapchain_image_num;
-    FAIL_IF_NOT_SUCCESS(
-        vkGetSwapchainImagesKHR(device, swapchain, &swapchain_image_num, nullptr),
-        "GetSwapchainImages");
-    std::vector<VkImage> swapchain_images(swapchain_image_num);
-    FAIL_IF_NOT_SUCCESS(
-        vkGetSwapchainImagesKHR(
-            device, swapchain, &swapchain_image_num, swapchain_images.data()),
-        "GetSwapchainImages");
+    // Fence of the ring slot that last rendered into each swapchain image.
+    std::vector<VkFence> images_in_flight(color_images.size(), VK_NULL_HANDLE);
 
-    std::vector<VkImageView> swapchain_imageviews(swapchain_images.size());
-    for (std::size_t i = 0; i < swapchain_imageviews.size(); ++i)
+    std::vector<VkImageView> color_imageviews(color_images.size());
+    for (std::size_t i = 0; i < color_imageviews.size(); ++i)
     {
         VkImageViewCreateInfo imageview_info = {};
         imageview_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-        imageview_info.image = swapchain_images[i];
+        imageview_info.image = color_images[i];
         imageview_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
-        imageview_info.format = surface_format.format;
+        imageview_info.format = color_format;
         imageview_info.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
         imageview_info.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
         imageview_info.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
@@ -652,266 +1376,350 @@ int main(int argc, char** argv)
 
         FAIL_IF_NOT_SUCCESS(
             vkCreateImageView(
-                device, &imageview_info, nullptr, &swapchain_imageviews[i]),
+                device, &imageview_info, nullptr, &color_imageviews[i]),
             "CreateImageView");
     }
 
-    VkFormat depth_image_format = VK_FORMAT_D16_UNORM;
-    VkImageTiling depth_image_tiling = VK_IMAGE_TILING_MAX_ENUM;
+    FormatDatabase format_db(physical_device, physical_device_props);
+    const std::string format_db_state =
+        options.format_db_path.empty()
+            ? "off"
+            : toString(format_db.load(options.format_db_path));
 
-    VkFormatProperties depth_image_format_properties = {};
-    vkGetPhysicalDeviceFormatProperties(
-        physical_device, depth_image_format, &depth_image_format_properties);
-    if (depth_image_format_properties.linearTilingFeatures &
-        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT)
+    const FormatChoice depth_choice = format_db.select(
+        FormatDatabase::c_depth_formats,
+        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
+    if (!depth_choice.found())
     {
-        depth_image_tiling = VK_IMAGE_TILING_LINEAR;
+        std::cerr << "No depth image format supported." << std::endl;
+        return EXIT_FAILURE;
     }
-    else if (depth_image_format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT)
+    const VkFormat depth_image_format = depth_choice.format;
+    const VkImageTiling depth_image_tiling = depth_choice.tiling;
+
+    diagnostics << "Depth format: " << depth_image_format
+                << (depth_image_tiling == VK_IMAGE_TILING_OPTIMAL
+                        ? " optimal"
+                        : " linear")
+                << " tiling, format database: " << format_db_state << ", "
+                << format_db.queriesNum() << " of " << format_db.formatsNum()
+                << " formats queried" << std::endl;
+    if (!options.format_db_path.empty() &&
+        !format_db.save(options.format_db_path))
     {
-        depth_image_tiling = VK_IMAGE_TILING_OPTIMAL;
+        std::cerr << "Failed to save the format database." << std::endl;
     }
 
-    if (depth_image_tiling == VK_IMAGE_TILING_MAX_ENUM)
+    const std::vector<glm::mat4> object_transforms =
+        makeObjectTransforms(options.object_count);
+
+    // Objects drawn this frame. Without CPU culling every object is.
+    std::vector<uint32_t> visible_objects(options.object_count);
+    for (uint32_t i = 0; i < options.object_count; ++i)
     {
-        std::cerr << "Depth image format " << depth_image_format
-                  << " not supported." << std::endl;
-        return EXIT_FAILURE;
+        visible_objects[i] = i;
     }
-
-    VkImageCreateInfo depth_image_info = {};
-    depth_image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    depth_image_info.imageType = VK_IMAGE_TYPE_2D;
-    depth_image_info.format = depth_image_format;
-    depth_image_info.extent.width = c_width;
-    depth_image_info.extent.height = c_height;
-    depth_image_info.extent.depth = 1;
-    depth_image_info.mipLevels = 1;
-    depth_image_info.arrayLayers = 1;
-    depth_image_info.tiling = depth_image_tiling;
-    depth_image_info.samples = VK_SAMPLE_COUNT_1_BIT;
-    depth_image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    depth_image_info.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-    depth_image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    VkImage depth_image = {};
-    FAIL_IF_NOT_SUCCESS(
-        vkCreateImage(device, &depth_image_info, nullptr, &depth_image),
-        "CreateImage");
-
-    VkMemoryRequirements depth_image_mem_reqs = {};
-    vkGetImageMemoryRequirements(device, depth_image, &depth_image_mem_reqs);
-
-    auto[depth_image_mem_type_index_found, depth_image_mem_type_index] =
-        findMemoryTypeIndex(
-            physical_device_mem_prop,
-            depth_image_mem_reqs,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-    if (!depth_image_mem_type_index_found)
+    const BoundingVolumes object_volumes =
+        options.cpu_cull ? makeBoundingVolumes(object_transforms)
+                         : BoundingVolumes();
+    ThreadPool thread_pool(
+        options.cpu_cull || !options.shader_dir.empty() ? options.threads : 1);
+    CpuCuller cpu_culler(thread_pool);
+    if (options.cpu_cull)
     {
-        std::cerr << "Couldn't find depth image memory type." << std::endl;
-        return EXIT_FAILURE;
+        diagnostics << "CPU culling: " << toString(options.cull_isa) << " on "
+                    << thread_pool.size() << " threads" << std::endl;
     }
 
-    VkMemoryAllocateInfo depth_image_mem_alloc = {};
-    depth_image_mem_alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    depth_image_mem_alloc.allocationSize = depth_image_mem_reqs.size;
-    depth_image_mem_alloc.memoryTypeIndex = depth_image_mem_type_index;
-
-    VkDeviceMemory depth_image_mem = VK_NULL_HANDLE;
-    vkAllocateMemory(device, &depth_image_mem_alloc, nullptr, &depth_image_mem);
-
-    FAIL_IF_NOT_SUCCESS(
-        vkBindImageMemory(device, depth_image, depth_image_mem, 0),
-        "BindImageMemory");
-
-    VkImageViewCreateInfo depth_imageview_info = {};
-    depth_imageview_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    depth_imageview_info.image = depth_image;
-    depth_imageview_info.format = VK_FORMAT_D16_UNORM;
-    depth_imageview_info.components.r = VK_COMPONENT_SWIZZLE_R;
-    depth_imageview_info.components.g = VK_COMPONENT_SWIZZLE_G;
-    depth_imageview_info.components.b = VK_COMPONENT_SWIZZLE_B;
-    depth_imageview_info.components.a = VK_COMPONENT_SWIZZLE_A;
-    depth_imageview_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-    depth_imageview_info.subresourceRange.baseMipLevel = 0;
-    depth_imageview_info.subresourceRange.levelCount = 1;
-    depth_imageview_info.subresourceRange.baseArrayLayer = 0;
-    depth_imageview_info.subresourceRange.layerCount = 1;
-    depth_imageview_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
-
-    VkImageView depth_imageview = {};
-    FAIL_IF_NOT_SUCCESS(
-        vkCreateImageView(device, &depth_imageview_info, nullptr, &depth_imageview),
-        "CreateImageView");
-
-    VkBufferCreateInfo uniform_buf_info = {};
-    uniform_buf_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    uniform_buf_info.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-    uniform_buf_info.size = sizeof(c_mvp);
-    uniform_buf_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    VkBuffer uniform_buf = {};
-    FAIL_IF_NOT_SUCCESS(
-        vkCreateBuffer(device, &uniform_buf_info, nullptr, &uniform_buf),
-        "CreateBuffer");
+    // Transforms are rewritten every frame, so every command buffer that can
+    // be pending needs its own region: per swapchain image with static
+    // recording, per ring slot otherwise. Push constants need no buffer.
+    const bool gpu_culled = options.transforms == TransformPath::GpuCulled;
+    const bool instanced =
+        options.transforms == TransformPath::Instanced || gpu_culled;
+    const bool push_transforms =
+        options.transforms == TransformPath::PushConstant || instanced;
+    const bool storage_transforms =
+        options.transforms == TransformPath::StorageBuffer || bindless;
+    const VkDescriptorType transform_descriptor_type =
+        bindless
+            ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+            : storage_transforms ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC
+                                 : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+
+    // A dynamic uniform buffer is bound once per object and sees one MVP,
+    // a storage buffer is bound once per frame and indexed by instance.
+    // Bindless has a heap descriptor per region instead of dynamic offsets.
+    UniformRing uniform_ring(
+        device,
+        memory_allocator,
+        physical_device_props.limits,
+        transform_descriptor_type);
+    const VkDeviceSize transform_range =
+        sizeof(glm::mat4) * (storage_transforms ? options.object_count : 1);
+    const VkDeviceSize transform_region_size =
+        uniform_ring.alignedSize(transform_range) *
+        (storage_transforms ? 1 : options.object_count);
+
+    // Dynamic offsets of this frame's object MVPs in the uniform ring, a
+    // single one with storage buffer transforms.
+    std::vector<uint32_t> object_uniform_offsets(
+        storage_transforms ? 1 : options.object_count, 0);
+
+    // MVPs of this frame, recorded directly with push constants.
+    std::vector<glm::mat4> object_mvps(instanced ? 0 : options.object_count);
+
+    // The embedded SPIR-V is replaced by the GLSL files of --shader-dir,
+    // which are compiled in parallel or read from the disk cache.
+    std::vector<uint8_t> vert_shader;
+    const char* transforms_define = nullptr;
+    switch (options.transforms)
+    {
+    case TransformPath::PushConstant:
+        vert_shader = c_push_constant_vert_shader;
+        transforms_define = "TRANSFORMS_PUSH";
+        break;
+    case TransformPath::DynamicUniform:
+        vert_shader = c_vert_shader;
+        transforms_define = "TRANSFORMS_UBO";
+        break;
+    case TransformPath::StorageBuffer:
+        vert_shader = c_storage_buffer_vert_shader;
+        transforms_define = "TRANSFORMS_SSBO";
+        break;
+    case TransformPath::Instanced:
+    case TransformPath::GpuCulled:
+        vert_shader = c_instanced_vert_shader;
+        transforms_define = "TRANSFORMS_INSTANCED";
+        break;
+    case TransformPath::Bindless:
+        vert_shader = c_bindless_vert_shader;
+        transforms_define = "TRANSFORMS_BINDLESS";
+        break;
+    }
+    std::vector<uint8_t> frag_shader = c_frag_shader;
+    std::vector<uint8_t> cull_shader = c_cull_comp_shader;
+    // Outlive this block for the hot reload.
+    std::unique_ptr<ShaderManager> shader_manager;
+    std::vector<ShaderSource> shader_sources;
+    if (!options.shader_dir.empty())
+    {
+        shader_sources = {
+            {options.shader_dir + "/cube.vert",
+             shaderc_glsl_vertex_shader,
+             {{transforms_define, "1"}}},
+            {options.shader_dir + "/cube.frag",
+             shaderc_glsl_fragment_shader,
+             {}},
+        };
+        if (gpu_culled)
+        {
+            shader_sources.push_back(
+                {options.shader_dir + "/cull.comp",
+                 shaderc_glsl_compute_shader,
+                 {}});
+        }
 
-    VkMemoryRequirements uniform_buf_mem_reqs = {};
-    vkGetBufferMemoryRequirements(device, uniform_buf, &uniform_buf_mem_reqs);
+        shader_manager = std::make_unique<ShaderManager>(
+            options.shader_cache_dir, thread_pool);
+        std::vector<ShaderBinary> shader_binaries =
+            shader_manager->loadAll(shader_sources);
+        for (std::size_t i = 0; i < shader_binaries.size(); ++i)
+        {
+            if (!shader_binaries[i].ok)
+            {
+                std::cerr << "Shader '" << shader_sources[i].path
+                          << "' failed: " << shader_binaries[i].log
+                          << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        shader_manager->writeStats(diagnostics);
 
-    auto[uniform_buf_mem_type_index_found, uniform_buf_mem_type_index] =
-        findMemoryTypeIndex(
-            physical_device_mem_prop,
-            uniform_buf_mem_reqs,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        vert_shader = std::move(shader_binaries[0].spirv);
+        frag_shader = std::move(shader_binaries[1].spirv);
+        if (gpu_culled)
+        {
+            cull_shader = std::move(shader_binaries[2].spirv);
+        }
+    }
 
-    if (!uniform_buf_mem_type_index_found)
+    // The descriptor set and pipeline layouts follow from the interfaces of
+    // the shaders, the dynamic buffer types from the uniform ring.
+    ShaderReflection vert_reflection;
+    ShaderReflection frag_reflection;
+    std::string reflection_error;
+    if (!reflectShader(vert_shader, vert_reflection, reflection_error) ||
+        !reflectShader(frag_shader, frag_reflection, reflection_error))
     {
-        std::cerr << "Couldn't find depth image memory type." << std::endl;
+        std::cerr << "Shader reflection failed: " << reflection_error
+                  << std::endl;
         return EXIT_FAILURE;
     }
 
-    VkMemoryAllocateInfo uniform_buf_mem_alloc_info = {};
-    uniform_buf_mem_alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    uniform_buf_mem_alloc_info.memoryTypeIndex = uniform_buf_mem_type_index;
-    uniform_buf_mem_alloc_info.allocationSize = uniform_buf_mem_reqs.size;
-
-    VkDeviceMemory uniform_buf_mem = {};
-    FAIL_IF_NOT_SUCCESS(
-        vkAllocateMemory(
-            device, &uniform_buf_mem_alloc_info, nullptr, &uniform_buf_mem),
-        "AllocateMemory");
-
-    void* uniform_buf_data_ptr = nullptr;
-    FAIL_IF_NOT_SUCCESS(
-        vkMapMemory(
-            device, uniform_buf_mem, 0, uniform_buf_mem_reqs.size, 0, &uniform_buf_data_ptr),
-        "MapMemory");
-    std::memcpy(uniform_buf_data_ptr, &c_mvp, sizeof(c_mvp));
-    vkUnmapMemory(device, uniform_buf_mem);
-
-    FAIL_IF_NOT_SUCCESS(
-        vkBindBufferMemory(device, uniform_buf, uniform_buf_mem, 0),
-        "BindBufferMemory");
-
-    VkDescriptorBufferInfo desc_buffer_info = {};
-    desc_buffer_info.buffer = uniform_buf;
-    desc_buffer_info.offset = 0;
-    desc_buffer_info.range = sizeof(c_mvp);
-
-    VkDescriptorSetLayoutBinding layout_binding = {};
-    layout_binding.binding = 0;
-    layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    layout_binding.descriptorCount = 1;
-    layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-
-    VkDescriptorSetLayoutCreateInfo descriptor_layout = {};
-    descriptor_layout.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    descriptor_layout.bindingCount = 1;
-    descriptor_layout.pBindings = &layout_binding;
-
-    std::vector<VkDescriptorSetLayout> layout_desc_set(1);
-    FAIL_IF_NOT_SUCCESS(
-        vkCreateDescriptorSetLayout(
-            device, &descriptor_layout, nullptr, layout_desc_set.data()),
-        "CreateDescriptorSetLayout");
-
-    VkPipelineLayoutCreateInfo pipeline_layout_info = {};
-    pipeline_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipeline_layout_info.setLayoutCount = layout_desc_set.size();
-    pipeline_layout_info.pSetLayouts = layout_desc_set.data();
-
+    // The bindless vertex shader indexes the heap, whose set layout replaces
+    // the reflected one. Declared first, it outlives the layout cache.
+    BindlessHeap bindless_heap(
+        device,
+        bindless_support,
+        c_bindless_heap_buffers,
+        c_bindless_heap_images);
+    PipelineLayoutCache layout_cache(device);
+    auto get_pipeline_layout =
+        [&](const std::vector<const ShaderReflection*>& stages,
+            VkPipelineLayout& layout) {
+            return bindless ? layout_cache.getPipelineLayoutForSets(
+                                  stages, {bindless_heap.layout()}, layout)
+                            : layout_cache.getPipelineLayout(
+                                  stages, true, layout);
+        };
+    if (bindless)
+    {
+        FAIL_IF_NOT_SUCCESS(bindless_heap.create(), "CreateBindlessHeap");
+    }
     VkPipelineLayout pipeline_layout = {};
     FAIL_IF_NOT_SUCCESS(
-        vkCreatePipelineLayout(
-            device, &pipeline_layout_info, nullptr, &pipeline_layout),
+        get_pipeline_layout(
+            {&vert_reflection, &frag_reflection}, pipeline_layout),
         "CreatePipelineLayout");
 
-    VkDescriptorPoolSize type_count[1];
-    type_count[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    type_count[0].descriptorCount = 1;
-
-    VkDescriptorPoolCreateInfo descriptor_pool_info = {};
-    descriptor_pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    descriptor_pool_info.maxSets = 1;
-    descriptor_pool_info.poolSizeCount = 1;
-    descriptor_pool_info.pPoolSizes = type_count;
+    std::vector<VkDescriptorSetLayout> layout_desc_set =
+        layout_cache.setLayouts(pipeline_layout);
+    DescriptorAllocator descriptor_allocator(device);
+    DescriptorSetCache descriptor_sets(device, descriptor_allocator);
+    std::vector<VkDescriptorSet> desc_set;
+    // Heap indices of the uniform ring regions, by resource set.
+    std::vector<uint32_t> bindless_transforms;
+    if (!push_transforms)
+    {
+        const uint32_t transform_regions_num =
+            options.static_recording
+                ? static_cast<uint32_t>(color_images.size())
+                : options.frames_in_flight;
+        FAIL_IF_NOT_SUCCESS(
+            uniform_ring.create(transform_region_size, transform_regions_num),
+            "CreateUniformRing");
 
-    VkDescriptorPool descriptor_pool = {};
-    FAIL_IF_NOT_SUCCESS(
-        vkCreateDescriptorPool(
-            device, &descriptor_pool_info, nullptr, &descriptor_pool),
-        "CreateDescriptorPool");
+        if (bindless)
+        {
+            for (uint32_t i = 0; i < transform_regions_num; ++i)
+            {
+                VkDescriptorBufferInfo region_info = {};
+                region_info.buffer = uniform_ring.buffer();
+                region_info.offset = uniform_ring.regionOffset(i);
+                region_info.range = transform_range;
+                const uint32_t index = bindless_heap.addBuffer(region_info);
+                if (index == BindlessHeap::c_invalid_index)
+                {
+                    std::cerr << "Bindless heap is full." << std::endl;
+                    return EXIT_FAILURE;
+                }
+                bindless_transforms.push_back(index);
+            }
+        }
+        else
+        {
+            DescriptorBufferBinding transforms_binding = {};
+            transforms_binding.binding = 0;
+            transforms_binding.type = transform_descriptor_type;
+            transforms_binding.info.buffer = uniform_ring.buffer();
+            transforms_binding.info.offset = 0;
+            transforms_binding.info.range = transform_range;
+
+            desc_set.resize(1);
+            FAIL_IF_NOT_SUCCESS(
+                descriptor_sets.get(
+                    layout_desc_set[0], {transforms_binding}, {}, desc_set[0]),
+                "AllocateDescriptorSets");
+        }
+    }
 
-    VkDescriptorSetAllocateInfo desc_set_alloc_info[1] = {};
-    desc_set_alloc_info[0].sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    desc_set_alloc_info[0].descriptorPool = descriptor_pool;
-    desc_set_alloc_info[0].descriptorSetCount = 1;
-    desc_set_alloc_info[0].pSetLayouts = layout_desc_set.data();
 
-    std::vector<VkDescriptorSet> desc_set(1);
-    FAIL_IF_NOT_SUCCESS(
-        vkAllocateDescriptorSets(device, desc_set_alloc_info, desc_set.data()),
-        "AllocateDescriptorSets");
-
-    VkWriteDescriptorSet writes_desc_set[1] = {};
-    writes_desc_set[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    writes_desc_set[0].dstSet = desc_set[0];
-    writes_desc_set[0].descriptorCount = 1;
-    writes_desc_set[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    writes_desc_set[0].pBufferInfo = &desc_buffer_info;
-    writes_desc_set[0].dstArrayElement = 0;
-    writes_desc_set[0].dstBinding = 0;
-
-    vkUpdateDescriptorSets(device, 1, writes_desc_set, 0, nullptr);
-
-    VkAttachmentDescription attachment_descs[2] = {};
-    attachment_descs[0].format = surface_format.format;
-    attachment_descs[0].samples = VK_SAMPLE_COUNT_1_BIT;
-    attachment_descs[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    attachment_descs[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    attachment_descs[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    attachment_descs[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    attachment_descs[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    attachment_descs[0].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-    attachment_descs[1].format = depth_image_format;
-    attachment_descs[1].samples = VK_SAMPLE_COUNT_1_BIT;
-    attachment_descs[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    attachment_descs[1].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    attachment_descs[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    attachment_descs[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    attachment_descs[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    attachment_descs[1].finalLayout =
-        VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-    VkAttachmentReference color_reference = {};
-    color_reference.attachment = 0;
-    color_reference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-    VkAttachmentReference depth_reference = {};
-    depth_reference.attachment = 1;
-    depth_reference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-    VkSubpassDescription subpass = {};
-    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-    subpass.colorAttachmentCount = 1;
-    subpass.pColorAttachments = &color_reference;
-    subpass.pDepthStencilAttachment = &depth_reference;
-
-    VkRenderPassCreateInfo render_pass_info = {};
-    render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    render_pass_info.attachmentCount = 2;
-    render_pass_info.pAttachments = attachment_descs;
-    render_pass_info.subpassCount = 1;
-    render_pass_info.pSubpasses = &subpass;
-
-    VkRenderPass render_pass = {};
-    FAIL_IF_NOT_SUCCESS(
-        vkCreateRenderPass(device, &render_pass_info, nullptr, &render_pass),
-        "CreateRenderPass");
+    // The frame as a render graph: the cull dispatch, the cube pass and the
+    // headless readback. Passes the current transform path doesn't use
+    // declare nothing and are culled; the graph derives the render pass,
+    // the barriers and the depth buffer memory from the rest.
+    RenderGraph render_graph(device, memory_allocator);
+
+    ImageDesc color_desc;
+    color_desc.format = color_format;
+    color_desc.extent = {c_width, c_height};
+    // The first transition of a swapchain image waits for the image
+    // acquired semaphore, which is waited at the same stage.
+    const uint32_t color_resource =
+        options.headless
+            ? render_graph.importImage(
+                  "color", color_desc, ResourceState(), ResourceState())
+            : render_graph.importImage(
+                  "color",
+                  color_desc,
+                  {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                   0,
+                   VK_IMAGE_LAYOUT_UNDEFINED},
+                  {VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                   0,
+                   VK_IMAGE_LAYOUT_PRESENT_SRC_KHR});
+
+    ImageDesc depth_desc;
+    depth_desc.format = depth_image_format;
+    depth_desc.extent = {c_width, c_height};
+    depth_desc.tiling = depth_image_tiling;
+    const uint32_t depth_resource =
+        render_graph.createImage("depth", depth_desc);
+
+    // The culler owns a pair of output buffers per resource set.
+    const uint32_t visible_resource = render_graph.importBuffer(
+        "visible_instances", ResourceState(), ResourceState());
+    const uint32_t draw_resource = render_graph.importBuffer(
+        "draw_command", ResourceState(), ResourceState());
+    // The host reads the pixels once the frame's fence has been waited on.
+    const uint32_t readback_resource = render_graph.importBuffer(
+        "readback",
+        ResourceState(),
+        {VK_PIPELINE_STAGE_HOST_BIT,
+         VK_ACCESS_HOST_READ_BIT,
+         VK_IMAGE_LAYOUT_UNDEFINED});
+
+    const uint32_t cull_pass = render_graph.addPass("cull", PassType::Compute);
+    const uint32_t cube_pass =
+        render_graph.addPass("cubes", PassType::Graphics);
+    const uint32_t readback_pass =
+        render_graph.addPass("readback", PassType::Transfer);
+
+    VkClearValue clear_color = {};
+    clear_color.color.float32[0] = 0.2f;
+    clear_color.color.float32[1] = 0.2f;
+    clear_color.color.float32[2] = 0.2f;
+    clear_color.color.float32[3] = 0.2f;
+    VkClearValue clear_depth = {};
+    clear_depth.depthStencil.depth = 1.0f;
+    clear_depth.depthStencil.stencil = 0;
+
+    render_graph.write(
+        cube_pass, color_resource, ResourceUsage::ColorAttachment);
+    render_graph.clear(cube_pass, color_resource, clear_color);
+    render_graph.write(
+        cube_pass, depth_resource, ResourceUsage::DepthAttachment);
+    render_graph.clear(cube_pass, depth_resource, clear_depth);
+    if (gpu_culled)
+    {
+        render_graph.write(
+            cull_pass, visible_resource, ResourceUsage::StorageWrite);
+        render_graph.write(
+            cull_pass, draw_resource, ResourceUsage::StorageWrite);
+        render_graph.read(
+            cube_pass, visible_resource, ResourceUsage::VertexBuffer);
+        render_graph.read(
+            cube_pass, draw_resource, ResourceUsage::IndirectBuffer);
+    }
+    if (options.headless)
+    {
+        render_graph.read(
+            readback_pass, color_resource, ResourceUsage::TransferSrc);
+        render_graph.write(
+            readback_pass, readback_resource, ResourceUsage::TransferDst);
+    }
+    FAIL_IF_NOT_SUCCESS(render_graph.compile(), "CompileRenderGraph");
 
     VkPipelineShaderStageCreateInfo shader_stages[2] = {};
     shader_stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -924,9 +1732,9 @@ int main(int argc, char** argv)
 
     VkShaderModuleCreateInfo vert_shader_module_info = {};
     vert_shader_module_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    vert_shader_module_info.codeSize = c_vert_shader.size();
+    vert_shader_module_info.codeSize = vert_shader.size();
     vert_shader_module_info.pCode =
-        reinterpret_cast<const uint32_t*>(c_vert_shader.data());
+        reinterpret_cast<const uint32_t*>(vert_shader.data());
     FAIL_IF_NOT_SUCCESS(
         vkCreateShaderModule(
             device, &vert_shader_module_info, nullptr, &shader_stages[0].module),
@@ -934,287 +1742,340 @@ int main(int argc, char** argv)
 
     VkShaderModuleCreateInfo frag_shader_module_info = {};
     frag_shader_module_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    frag_shader_module_info.codeSize = c_frag_shader.size();
+    frag_shader_module_info.codeSize = frag_shader.size();
     frag_shader_module_info.pCode =
-        reinterpret_cast<const uint32_t*>(c_frag_shader.data());
+        reinterpret_cast<const uint32_t*>(frag_shader.data());
     FAIL_IF_NOT_SUCCESS(
         vkCreateShaderModule(
             device, &frag_shader_module_info, nullptr, &shader_stages[1].module),
         "CreateShaderModule");
 
-    VkImageView attachments[2] = {};
-    attachments[1] = depth_imageview;
-
-    VkFramebufferCreateInfo fb_info = {};
-    fb_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-    fb_info.renderPass = render_pass;
-    fb_info.attachmentCount = 2;
-    fb_info.pAttachments = attachments;
-    fb_info.width = c_width;
-    fb_info.height = c_height;
-    fb_info.layers = 1;
-
-    std::vector<VkFramebuffer> framebuffers(swapchain_imageviews.size());
-    for (std::size_t i = 0; i < swapchain_imageviews.size(); i++)
-    {
-        attachments[0] = swapchain_imageviews[i];
-        FAIL_IF_NOT_SUCCESS(
-            vkCreateFramebuffer(device, &fb_info, nullptr, &framebuffers[i]),
-            "CreateFramebuffer");
-    }
-
-    VkBufferCreateInfo vertex_buf_info = {};
-    vertex_buf_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    vertex_buf_info.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
-    vertex_buf_info.size = sizeof(c_cube_vertices);
-    vertex_buf_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    const VertexFormat vertex_format =
+        makeVertexFormat(options.vertex_positions);
+    diagnostics << "Vertex format: " << toString(vertex_format.position)
+                << " positions, " << toString(vertex_format.color)
+                << " colors, " << vertex_format.stride() << " of "
+                << sizeof(c_cube_vertices[0]) << " bytes per vertex"
+                << std::endl;
+    const IndexedMesh cube_mesh = makeCubeMesh(vertex_format);
+    printMeshStats(cube_mesh, diagnostics);
 
     VkBuffer vertex_buf = {};
+    MemoryAllocation vertex_buf_mem;
     FAIL_IF_NOT_SUCCESS(
-        vkCreateBuffer(device, &vertex_buf_info, nullptr, &vertex_buf),
+        staging_uploader.createBuffer(
+            cube_mesh.vertices.data(),
+            cube_mesh.vertices.size(),
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            vertex_buf,
+            vertex_buf_mem),
         "CreateBuffer");
 
-    VkMemoryRequirements vertex_buf_mem_reqs = {};
-    vkGetBufferMemoryRequirements(device, vertex_buf, &vertex_buf_mem_reqs);
-
-    auto[vertex_buf_mem_type_index_found, vertex_buf_mem_type_index] =
-        findMemoryTypeIndex(
-            physical_device_mem_prop,
-            vertex_buf_mem_reqs,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    // 16 bit indices halve the index fetch bandwidth whenever they fit.
+    const uint32_t index_count =
+        static_cast<uint32_t>(cube_mesh.indices.size());
+    const VkIndexType index_type =
+        fitsShortIndices(cube_mesh.vertices.size() / cube_mesh.vertex_size)
+            ? VK_INDEX_TYPE_UINT16
+            : VK_INDEX_TYPE_UINT32;
+    const std::vector<uint16_t> short_indices(
+        cube_mesh.indices.begin(), cube_mesh.indices.end());
+    VkBuffer index_buf = {};
+    MemoryAllocation index_buf_mem;
+    FAIL_IF_NOT_SUCCESS(
+        index_type == VK_INDEX_TYPE_UINT16
+            ? staging_uploader.createBuffer(
+                  short_indices.data(),
+                  short_indices.size() * sizeof(uint16_t),
+                  VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                  index_buf,
+                  index_buf_mem)
+            : staging_uploader.createBuffer(
+                  cube_mesh.indices.data(),
+                  cube_mesh.indices.size() * sizeof(uint32_t),
+                  VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                  index_buf,
+                  index_buf_mem),
+        "CreateBuffer");
 
-    if (!vertex_buf_mem_type_index_found)
+    VkBuffer instance_buf = VK_NULL_HANDLE;
+    MemoryAllocation instance_buf_mem;
+    if (instanced)
     {
-        std::cerr << "Couldn't find vertex buffer memory type." << std::endl;
-        return EXIT_FAILURE;
+        const std::vector<InstanceData> instances =
+            makeInstances(object_transforms);
+        FAIL_IF_NOT_SUCCESS(
+            staging_uploader.createBuffer(
+                instances.data(),
+                instances.size() * sizeof(InstanceData),
+                gpu_culled ? VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+                           : VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                instance_buf,
+                instance_buf_mem),
+            "CreateBuffer");
     }
+    FAIL_IF_NOT_SUCCESS(staging_uploader.flush(), "FlushUploads");
 
-    VkMemoryAllocateInfo vertex_buf_mem_alloc_info = {};
-    vertex_buf_mem_alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    vertex_buf_mem_alloc_info.memoryTypeIndex = vertex_buf_mem_type_index;
-    vertex_buf_mem_alloc_info.allocationSize = vertex_buf_mem_reqs.size;
+    // A warm cache skips most of the driver compile, the creation time of
+    // all pipelines is reported to compare runs.
+    PipelineCache pipeline_cache(
+        device, physical_device_props, options.pipeline_cache_path);
+    if (!options.pipeline_cache_path.empty())
+    {
+        FAIL_IF_NOT_SUCCESS(pipeline_cache.create(), "CreatePipelineCache");
+    }
+    std::chrono::duration<double, std::milli> pipeline_create_ms(0.0);
 
-    VkDeviceMemory vertex_buf_mem = {};
-    FAIL_IF_NOT_SUCCESS(
-        vkAllocateMemory(
-            device, &vertex_buf_mem_alloc_info, nullptr, &vertex_buf_mem),
-        "AllocateMemory");
+    // The view never moves, so neither does the frustum.
+    const Frustum frustum = makeFrustum(c_view_projection);
+    GpuCuller gpu_culler(device, memory_allocator);
+    if (gpu_culled)
+    {
+        auto cull_create_start = std::chrono::steady_clock::now();
+        FAIL_IF_NOT_SUCCESS(
+            gpu_culler.create(
+                cull_shader,
+                instance_buf,
+                options.object_count,
+                sizeof(InstanceData),
+                index_count,
+                options.static_recording
+                    ? static_cast<uint32_t>(color_images.size())
+                    : options.frames_in_flight,
+                pipeline_cache.handle()),
+            "CreateGpuCuller");
+        pipeline_create_ms +=
+            std::chrono::steady_clock::now() - cull_create_start;
+    }
 
-    void* vertex_buf_data_ptr = nullptr;
-    FAIL_IF_NOT_SUCCESS(
-        vkMapMemory(
-            device, vertex_buf_mem, 0, vertex_buf_mem_reqs.size, 0, &vertex_buf_data_ptr),
-        "MapMemory");
-    std::memcpy(vertex_buf_data_ptr, c_cube_vertices, sizeof(c_cube_vertices));
-    vkUnmapMemory(device, vertex_buf_mem);
+    VkVertexInputBindingDescription vi_bindings[2] = {};
+    vi_bindings[0].binding = 0;
+    vi_bindings[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    vi_bindings[0].stride = vertex_format.stride();
+    vi_bindings[1].binding = 1;
+    vi_bindings[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+    vi_bindings[1].stride = sizeof(InstanceData);
+
+    // Missing position and color components expand to w = 1 on fetch.
+    std::vector<VkVertexInputAttributeDescription> vi_attribs =
+        vertex_format.attributes(0, 0);
+    if (instanced)
+    {
+        // The instance model matrix takes one location per column.
+        VkVertexInputAttributeDescription instance_attrib = {};
+        instance_attrib.binding = 1;
+        instance_attrib.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+        for (uint32_t column = 0; column < 4; ++column)
+        {
+            instance_attrib.location = 2 + column;
+            instance_attrib.offset =
+                offsetof(InstanceData, model) + column * sizeof(glm::vec4);
+            vi_attribs.push_back(instance_attrib);
+        }
+        instance_attrib.location = 6;
+        instance_attrib.format = VK_FORMAT_R8G8B8A8_UNORM;
+        instance_attrib.offset = offsetof(InstanceData, color);
+        vi_attribs.push_back(instance_attrib);
+    }
 
-    FAIL_IF_NOT_SUCCESS(
-        vkBindBufferMemory(device, vertex_buf, vertex_buf_mem, 0),
-        "BindBufferMemory");
-
-    VkVertexInputBindingDescription vi_binding = {};
-    vi_binding.binding = 0;
-    vi_binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-    vi_binding.stride = sizeof(c_cube_vertices[0]);
-
-    VkVertexInputAttributeDescription vi_attribs[2] = {};
-    vi_attribs[0].binding = 0;
-    vi_attribs[0].location = 0;
-    vi_attribs[0].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-    vi_attribs[0].offset = 0;
-    vi_attribs[1].binding = 0;
-    vi_attribs[1].location = 1;
-    vi_attribs[1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-    vi_attribs[1].offset = 16;
-
-    VkDynamicState dynamic_state_enables[VK_DYNAMIC_STATE_RANGE_SIZE] = {};
-    uint32_t dynamic_state_num = 0;
-
-    dynamic_state_enables[dynamic_state_num++] = VK_DYNAMIC_STATE_VIEWPORT;
-    dynamic_state_enables[dynamic_state_num++] = VK_DYNAMIC_STATE_SCISSOR;
-
-    VkPipelineDynamicStateCreateInfo dyn_state_info = {};
-    dyn_state_info.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    dyn_state_info.pDynamicStates = dynamic_state_enables;
-    dyn_state_info.dynamicStateCount = dynamic_state_num;
-
-    VkPipelineVertexInputStateCreateInfo vi_state_info = {};
-    vi_state_info.sType =
-        VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vi_state_info.vertexBindingDescriptionCount = 1;
-    vi_state_info.pVertexBindingDescriptions = &vi_binding;
-    vi_state_info.vertexAttributeDescriptionCount = 2;
-    vi_state_info.pVertexAttributeDescriptions = vi_attribs;
-
-    VkPipelineInputAssemblyStateCreateInfo ia_state_info = {};
-    ia_state_info.sType =
-        VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-    ia_state_info.primitiveRestartEnable = VK_FALSE;
-    ia_state_info.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-
-    VkPipelineRasterizationStateCreateInfo rs_state_info = {};
-    rs_state_info.sType =
-        VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-    rs_state_info.polygonMode = VK_POLYGON_MODE_FILL;
-    rs_state_info.cullMode = VK_CULL_MODE_BACK_BIT;
-    rs_state_info.frontFace = VK_FRONT_FACE_CLOCKWISE;
-    rs_state_info.depthClampEnable = VK_TRUE;
-    rs_state_info.rasterizerDiscardEnable = VK_FALSE;
-    rs_state_info.depthBiasEnable = VK_FALSE;
-    rs_state_info.depthBiasConstantFactor = 0;
-    rs_state_info.depthBiasClamp = 0;
-    rs_state_info.depthBiasSlopeFactor = 0;
-    rs_state_info.lineWidth = 1.0f;
-
-    VkPipelineColorBlendAttachmentState cb_att_state[1] = {};
-    cb_att_state[0].colorWriteMask = 0xf;
-    cb_att_state[0].blendEnable = VK_FALSE;
-    cb_att_state[0].alphaBlendOp = VK_BLEND_OP_ADD;
-    cb_att_state[0].colorBlendOp = VK_BLEND_OP_ADD;
-    cb_att_state[0].srcColorBlendFactor = VK_BLEND_FACTOR_ZERO;
-    cb_att_state[0].dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
-    cb_att_state[0].srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
-    cb_att_state[0].dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
-
-    VkPipelineColorBlendStateCreateInfo cb_state_info = {};
-    cb_state_info.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-    cb_state_info.attachmentCount = 1;
-    cb_state_info.pAttachments = cb_att_state;
-    cb_state_info.logicOpEnable = VK_FALSE;
-    cb_state_info.logicOp = VK_LOGIC_OP_NO_OP;
-    cb_state_info.blendConstants[0] = 1.0f;
-    cb_state_info.blendConstants[1] = 1.0f;
-    cb_state_info.blendConstants[2] = 1.0f;
-    cb_state_info.blendConstants[3] = 1.0f;
-
-    VkPipelineViewportStateCreateInfo vp_state_info = {};
-    vp_state_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-    vp_state_info.viewportCount = 1;
-    vp_state_info.scissorCount = 1;
-
-    VkPipelineDepthStencilStateCreateInfo ds_state_info = {};
-    ds_state_info.sType =
-        VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-    ds_state_info.depthTestEnable = VK_TRUE;
-    ds_state_info.depthWriteEnable = VK_TRUE;
-    ds_state_info.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
-    ds_state_info.depthBoundsTestEnable = VK_FALSE;
-    ds_state_info.minDepthBounds = 0;
-    ds_state_info.maxDepthBounds = 0;
-    ds_state_info.stencilTestEnable = VK_FALSE;
-    ds_state_info.back.failOp = VK_STENCIL_OP_KEEP;
-    ds_state_info.back.passOp = VK_STENCIL_OP_KEEP;
-    ds_state_info.back.compareOp = VK_COMPARE_OP_ALWAYS;
-    ds_state_info.back.compareMask = 0;
-    ds_state_info.back.reference = 0;
-    ds_state_info.back.depthFailOp = VK_STENCIL_OP_KEEP;
-    ds_state_info.back.writeMask = 0;
-    ds_state_info.front = ds_state_info.back;
-
-    VkPipelineMultisampleStateCreateInfo ms_state_info = {};
-    ms_state_info.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-    ms_state_info.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-    ms_state_info.sampleShadingEnable = VK_FALSE;
-    ms_state_info.alphaToCoverageEnable = VK_FALSE;
-    ms_state_info.alphaToOneEnable = VK_FALSE;
-    ms_state_info.minSampleShading = 0.0;
-
-    VkGraphicsPipelineCreateInfo pipeline_info = {};
-    pipeline_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipeline_info.layout = pipeline_layout;
-    pipeline_info.basePipelineHandle = VK_NULL_HANDLE;
-    pipeline_info.basePipelineIndex = 0;
-    pipeline_info.pVertexInputState = &vi_state_info;
-    pipeline_info.pInputAssemblyState = &ia_state_info;
-    pipeline_info.pRasterizationState = &rs_state_info;
-    pipeline_info.pColorBlendState = &cb_state_info;
-    pipeline_info.pTessellationState = nullptr;
-    pipeline_info.pMultisampleState = &ms_state_info;
-    pipeline_info.pDynamicState = &dyn_state_info;
-    pipeline_info.pViewportState = &vp_state_info;
-    pipeline_info.pDepthStencilState = &ds_state_info;
-    pipeline_info.pStages = shader_stages;
-    pipeline_info.stageCount = 2;
-    pipeline_info.renderPass = render_pass;
-    pipeline_info.subpass = 0;
+    if (!checkVertexInput(vert_reflection, vi_attribs, reflection_error))
+    {
+        std::cerr << "Vertex input mismatch: " << reflection_error
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
 
+    // Everything else keeps the defaults of PipelineKey: triangle lists,
+    // back face culling, depth test and write, no blending.
+    PipelineKey pipeline_key;
+    pipeline_key.vertex_shader = shader_stages[0].module;
+    pipeline_key.fragment_shader = shader_stages[1].module;
+    pipeline_key.layout = pipeline_layout;
+    pipeline_key.render_pass = render_graph.renderPass(cube_pass);
+    pipeline_key.depth_clamp = VK_TRUE;
+    pipeline_key.setVertexInput(
+        std::vector<VkVertexInputBindingDescription>(
+            vi_bindings, vi_bindings + (instanced ? 2 : 1)),
+        vi_attribs);
+
+    PipelineFactory pipeline_factory(
+        device, pipeline_cache.handle(), options.threads);
+    auto pipeline_create_start = std::chrono::steady_clock::now();
     VkPipeline pipeline = {};
     FAIL_IF_NOT_SUCCESS(
-        vkCreateGraphicsPipelines(
-            device, VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &pipeline),
-        "CreateGraphicsPipelines");
+        pipeline_factory.get(pipeline_key, pipeline), "CreateGraphicsPipeline");
+    pipeline_create_ms +=
+        std::chrono::steady_clock::now() - pipeline_create_start;
+
+    const std::string pipeline_cache_state =
+        options.pipeline_cache_path.empty()
+            ? "off"
+            : toString(pipeline_cache.loadResult());
+    diagnostics << "Pipelines created in " << pipeline_create_ms.count()
+                << " ms, pipeline cache: " << pipeline_cache_state << std::endl;
+    // Saved right away as well, so a run that doesn't shut down cleanly
+    // still leaves a warm cache.
+    if (!options.pipeline_cache_path.empty() && !pipeline_cache.save())
+    {
+        std::cerr << "Failed to save the pipeline cache." << std::endl;
+    }
 
-    while (!glfwWindowShouldClose(window))
+    // The reloader thread builds replacement pipelines from pipeline_key
+    // and the culler layout, neither of which changes after this point.
+    // They are owned here, so the factory hands over the first one.
+    // Replaced pipelines are destroyed once every slot fence has been
+    // waited on since the swap.
+    struct RetiredPipeline
     {
-        VkSemaphoreCreateInfo image_acquired_semaphore_info = {};
-        image_acquired_semaphore_info.sType =
-            VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        VkPipeline pipeline;
+        uint64_t destroy_frame;
+    };
+    std::deque<RetiredPipeline> retired_pipelines;
+    std::unique_ptr<ShaderReloader> shader_reloader;
+    uint32_t graphics_reload_id = 0;
+    if (options.hot_reload)
+    {
+        shader_reloader = std::make_unique<ShaderReloader>(
+            device, *shader_manager, diagnostics);
+        graphics_reload_id = shader_reloader->addPipeline(
+            {shader_sources[0], shader_sources[1]},
+            [&](const std::vector<ShaderBinary>& binaries,
+                VkPipeline& new_pipeline) -> VkResult {
+                // Only edits that keep the interface can be swapped in,
+                // the descriptor sets and vertex input stay as they are.
+                ShaderReflection reloaded[2];
+                std::string error;
+                VkPipelineLayout reloaded_layout = VK_NULL_HANDLE;
+                if (!reflectShader(binaries[0].spirv, reloaded[0], error) ||
+                    !reflectShader(binaries[1].spirv, reloaded[1], error) ||
+                    !checkVertexInput(reloaded[0], vi_attribs, error) ||
+                    get_pipeline_layout(
+                        {&reloaded[0], &reloaded[1]}, reloaded_layout) !=
+                        VK_SUCCESS ||
+                    reloaded_layout != pipeline_layout)
+                {
+                    std::cerr << "Reloaded shaders changed the interface. "
+                              << error << std::endl;
+                    return VK_ERROR_INITIALIZATION_FAILED;
+                }
+
+                VkShaderModule modules[2] = {};
+                for (uint32_t i = 0; i < 2; ++i)
+                {
+                    VkShaderModuleCreateInfo module_info = {};
+                    module_info.sType =
+                        VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+                    module_info.codeSize = binaries[i].spirv.size();
+                    module_info.pCode = reinterpret_cast<const uint32_t*>(
+                        binaries[i].spirv.data());
+                    if (VkResult result = vkCreateShaderModule(
+                            device, &module_info, nullptr, &modules[i]);
+                        result != VK_SUCCESS)
+                    {
+                        if (i == 1)
+                        {
+                            vkDestroyShaderModule(device, modules[0], nullptr);
+                        }
+                        return result;
+                    }
+                }
+                // Not created through the factory: the modules are gone
+                // right after, their handles must not stay in a key.
+                PipelineKey reload_key = pipeline_key;
+                reload_key.vertex_shader = modules[0];
+                reload_key.fragment_shader = modules[1];
+                VkResult result = createGraphicsPipeline(
+                    device, pipeline_cache.handle(), reload_key, new_pipeline);
+                vkDestroyShaderModule(device, modules[0], nullptr);
+                vkDestroyShaderModule(device, modules[1], nullptr);
+                return result;
+            });
+        if (gpu_culled)
+        {
+            shader_reloader->addPipeline(
+                {shader_sources[2]},
+                [&gpu_culler](
+                    const std::vector<ShaderBinary>& binaries,
+                    VkPipeline& new_pipeline) -> VkResult {
+                    // The layout and descriptor sets of the culler are
+                    // fixed, the edit has to keep using them as they are.
+                    ShaderReflection reloaded;
+                    std::string error;
+                    if (!reflectShader(binaries[0].spirv, reloaded, error) ||
+                        !GpuCuller::checkInterface(reloaded, error))
+                    {
+                        std::cerr << "Reloaded shaders changed the interface. "
+                                  << error << std::endl;
+                        return VK_ERROR_INITIALIZATION_FAILED;
+                    }
+                    return gpu_culler.createPipeline(
+                        binaries[0].spirv, new_pipeline);
+                });
+        }
+        if (!shader_reloader->start(options.shader_dir))
+        {
+            std::cerr << "Failed to watch '" << options.shader_dir << "'."
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
 
-        VkSemaphore image_acquired_semaphore = {};
+    // One query set per command buffer that can be pending: per swapchain
+    // image with static recording, per ring slot otherwise.
+    GpuProfiler gpu_profiler;
+    if (options.gpu_profile)
+    {
         FAIL_IF_NOT_SUCCESS(
-            vkCreateSemaphore(
-                device, &image_acquired_semaphore_info, nullptr, &image_acquired_semaphore),
-            "CreateSemaphore");
-
-        VkFenceCreateInfo fence_info = {};
-        fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-
-        VkFence draw_fence = {};
-        vkCreateFence(device, &fence_info, nullptr, &draw_fence);
+            gpu_profiler.create(
+                device,
+                physical_device_props,
+                queue_families[graphics_queue_family_index].timestampValidBits,
+                pipeline_statistics,
+                options.static_recording
+                    ? static_cast<uint32_t>(color_images.size())
+                    : options.frames_in_flight,
+                c_gpu_profiler_max_scopes),
+            "CreateGpuProfiler");
+        if (!gpu_profiler.enabled())
+        {
+            std::cerr << "Graphics queue doesn't support timestamps, GPU "
+                         "profiling is disabled."
+                      << std::endl;
+        }
+    }
 
-        VkCommandBufferBeginInfo cmd_buffer_begin_info = {};
-        cmd_buffer_begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        FAIL_IF_NOT_SUCCESS(
-            vkBeginCommandBuffer(cmd_buffer, &cmd_buffer_begin_info),
-            "BeginCommandBuffer");
+    // What the pass callbacks record depends on the command buffer being
+    // recorded, record_cmd_buffer sets it before executing the graph.
+    uint32_t recording_set = 0;
+    uint32_t recording_image = 0;
 
-        uint32_t image_index = 0;
-        FAIL_IF_NOT_SUCCESS(
-            vkAcquireNextImageKHR(
-                device,
-                swapchain,
-                UINT64_MAX,
-                image_acquired_semaphore,
-                VK_NULL_HANDLE,
-                &image_index),
-            "AcquireNextImageKHR");
-
-        VkClearValue clear_values[2] = {};
-        clear_values[0].color.float32[0] = 0.2f;
-        clear_values[0].color.float32[1] = 0.2f;
-        clear_values[0].color.float32[2] = 0.2f;
-        clear_values[0].color.float32[3] = 0.2f;
-        clear_values[1].depthStencil.depth = 1.0f;
-        clear_values[1].depthStencil.stencil = 0;
-
-        VkRenderPassBeginInfo rp_begin = {};
-        rp_begin.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        rp_begin.renderPass = render_pass;
-        rp_begin.framebuffer = framebuffers[image_index];
-        rp_begin.renderArea.offset.x = 0;
-        rp_begin.renderArea.offset.y = 0;
-        rp_begin.renderArea.extent.width = c_width;
-        rp_begin.renderArea.extent.height = c_height;
-        rp_begin.clearValueCount = 2;
-        rp_begin.pClearValues = clear_values;
-
-        vkCmdBeginRenderPass(cmd_buffer, &rp_begin, VK_SUBPASS_CONTENTS_INLINE);
+    render_graph.setRecord(cull_pass, [&](VkCommandBuffer cmd_buffer) {
+        const uint32_t cull_scope =
+            gpu_profiler.beginScope(cmd_buffer, "cull", false);
+        gpu_culler.record(cmd_buffer, recording_set, frustum);
+        gpu_profiler.endScope(cmd_buffer, cull_scope);
+    });
 
+    // The render pass scope covers the barrier, the load and store ops and
+    // the draws of the cube pass.
+    uint32_t render_pass_scope = GpuProfiler::c_no_scope;
+    render_graph.setHooks(
+        cube_pass,
+        [&](VkCommandBuffer cmd_buffer) {
+            render_pass_scope =
+                gpu_profiler.beginScope(cmd_buffer, "render_pass", true);
+        },
+        [&](VkCommandBuffer cmd_buffer) {
+            gpu_profiler.endScope(cmd_buffer, render_pass_scope);
+        });
+
+    // Records the cubes inside the render pass the graph begins.
+    auto record_cubes = [&](VkCommandBuffer cmd_buffer) {
         vkCmdBindPipeline(cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 
-        vkCmdBindDescriptorSets(
-            cmd_buffer,
-            VK_PIPELINE_BIND_POINT_GRAPHICS,
-            pipeline_layout,
-            0,
-            1,
-            desc_set.data(),
-            0,
-            nullptr);
-
         const VkDeviceSize offsets[1] = {0};
         vkCmdBindVertexBuffers(cmd_buffer, 0, 1, &vertex_buf, offsets);
+        vkCmdBindIndexBuffer(cmd_buffer, index_buf, 0, index_type);
 
         VkViewport viewport = {};
         viewport.height = (float)c_height;
@@ -1232,48 +2093,574 @@ int main(int argc, char** argv)
         scissor.offset.y = 0;
         vkCmdSetScissor(cmd_buffer, 0, 1, &scissor);
 
-        vkCmdDraw(cmd_buffer, 12 * 3, 1, 0, 0);
-        vkCmdEndRenderPass(cmd_buffer);
-        FAIL_IF_NOT_SUCCESS(vkEndCommandBuffer(cmd_buffer), "EndCommandBuffer");
+        // The descriptor set is never rewritten, only dynamic offsets
+        // change. Storage buffer transforms are indexed by the instance
+        // index, which firstInstance sets per draw.
+        const uint32_t draw_scope =
+            gpu_profiler.beginScope(cmd_buffer, "cube_draws", false);
+        switch (options.transforms)
+        {
+        case TransformPath::PushConstant:
+            for (const glm::mat4& mvp : object_mvps)
+            {
+                vkCmdPushConstants(
+                    cmd_buffer,
+                    pipeline_layout,
+                    VK_SHADER_STAGE_VERTEX_BIT,
+                    0,
+                    sizeof(mvp),
+                    &mvp);
+                vkCmdDrawIndexed(cmd_buffer, index_count, 1, 0, 0, 0);
+            }
+            break;
+        case TransformPath::DynamicUniform:
+            for (uint32_t uniform_offset : object_uniform_offsets)
+            {
+                vkCmdBindDescriptorSets(
+                    cmd_buffer,
+                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                    pipeline_layout,
+                    0,
+                    1,
+                    desc_set.data(),
+                    1,
+                    &uniform_offset);
+                vkCmdDrawIndexed(cmd_buffer, index_count, 1, 0, 0, 0);
+            }
+            break;
+        case TransformPath::StorageBuffer:
+            vkCmdBindDescriptorSets(
+                cmd_buffer,
+                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                pipeline_layout,
+                0,
+                1,
+                desc_set.data(),
+                1,
+                object_uniform_offsets.data());
+            for (uint32_t i = 0; i < object_mvps.size(); ++i)
+            {
+                vkCmdDrawIndexed(cmd_buffer, index_count, 1, 0, 0, i);
+            }
+            break;
+        case TransformPath::Instanced:
+            vkCmdPushConstants(
+                cmd_buffer,
+                pipeline_layout,
+                VK_SHADER_STAGE_VERTEX_BIT,
+                0,
+                sizeof(c_view_projection),
+                &c_view_projection);
+            vkCmdBindVertexBuffers(cmd_buffer, 1, 1, &instance_buf, offsets);
+            vkCmdDrawIndexed(
+                cmd_buffer, index_count, options.object_count, 0, 0, 0);
+            break;
+        case TransformPath::GpuCulled:
+        {
+            vkCmdPushConstants(
+                cmd_buffer,
+                pipeline_layout,
+                VK_SHADER_STAGE_VERTEX_BIT,
+                0,
+                sizeof(c_view_projection),
+                &c_view_projection);
+            const VkBuffer visible_buf =
+                gpu_culler.visibleInstances(recording_set);
+            vkCmdBindVertexBuffers(cmd_buffer, 1, 1, &visible_buf, offsets);
+            vkCmdDrawIndexedIndirect(
+                cmd_buffer,
+                gpu_culler.drawCommand(recording_set),
+                0,
+                1,
+                sizeof(VkDrawIndexedIndirectCommand));
+            break;
+        }
+        case TransformPath::Bindless:
+        {
+            // The draw only learns which heap buffer holds this frame's
+            // transforms, the set itself stays the same for every frame.
+            const VkDescriptorSet heap_set = bindless_heap.set();
+            vkCmdBindDescriptorSets(
+                cmd_buffer,
+                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                pipeline_layout,
+                0,
+                1,
+                &heap_set,
+                0,
+                nullptr);
+            const uint32_t transforms_index =
+                bindless_transforms[recording_set];
+            vkCmdPushConstants(
+                cmd_buffer,
+                pipeline_layout,
+                VK_SHADER_STAGE_VERTEX_BIT,
+                0,
+                sizeof(transforms_index),
+                &transforms_index);
+            vkCmdDrawIndexed(
+                cmd_buffer,
+                index_count,
+                static_cast<uint32_t>(object_mvps.size()),
+                0,
+                0,
+                0);
+            break;
+        }
+        }
+        gpu_profiler.endScope(cmd_buffer, draw_scope);
+    };
+    render_graph.setRecord(cube_pass, record_cubes);
+
+    // The graph leaves the image in TRANSFER_SRC_OPTIMAL and makes the
+    // copy visible to the host.
+    render_graph.setRecord(readback_pass, [&](VkCommandBuffer cmd_buffer) {
+        const uint32_t readback_scope =
+            gpu_profiler.beginScope(cmd_buffer, "readback", false);
+        VkBufferImageCopy readback_region = {};
+        readback_region.bufferOffset = 0;
+        readback_region.bufferRowLength = 0;
+        readback_region.bufferImageHeight = 0;
+        readback_region.imageSubresource.aspectMask =
+            VK_IMAGE_ASPECT_COLOR_BIT;
+        readback_region.imageSubresource.mipLevel = 0;
+        readback_region.imageSubresource.baseArrayLayer = 0;
+        readback_region.imageSubresource.layerCount = 1;
+        readback_region.imageExtent.width = c_width;
+        readback_region.imageExtent.height = c_height;
+        readback_region.imageExtent.depth = 1;
+        vkCmdCopyImageToBuffer(
+            cmd_buffer,
+            render_graph.image(color_resource),
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            offscreen_targets[recording_image].readback_buf,
+            1,
+            &readback_region);
+        gpu_profiler.endScope(cmd_buffer, readback_scope);
+    });
+
+    // Records the frame into the framebuffer of one swapchain image.
+    auto record_cmd_buffer = [&](VkCommandBuffer cmd_buffer,
+                                 uint32_t image_index,
+                                 uint32_t resource_set,
+                                 VkCommandBufferUsageFlags usage) -> VkResult {
+        VkCommandBufferBeginInfo cmd_buffer_begin_info = {};
+        cmd_buffer_begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        cmd_buffer_begin_info.flags = usage;
+        if (VkResult result =
+                vkBeginCommandBuffer(cmd_buffer, &cmd_buffer_begin_info);
+            result != VK_SUCCESS)
+        {
+            return result;
+        }
+
+        gpu_profiler.beginFrame(cmd_buffer, resource_set);
+
+        recording_set = resource_set;
+        recording_image = image_index;
+        render_graph.setImage(
+            color_resource,
+            color_images[image_index],
+            color_imageviews[image_index]);
+        if (VkResult result = render_graph.execute(cmd_buffer);
+            result != VK_SUCCESS)
+        {
+            return result;
+        }
+        return vkEndCommandBuffer(cmd_buffer);
+    };
+
+    // In static recording mode every swapchain image gets its own command
+    // buffer that is recorded once and resubmitted until the scene version
+    // changes. Bump scene_version on any scene or swapchain change.
+    uint64_t scene_version = 1;
+    std::vector<uint64_t> recorded_scene_versions(color_images.size(), 0);
+    std::vector<VkCommandBuffer> static_cmd_buffers;
+    if (options.static_recording)
+    {
+        VkCommandBufferAllocateInfo static_cmd_buffer_alloc_info = {};
+        static_cmd_buffer_alloc_info.sType =
+            VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        static_cmd_buffer_alloc_info.commandPool = cmd_pool;
+        static_cmd_buffer_alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        static_cmd_buffer_alloc_info.commandBufferCount =
+            static_cast<uint32_t>(color_images.size());
+
+        static_cmd_buffers.resize(color_images.size());
+        FAIL_IF_NOT_SUCCESS(
+            vkAllocateCommandBuffers(
+                device,
+                &static_cmd_buffer_alloc_info,
+                static_cmd_buffers.data()),
+            "AllocateCommandBuffers");
+    }
+
+    uint64_t recorded_frames = 0;
+    uint64_t reused_frames = 0;
+
+    std::unique_ptr<FrameWriter> frame_writer;
+    if (options.headless && !options.dump_dir.empty())
+    {
+        frame_writer = std::make_unique<FrameWriter>(
+            options.dump_dir, c_max_pending_dumped_frames);
+    }
+
+    // Called once the fence of the frame that filled the target has been
+    // waited on. Copies the pixels out of the mapped buffer, so the target
+    // can be reused while the writer thread is still busy with the file.
+    auto collect_readback = [&](OffscreenTarget& target) {
+        if (!target.readback_pending)
+        {
+            return;
+        }
+        target.readback_pending = false;
+
+        if (frame_writer)
+        {
+            const std::size_t size = c_width * c_height * 4;
+            frame_writer->write(
+                target.readback_frame_number,
+                c_width,
+                c_height,
+                std::vector<uint8_t>(
+                    target.readback_data, target.readback_data + size));
+        }
+    };
+
+    // Without --bench nothing is measured and the marks are just clock reads.
+    FrameProfiler profiler(
+        options.bench_warmup_frames, options.bench ? options.bench_frames : 0);
+
+    uint32_t frame_index = 0;
+    uint64_t frame_number = 0;
+    while (options.frame_count == 0 || frame_number < options.frame_count)
+    {
+        if (!options.headless && glfwWindowShouldClose(window))
+        {
+            break;
+        }
+
+        profiler.beginFrame();
+
+        FrameResources& frame = frames[frame_index];
+
+        // The fence only guards reuse of the slot's resources, presentation
+        // is ordered on the GPU through render_finished_semaphores. It only
+        // blocks when the GPU is more than frames_in_flight frames behind.
+        FAIL_IF_NOT_SUCCESS(
+            vkWaitForFences(
+                device, 1, &frame.in_flight_fence, VK_TRUE, UINT64_MAX),
+            "WaitForFences");
+        profiler.endStage(FrameStage::FenceWait);
+
+        // Offscreen targets map one to one onto ring slots.
+        uint32_t image_index = frame_index;
+        if (options.headless)
+        {
+            collect_readback(offscreen_targets[image_index]);
+        }
+        else
+        {
+            FAIL_IF_NOT_SUCCESS(
+                vkAcquireNextImageKHR(
+                    device,
+                    swapchain,
+                    UINT64_MAX,
+                    frame.image_acquired_semaphore,
+                    VK_NULL_HANDLE,
+                    &image_index),
+                "AcquireNextImageKHR");
+        }
+        profiler.endStage(FrameStage::Acquire);
+
+        // Images can be returned out of order, so the image may still be
+        // rendered by another slot.
+        if (images_in_flight[image_index] != VK_NULL_HANDLE &&
+            images_in_flight[image_index] != frame.in_flight_fence)
+        {
+            FAIL_IF_NOT_SUCCESS(
+                vkWaitForFences(
+                    device,
+                    1,
+                    &images_in_flight[image_index],
+                    VK_TRUE,
+                    UINT64_MAX),
+                "WaitForFences");
+        }
+        images_in_flight[image_index] = frame.in_flight_fence;
+
+        // Frame boundary: nothing recorded from here on uses the replaced
+        // pipelines, and the static command buffers are re-recorded.
+        if (shader_reloader)
+        {
+            for (const RebuiltPipeline& rebuilt :
+                 shader_reloader->takeRebuilt())
+            {
+                if (rebuilt.id == graphics_reload_id)
+                {
+                    // No-op after the first reload.
+                    pipeline_factory.release(pipeline_key);
+                }
+                VkPipeline replaced =
+                    rebuilt.id == graphics_reload_id
+                        ? std::exchange(pipeline, rebuilt.pipeline)
+                        : gpu_culler.swapPipeline(rebuilt.pipeline);
+                retired_pipelines.push_back(
+                    {replaced, frame_number + options.frames_in_flight});
+                ++scene_version;
+            }
+            while (!retired_pipelines.empty() &&
+                   retired_pipelines.front().destroy_frame <= frame_number)
+            {
+                vkDestroyPipeline(
+                    device, retired_pipelines.front().pipeline, nullptr);
+                retired_pipelines.pop_front();
+            }
+        }
+
+        FAIL_IF_NOT_SUCCESS(
+            vkResetFences(device, 1, &frame.in_flight_fence), "ResetFences");
+        profiler.endStage(FrameStage::FenceWait);
+
+        // Per-frame GPU resources follow the command buffer. Both waits
+        // above guarantee its previous submission has finished, so they can
+        // be read back and rewritten without stalling.
+        const uint32_t resource_set =
+            options.static_recording ? image_index : frame_index;
+        gpu_profiler.collect(resource_set);
+
+        // Only visible objects get an MVP, so every draw loop below skips
+        // culled objects without further checks.
+        if (options.cpu_cull)
+        {
+            cpu_culler.cull(
+                frustum,
+                object_volumes,
+                CullVolume::Box,
+                options.cull_isa,
+                visible_objects);
+        }
+        if (!instanced)
+        {
+            object_mvps.resize(visible_objects.size());
+            for (std::size_t i = 0; i < visible_objects.size(); ++i)
+            {
+                object_mvps[i] =
+                    c_view_projection * object_transforms[visible_objects[i]];
+            }
+        }
+
+        // With static recording the offsets come out the same every frame,
+        // so the recorded command buffers stay valid. Push constants are
+        // part of the recording and only change when it is re-recorded.
+        if (options.transforms == TransformPath::DynamicUniform)
+        {
+            uniform_ring.beginRegion(resource_set);
+            object_uniform_offsets.resize(object_mvps.size());
+            for (std::size_t i = 0; i < object_mvps.size(); ++i)
+            {
+                auto[pushed, uniform_offset] =
+                    uniform_ring.push(object_mvps[i]);
+                if (!pushed)
+                {
+                    std::cerr << "Uniform ring region overflow." << std::endl;
+                    return EXIT_FAILURE;
+                }
+                object_uniform_offsets[i] = uniform_offset;
+            }
+        }
+        else if (storage_transforms)
+        {
+            uniform_ring.beginRegion(resource_set);
+            auto[transforms_data, transforms_offset] =
+                uniform_ring.allocate(transform_range);
+            if (transforms_data == nullptr)
+            {
+                std::cerr << "Uniform ring region overflow." << std::endl;
+                return EXIT_FAILURE;
+            }
+            std::memcpy(
+                transforms_data,
+                object_mvps.data(),
+                object_mvps.size() * sizeof(glm::mat4));
+            object_uniform_offsets[0] = transforms_offset;
+        }
+
+        VkSemaphore render_finished_semaphore =
+            options.headless ? VK_NULL_HANDLE
+                             : render_finished_semaphores[image_index];
+
+        // Neither buffer is pending here: the slot fence and the image fence
+        // have both been waited on above.
+        VkCommandBuffer cmd_buffer = frame.cmd_buffer;
+        if (options.static_recording)
+        {
+            cmd_buffer = static_cmd_buffers[image_index];
+            if (recorded_scene_versions[image_index] != scene_version)
+            {
+                FAIL_IF_NOT_SUCCESS(
+                    record_cmd_buffer(cmd_buffer, image_index, resource_set, 0),
+                    "RecordCommandBuffer");
+                recorded_scene_versions[image_index] = scene_version;
+                ++recorded_frames;
+            }
+            else
+            {
+                ++reused_frames;
+            }
+        }
+        else
+        {
+            FAIL_IF_NOT_SUCCESS(
+                record_cmd_buffer(
+                    cmd_buffer,
+                    image_index,
+                    resource_set,
+                    VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT),
+                "RecordCommandBuffer");
+            ++recorded_frames;
+        }
+        profiler.endStage(FrameStage::Record);
 
         VkCommandBuffer cmd_bufs[] = {cmd_buffer};
         VkPipelineStageFlags pipe_stage_flags =
-            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
         VkSubmitInfo submit_info[1] = {};
         submit_info[0].sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submit_info[0].waitSemaphoreCount = 1;
-        submit_info[0].pWaitSemaphores = &image_acquired_semaphore;
+        submit_info[0].waitSemaphoreCount = options.headless ? 0 : 1;
+        submit_info[0].pWaitSemaphores = &frame.image_acquired_semaphore;
         submit_info[0].pWaitDstStageMask = &pipe_stage_flags;
         submit_info[0].commandBufferCount = 1;
         submit_info[0].pCommandBuffers = cmd_bufs;
-        submit_info[0].signalSemaphoreCount = 0;
-        submit_info[0].pSignalSemaphores = nullptr;
+        submit_info[0].signalSemaphoreCount = options.headless ? 0 : 1;
+        submit_info[0].pSignalSemaphores = &render_finished_semaphore;
         FAIL_IF_NOT_SUCCESS(
-            vkQueueSubmit(graphic_queue, 1, submit_info, draw_fence),
+            vkQueueSubmit(graphic_queue, 1, submit_info, frame.in_flight_fence),
             "QueueSubmit");
+        gpu_profiler.submitted(resource_set);
+        profiler.endStage(FrameStage::Submit);
 
-        VkResult wait_result;
-        do
-        {
-            wait_result =
-                vkWaitForFences(device, 1, &draw_fence, VK_TRUE, 100000000);
-        } while (wait_result == VK_TIMEOUT);
-
-        VkPresentInfoKHR present = {};
-        present.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        present.swapchainCount = 1;
-        present.pSwapchains = &swapchain;
-        present.pImageIndices = &image_index;
-        present.pWaitSemaphores = nullptr;
-        present.waitSemaphoreCount = 0;
-        present.pResults = nullptr;
-        FAIL_IF_NOT_SUCCESS(
-            vkQueuePresentKHR(present_queue, &present), "QueuePresentKHR");
+        if (options.headless)
+        {
+            offscreen_targets[image_index].readback_pending = true;
+            offscreen_targets[image_index].readback_frame_number = frame_number;
+        }
+        else
+        {
+            VkPresentInfoKHR present = {};
+            present.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+            present.swapchainCount = 1;
+            present.pSwapchains = &swapchain;
+            present.pImageIndices = &image_index;
+            present.pWaitSemaphores = &render_finished_semaphore;
+            present.waitSemaphoreCount = 1;
+            present.pResults = nullptr;
+            FAIL_IF_NOT_SUCCESS(
+                vkQueuePresentKHR(present_queue, &present), "QueuePresentKHR");
+
+            glfwPollEvents();
+        }
+        profiler.endStage(FrameStage::Present);
+        profiler.endFrame();
+
+        frame_index = (frame_index + 1) % options.frames_in_flight;
+        ++frame_number;
+    }
+
+    FAIL_IF_NOT_SUCCESS(vkDeviceWaitIdle(device), "DeviceWaitIdle");
+
+    shader_reloader.reset();
+    for (const RetiredPipeline& retired : retired_pipelines)
+    {
+        vkDestroyPipeline(device, retired.pipeline, nullptr);
+    }
+
+    // Picks up the pipelines of hot reloads.
+    if (!options.pipeline_cache_path.empty() && !pipeline_cache.save())
+    {
+        std::cerr << "Failed to save the pipeline cache." << std::endl;
+    }
 
-        vkDestroySemaphore(device, image_acquired_semaphore, NULL);
-        vkDestroyFence(device, draw_fence, NULL);
+    for (auto& target : offscreen_targets)
+    {
+        collect_readback(target);
+    }
+
+    if (gpu_profiler.enabled())
+    {
+        for (uint32_t set = 0; set < gpu_profiler.setsNum(); ++set)
+        {
+            gpu_profiler.collect(set);
+        }
+        gpu_profiler.writeSummary(diagnostics);
+        gpu_profiler.destroy();
+    }
 
-        glfwPollEvents();
+    if (frame_writer)
+    {
+        frame_writer->finish();
+        diagnostics << "Dumped frames: " << frame_writer->writtenFrames()
+                    << ", failed: " << frame_writer->failedFrames()
+                    << std::endl;
+    }
+
+    diagnostics << "Frames: " << recorded_frames + reused_frames
+                << ", recorded: " << recorded_frames
+                << ", reused recording: " << reused_frames << std::endl;
+    memory_allocator.writeStats(diagnostics);
+    layout_cache.writeStats(diagnostics);
+    descriptor_sets.writeStats(diagnostics);
+    render_graph.writeStats(diagnostics);
+    if (bindless)
+    {
+        bindless_heap.writeStats(diagnostics);
+    }
+    pipeline_factory.writeStats(diagnostics);
+    staging_uploader.writeStats(diagnostics);
+
+    if (options.bench)
+    {
+        const std::vector<std::pair<std::string, std::string>> properties = {
+            {"sample", "14-draw-cube"},
+            {"device", physical_device_props.deviceName},
+            {"mode", options.headless ? "headless" : "windowed"},
+            {"frames_in_flight", std::to_string(options.frames_in_flight)},
+            {"objects", std::to_string(options.object_count)},
+            {"transforms", toString(options.transforms)},
+            {"vertex_format", toString(options.vertex_positions)},
+            {"cpu_cull",
+             options.cpu_cull ? toString(options.cull_isa) : "off"},
+            {"static_recording", options.static_recording ? "true" : "false"},
+            {"pipeline_cache", pipeline_cache_state},
+            {"pipeline_create_ms", std::to_string(pipeline_create_ms.count())},
+        };
+
+        if (options.bench_output.empty())
+        {
+            profiler.writeJsonReport(std::cout, properties);
+        }
+        else
+        {
+            std::ofstream bench_output(options.bench_output);
+            profiler.writeJsonReport(bench_output, properties);
+            if (!bench_output)
+            {
+                std::cerr << "Failed to write '" << options.bench_output
+                          << "'." << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    for (auto semaphore : render_finished_semaphores)
+    {
+        vkDestroySemaphore(device, semaphore, nullptr);
+    }
+
+    for (auto& frame : frames)
+    {
+        vkDestroySemaphore(device, frame.image_acquired_semaphore, nullptr);
+        vkDestroyFence(device, frame.in_flight_fence, nullptr);
     }
 
     return EXIT_SUCCESS;
@@ -0,0 +1,475 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "memory_allocator.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace {
+
+VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+    return alignment <= 1 ? value
+                          : (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+std::pair<bool, uint32_t> findMemoryType(
+    const VkPhysicalDeviceMemoryProperties& mem_props,
+    uint32_t type_bits,
+    VkMemoryPropertyFlags required,
+    VkMemoryPropertyFlags preferred)
+{
+    const VkMemoryPropertyFlags wanted[] = {required | preferred, required};
+    for (VkMemoryPropertyFlags flags : wanted)
+    {
+        for (uint32_t i = 0; i < mem_props.memoryTypeCount; ++i)
+        {
+            if ((type_bits & (1u << i)) != 0 &&
+                (mem_props.memoryTypes[i].propertyFlags & flags) == flags)
+            {
+                return {true, i};
+            }
+        }
+    }
+    return {false, std::numeric_limits<uint32_t>::max()};
+}
+
+BlockSubAllocator::BlockSubAllocator(VkDeviceSize size)
+    : size_(size)
+{
+    if (size_ > 0)
+    {
+        free_ranges_.emplace(0, size_);
+    }
+}
+
+std::pair<bool, VkDeviceSize> BlockSubAllocator::allocate(
+    VkDeviceSize size, VkDeviceSize alignment)
+{
+    if (size == 0)
+    {
+        return {false, 0};
+    }
+
+    auto best = free_ranges_.end();
+    VkDeviceSize best_offset = 0;
+    VkDeviceSize best_leftover = std::numeric_limits<VkDeviceSize>::max();
+    for (auto it = free_ranges_.begin(); it != free_ranges_.end(); ++it)
+    {
+        const VkDeviceSize offset = alignUp(it->first, alignment);
+        const VkDeviceSize range_end = it->first + it->second;
+        if (offset >= range_end || range_end - offset < size)
+        {
+            continue;
+        }
+        const VkDeviceSize leftover = range_end - offset - size;
+        if (leftover < best_leftover)
+        {
+            best = it;
+            best_offset = offset;
+            best_leftover = leftover;
+        }
+    }
+
+    if (best == free_ranges_.end())
+    {
+        return {false, 0};
+    }
+
+    // Alignment padding in front and the tail stay free.
+    const VkDeviceSize range_offset = best->first;
+    const VkDeviceSize range_end = best->first + best->second;
+    free_ranges_.erase(best);
+    if (best_offset > range_offset)
+    {
+        free_ranges_.emplace(range_offset, best_offset - range_offset);
+    }
+    if (best_offset + size < range_end)
+    {
+        free_ranges_.emplace(
+            best_offset + size, range_end - best_offset - size);
+    }
+
+    allocations_.emplace(best_offset, size);
+    used_ += size;
+    return {true, best_offset};
+}
+
+void BlockSubAllocator::free(VkDeviceSize offset)
+{
+    auto allocation = allocations_.find(offset);
+    if (allocation == allocations_.end())
+    {
+        return;
+    }
+
+    VkDeviceSize range_offset = allocation->first;
+    VkDeviceSize range_size = allocation->second;
+    used_ -= range_size;
+    allocations_.erase(allocation);
+
+    auto next = free_ranges_.lower_bound(range_offset);
+    if (next != free_ranges_.begin())
+    {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == range_offset)
+        {
+            range_offset = prev->first;
+            range_size += prev->second;
+            free_ranges_.erase(prev);
+        }
+    }
+    if (next != free_ranges_.end() && range_offset + range_size == next->first)
+    {
+        range_size += next->second;
+        free_ranges_.erase(next);
+    }
+    free_ranges_.emplace(range_offset, range_size);
+}
+
+VkDeviceSize BlockSubAllocator::largestFreeRange() const
+{
+    VkDeviceSize largest = 0;
+    for (const auto& range : free_ranges_)
+    {
+        largest = std::max(largest, range.second);
+    }
+    return largest;
+}
+
+double MemoryAllocatorStats::fragmentation() const
+{
+    const VkDeviceSize free_bytes = reserved_bytes - used_bytes;
+    if (free_bytes == 0)
+    {
+        return 0.0;
+    }
+    return 1.0 - static_cast<double>(largest_free_range) /
+                     static_cast<double>(free_bytes);
+}
+
+MemoryAllocator::MemoryAllocator(
+    VkDevice device,
+    const VkPhysicalDeviceMemoryProperties& mem_props,
+    const VkPhysicalDeviceLimits& limits,
+    VkDeviceSize block_size)
+    : device_(device)
+    , mem_props_(mem_props)
+    , buffer_image_granularity_(std::max<VkDeviceSize>(
+          limits.bufferImageGranularity, 1))
+    , max_allocations_num_(limits.maxMemoryAllocationCount)
+    , block_size_(block_size)
+    , blocks_(mem_props.memoryTypeCount)
+{
+}
+
+MemoryAllocator::~MemoryAllocator()
+{
+    for (const auto& type_blocks : blocks_)
+    {
+        for (const auto& block : type_blocks)
+        {
+            destroyBlock(*block);
+        }
+    }
+}
+
+VkResult MemoryAllocator::allocate(
+    const VkMemoryRequirements& mem_reqs,
+    VkMemoryPropertyFlags required,
+    VkMemoryPropertyFlags preferred,
+    bool optimal_image,
+    MemoryAllocation& allocation)
+{
+    VkDeviceSize size = mem_reqs.size;
+    VkDeviceSize alignment = std::max<VkDeviceSize>(mem_reqs.alignment, 1);
+    if (optimal_image)
+    {
+        size = alignUp(size, buffer_image_granularity_);
+        alignment = std::max(alignment, buffer_image_granularity_);
+    }
+
+    VkResult result = VK_ERROR_FEATURE_NOT_PRESENT;
+    uint32_t tried_types = 0;
+    const VkMemoryPropertyFlags wanted[] = {required | preferred, required};
+    for (VkMemoryPropertyFlags flags : wanted)
+    {
+        for (uint32_t i = 0; i < mem_props_.memoryTypeCount; ++i)
+        {
+            if ((mem_reqs.memoryTypeBits & (1u << i)) == 0 ||
+                (tried_types & (1u << i)) != 0 ||
+                (mem_props_.memoryTypes[i].propertyFlags & flags) != flags)
+            {
+                continue;
+            }
+            tried_types |= 1u << i;
+
+            result = allocateFromType(i, size, alignment, allocation);
+            if (result != VK_ERROR_OUT_OF_DEVICE_MEMORY &&
+                result != VK_ERROR_TOO_MANY_OBJECTS)
+            {
+                return result;
+            }
+        }
+    }
+    return result;
+}
+
+VkResult MemoryAllocator::allocateBuffer(
+    VkBuffer buffer,
+    VkMemoryPropertyFlags required,
+    VkMemoryPropertyFlags preferred,
+    MemoryAllocation& allocation)
+{
+    VkMemoryRequirements mem_reqs = {};
+    vkGetBufferMemoryRequirements(device_, buffer, &mem_reqs);
+
+    if (VkResult result =
+            allocate(mem_reqs, required, preferred, false, allocation);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+    return vkBindBufferMemory(
+        device_, buffer, allocation.memory, allocation.offset);
+}
+
+VkResult MemoryAllocator::allocateImage(
+    VkImage image,
+    VkImageTiling tiling,
+    VkMemoryPropertyFlags required,
+    VkMemoryPropertyFlags preferred,
+    MemoryAllocation& allocation)
+{
+    VkMemoryRequirements mem_reqs = {};
+    vkGetImageMemoryRequirements(device_, image, &mem_reqs);
+
+    if (VkResult result = allocate(
+            mem_reqs,
+            required,
+            preferred,
+            tiling == VK_IMAGE_TILING_OPTIMAL,
+            allocation);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+    return vkBindImageMemory(
+        device_, image, allocation.memory, allocation.offset);
+}
+
+void MemoryAllocator::free(MemoryAllocation& allocation)
+{
+    if (allocation.memory == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    auto& type_blocks = blocks_[allocation.memory_type_index];
+    auto block = std::find_if(
+        type_blocks.begin(), type_blocks.end(), [&](const auto& b) {
+            return b->memory == allocation.memory;
+        });
+    if (block != type_blocks.end())
+    {
+        (*block)->sub_allocator.free(allocation.offset);
+
+        // One empty block per type is kept around to avoid churn.
+        if ((*block)->sub_allocator.empty() && type_blocks.size() > 1)
+        {
+            destroyBlock(**block);
+            type_blocks.erase(block);
+        }
+    }
+    allocation = {};
+}
+
+MemoryAllocatorStats MemoryAllocator::stats() const
+{
+    MemoryAllocatorStats stats;
+    for (const auto& type_blocks : blocks_)
+    {
+        for (const auto& block : type_blocks)
+        {
+            addStats(*block, stats);
+        }
+    }
+    return stats;
+}
+
+void MemoryAllocator::writeStats(std::ostream& out) const
+{
+    for (uint32_t i = 0; i < blocks_.size(); ++i)
+    {
+        if (blocks_[i].empty())
+        {
+            continue;
+        }
+
+        MemoryAllocatorStats type_stats;
+        for (const auto& block : blocks_[i])
+        {
+            addStats(*block, type_stats);
+        }
+        out << "Memory type " << i << " (flags 0x" << std::hex
+            << mem_props_.memoryTypes[i].propertyFlags << std::dec
+            << "): blocks: " << type_stats.blocks_num
+            << ", allocations: " << type_stats.allocations_num
+            << ", used: " << type_stats.used_bytes << " / "
+            << type_stats.reserved_bytes << " bytes"
+            << ", free ranges: " << type_stats.free_ranges_num
+            << ", fragmentation: " << type_stats.fragmentation();
+        // Lazily allocated memory is only backed as far as the device had to,
+        // the rest of the reserved bytes never take up physical memory.
+        if (mem_props_.memoryTypes[i].propertyFlags &
+            VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+        {
+            VkDeviceSize committed_bytes = 0;
+            for (const auto& block : blocks_[i])
+            {
+                VkDeviceSize block_committed = 0;
+                vkGetDeviceMemoryCommitment(
+                    device_, block->memory, &block_committed);
+                committed_bytes += block_committed;
+            }
+            out << ", committed: " << committed_bytes << " bytes";
+        }
+        out << std::endl;
+    }
+}
+
+VkResult MemoryAllocator::allocateFromType(
+    uint32_t type_index,
+    VkDeviceSize size,
+    VkDeviceSize alignment,
+    MemoryAllocation& allocation)
+{
+    auto& type_blocks = blocks_[type_index];
+
+    auto try_block = [&](Block& block) {
+        auto[found, offset] = block.sub_allocator.allocate(size, alignment);
+        if (!found)
+        {
+            return false;
+        }
+        allocation.memory = block.memory;
+        allocation.offset = offset;
+        allocation.size = size;
+        allocation.memory_type_index = type_index;
+        allocation.mapped = block.mapped ? block.mapped + offset : nullptr;
+        return true;
+    };
+
+    for (const auto& block : type_blocks)
+    {
+        if (try_block(*block))
+        {
+            return VK_SUCCESS;
+        }
+    }
+
+    if (VkResult result = createBlock(type_index, size); result != VK_SUCCESS)
+    {
+        return result;
+    }
+    return try_block(*type_blocks.back()) ? VK_SUCCESS
+                                          : VK_ERROR_OUT_OF_DEVICE_MEMORY;
+}
+
+VkResult MemoryAllocator::createBlock(
+    uint32_t type_index, VkDeviceSize min_size)
+{
+    if (device_allocations_num_ >= max_allocations_num_)
+    {
+        return VK_ERROR_TOO_MANY_OBJECTS;
+    }
+
+    // Small heaps like the 256 MiB BAR window would be exhausted by a few
+    // default sized blocks. Lazily allocated memory only backs transient
+    // attachments, which are sized up front, so its blocks fit exactly.
+    const VkMemoryType& mem_type = mem_props_.memoryTypes[type_index];
+    const VkDeviceSize heap_size =
+        mem_props_.memoryHeaps[mem_type.heapIndex].size;
+    const VkDeviceSize min_block_size =
+        alignUp(min_size, buffer_image_granularity_);
+    const VkDeviceSize block_size =
+        (mem_type.propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+            ? min_block_size
+            : std::max(min_block_size, std::min(block_size_, heap_size / 8));
+
+    VkMemoryAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = block_size;
+    alloc_info.memoryTypeIndex = type_index;
+
+    auto block = std::make_unique<Block>(block_size);
+    if (VkResult result =
+            vkAllocateMemory(device_, &alloc_info, nullptr, &block->memory);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+    ++device_allocations_num_;
+
+    if (mem_type.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+    {
+        void* mapped = nullptr;
+        if (VkResult result = vkMapMemory(
+                device_, block->memory, 0, VK_WHOLE_SIZE, 0, &mapped);
+            result != VK_SUCCESS)
+        {
+            destroyBlock(*block);
+            return result;
+        }
+        block->mapped = static_cast<uint8_t*>(mapped);
+    }
+
+    blocks_[type_index].push_back(std::move(block));
+    return VK_SUCCESS;
+}
+
+void MemoryAllocator::destroyBlock(const Block& block)
+{
+    // Freeing implicitly unmaps.
+    vkFreeMemory(device_, block.memory, nullptr);
+    --device_allocations_num_;
+}
+
+void MemoryAllocator::addStats(const Block& block, MemoryAllocatorStats& stats)
+{
+    const BlockSubAllocator& sub_allocator = block.sub_allocator;
+    ++stats.blocks_num;
+    stats.allocations_num +=
+        static_cast<uint32_t>(sub_allocator.allocationsNum());
+    stats.reserved_bytes += sub_allocator.size();
+    stats.used_bytes += sub_allocator.usedSize();
+    stats.free_ranges_num +=
+        static_cast<uint32_t>(sub_allocator.freeRangesNum());
+    stats.largest_free_range =
+        std::max(stats.largest_free_range, sub_allocator.largestFreeRange());
+}
@@ -0,0 +1,188 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+/**
+ * Finds a memory type allowed by type_bits that has all required flags.
+ * Types that also have all preferred flags win over the rest.
+ */
+std::pair<bool, uint32_t> findMemoryType(
+    const VkPhysicalDeviceMemoryProperties& mem_props,
+    uint32_t type_bits,
+    VkMemoryPropertyFlags required,
+    VkMemoryPropertyFlags preferred);
+
+/**
+ * Offset bookkeeping of a single memory block: a best fit free list with
+ * coalescing of neighbouring free ranges. Makes no Vulkan calls.
+ */
+class BlockSubAllocator
+{
+public:
+    explicit BlockSubAllocator(VkDeviceSize size);
+
+    /** Returns the offset of the range, aligned to alignment. */
+    std::pair<bool, VkDeviceSize> allocate(
+        VkDeviceSize size, VkDeviceSize alignment);
+    void free(VkDeviceSize offset);
+
+    VkDeviceSize size() const { return size_; }
+    VkDeviceSize usedSize() const { return used_; }
+    std::size_t allocationsNum() const { return allocations_.size(); }
+    std::size_t freeRangesNum() const { return free_ranges_.size(); }
+    VkDeviceSize largestFreeRange() const;
+    bool empty() const { return allocations_.empty(); }
+
+private:
+    const VkDeviceSize size_;
+    VkDeviceSize used_ = 0;
+    // Offset to size, both maps are ordered by offset.
+    std::map<VkDeviceSize, VkDeviceSize> free_ranges_;
+    std::map<VkDeviceSize, VkDeviceSize> allocations_;
+};
+
+struct MemoryAllocation
+{
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+    uint32_t memory_type_index = 0;
+    // Persistently mapped pointer to offset, null unless host visible.
+    uint8_t* mapped = nullptr;
+};
+
+struct MemoryAllocatorStats
+{
+    uint32_t blocks_num = 0;
+    uint32_t allocations_num = 0;
+    VkDeviceSize reserved_bytes = 0;
+    VkDeviceSize used_bytes = 0;
+    uint32_t free_ranges_num = 0;
+    VkDeviceSize largest_free_range = 0;
+
+    /**
+     * 0 when all free memory is one contiguous range, approaches 1 as it
+     * gets split into many small ranges.
+     */
+    double fragmentation() const;
+};
+
+/**
+ * Carves buffers and images out of large VkDeviceMemory blocks, one list
+ * of blocks per memory type.
+ *
+ * bufferImageGranularity is honoured by giving optimal tiling images whole
+ * granularity pages: they start on a page boundary and their size is rounded
+ * up to one, so no linear resource can share a page with them.
+ */
+class MemoryAllocator
+{
+public:
+    static constexpr VkDeviceSize c_default_block_size = 64 * 1024 * 1024;
+
+    MemoryAllocator(
+        VkDevice device,
+        const VkPhysicalDeviceMemoryProperties& mem_props,
+        const VkPhysicalDeviceLimits& limits,
+        VkDeviceSize block_size = c_default_block_size);
+    ~MemoryAllocator();
+
+    MemoryAllocator(const MemoryAllocator&) = delete;
+    MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+
+    /**
+     * Types with the preferred flags are tried first, the rest of the types
+     * with the required flags are a fallback when those run out of memory.
+     */
+    VkResult allocate(
+        const VkMemoryRequirements& mem_reqs,
+        VkMemoryPropertyFlags required,
+        VkMemoryPropertyFlags preferred,
+        bool optimal_image,
+        MemoryAllocation& allocation);
+
+    /** Allocates memory for the buffer and binds it. */
+    VkResult allocateBuffer(
+        VkBuffer buffer,
+        VkMemoryPropertyFlags required,
+        VkMemoryPropertyFlags preferred,
+        MemoryAllocation& allocation);
+
+    /** Allocates memory for the image and binds it. */
+    VkResult allocateImage(
+        VkImage image,
+        VkImageTiling tiling,
+        VkMemoryPropertyFlags required,
+        VkMemoryPropertyFlags preferred,
+        MemoryAllocation& allocation);
+
+    void free(MemoryAllocation& allocation);
+
+    const VkPhysicalDeviceMemoryProperties& memoryProperties() const
+    {
+        return mem_props_;
+    }
+
+    MemoryAllocatorStats stats() const;
+    /** Writes the stats of every memory type that has blocks. */
+    void writeStats(std::ostream& out) const;
+
+private:
+    struct Block
+    {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        uint8_t* mapped = nullptr;
+        BlockSubAllocator sub_allocator;
+
+        explicit Block(VkDeviceSize size) : sub_allocator(size) {}
+    };
+
+    VkResult allocateFromType(
+        uint32_t type_index,
+        VkDeviceSize size,
+        VkDeviceSize alignment,
+        MemoryAllocation& allocation);
+    VkResult createBlock(uint32_t type_index, VkDeviceSize min_size);
+    void destroyBlock(const Block& block);
+    static void addStats(const Block& block, MemoryAllocatorStats& stats);
+
+    VkDevice device_;
+    const VkPhysicalDeviceMemoryProperties mem_props_;
+    const VkDeviceSize buffer_image_granularity_;
+    const uint32_t max_allocations_num_;
+    const VkDeviceSize block_size_;
+
+    std::vector<std::vector<std::unique_ptr<Block>>> blocks_;
+    uint32_t device_allocations_num_ = 0;
+};
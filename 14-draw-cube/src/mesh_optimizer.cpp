@@ -0,0 +1,286 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "file_utils.h"
+
+namespace {
+
+constexpr uint32_t c_no_vertex = std::numeric_limits<uint32_t>::max();
+
+/** Triangles using each vertex, in compressed row storage. */
+struct Adjacency
+{
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> triangles;
+
+    Adjacency(const std::vector<uint32_t>& indices, std::size_t vertex_count)
+        : offsets(vertex_count + 1, 0)
+        , triangles(indices.size())
+    {
+        for (uint32_t index : indices)
+        {
+            ++offsets[index + 1];
+        }
+        for (std::size_t v = 0; v < vertex_count; ++v)
+        {
+            offsets[v + 1] += offsets[v];
+        }
+
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+};
+
+} // namespace
+
+void generateIndexBuffer(
+    const void* vertices,
+    std::size_t vertex_count,
+    std::size_t vertex_size,
+    std::vector<uint8_t>& unique_vertices,
+    std::vector<uint32_t>& indices)
+{
+    const auto* data = static_cast<const uint8_t*>(vertices);
+
+    // Open addressing table of unique vertex numbers, at most half full.
+    std::size_t table_size = 1;
+    while (table_size < vertex_count * 2)
+    {
+        table_size *= 2;
+    }
+    std::vector<uint32_t> table(table_size, c_no_vertex);
+
+    unique_vertices.clear();
+    indices.resize(vertex_count);
+    uint32_t unique_count = 0;
+    for (std::size_t i = 0; i < vertex_count; ++i)
+    {
+        const uint8_t* vertex = data + i * vertex_size;
+        std::size_t slot = fnv1a(vertex, vertex_size) & (table_size - 1);
+        while (table[slot] != c_no_vertex &&
+               std::memcmp(
+                   unique_vertices.data() + table[slot] * vertex_size,
+                   vertex,
+                   vertex_size) != 0)
+        {
+            slot = (slot + 1) & (table_size - 1);
+        }
+
+        if (table[slot] == c_no_vertex)
+        {
+            table[slot] = unique_count++;
+            unique_vertices.insert(
+                unique_vertices.end(), vertex, vertex + vertex_size);
+        }
+        indices[i] = table[slot];
+    }
+}
+
+void optimizeVertexCache(
+    std::vector<uint32_t>& indices,
+    std::size_t vertex_count,
+    uint32_t cache_size)
+{
+    const std::size_t triangle_count = indices.size() / 3;
+    if (triangle_count == 0 || vertex_count == 0)
+    {
+        return;
+    }
+
+    const Adjacency adjacency(indices, vertex_count);
+
+    std::vector<uint32_t> live_triangles(vertex_count);
+    for (std::size_t v = 0; v < vertex_count; ++v)
+    {
+        live_triangles[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+    }
+
+    // A vertex is in the cache while time - cache_time[v] <= cache_size.
+    std::vector<uint32_t> cache_time(vertex_count, 0);
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<uint32_t> dead_end;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+
+    uint32_t time = cache_size + 1;
+    std::size_t cursor = 0;
+    uint32_t fanning = 0;
+
+    while (fanning != c_no_vertex)
+    {
+        candidates.clear();
+
+        // Emit all remaining triangles around the fanning vertex.
+        for (uint32_t k = adjacency.offsets[fanning];
+             k < adjacency.offsets[fanning + 1];
+             ++k)
+        {
+            const uint32_t triangle = adjacency.triangles[k];
+            if (emitted[triangle])
+            {
+                continue;
+            }
+            emitted[triangle] = true;
+
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t v = indices[triangle * 3 + corner];
+                result.push_back(v);
+                dead_end.push_back(v);
+                candidates.push_back(v);
+                --live_triangles[v];
+                if (time - cache_time[v] > cache_size)
+                {
+                    cache_time[v] = time++;
+                }
+            }
+        }
+
+        // Next fanning vertex: the oldest candidate that stays in the
+        // cache while its remaining triangles are emitted.
+        uint32_t next = c_no_vertex;
+        int64_t best_priority = -1;
+        for (uint32_t v : candidates)
+        {
+            if (live_triangles[v] == 0)
+            {
+                continue;
+            }
+            int64_t priority = 0;
+            if (time - cache_time[v] + 2 * live_triangles[v] <= cache_size)
+            {
+                priority = time - cache_time[v];
+            }
+            if (priority > best_priority)
+            {
+                best_priority = priority;
+                next = v;
+            }
+        }
+
+        // Dead end: fall back to recently used vertices, then scan for any
+        // vertex with triangles left.
+        while (next == c_no_vertex && !dead_end.empty())
+        {
+            const uint32_t v = dead_end.back();
+            dead_end.pop_back();
+            if (live_triangles[v] > 0)
+            {
+                next = v;
+            }
+        }
+        while (next == c_no_vertex && cursor < vertex_count)
+        {
+            if (live_triangles[cursor] > 0)
+            {
+                next = static_cast<uint32_t>(cursor);
+            }
+            ++cursor;
+        }
+
+        fanning = next;
+    }
+
+    indices = std::move(result);
+}
+
+std::size_t optimizeVertexFetch(
+    std::vector<uint32_t>& indices,
+    std::vector<uint8_t>& vertices,
+    std::size_t vertex_size)
+{
+    const std::size_t vertex_count = vertices.size() / vertex_size;
+    std::vector<uint32_t> remap(vertex_count, c_no_vertex);
+    std::vector<uint8_t> reordered;
+    reordered.reserve(vertices.size());
+
+    uint32_t next_vertex = 0;
+    for (uint32_t& index : indices)
+    {
+        if (remap[index] == c_no_vertex)
+        {
+            remap[index] = next_vertex++;
+            const uint8_t* vertex = vertices.data() + index * vertex_size;
+            reordered.insert(reordered.end(), vertex, vertex + vertex_size);
+        }
+        index = remap[index];
+    }
+
+    vertices = std::move(reordered);
+    return next_vertex;
+}
+
+VertexCacheStats analyzeVertexCache(
+    const std::vector<uint32_t>& indices,
+    std::size_t vertex_count,
+    uint32_t cache_size)
+{
+    VertexCacheStats stats;
+    stats.triangles = static_cast<uint32_t>(indices.size() / 3);
+
+    // FIFO cache: a vertex is cached while fewer than cache_size misses
+    // happened since it was loaded.
+    std::vector<uint32_t> loaded_at(vertex_count, c_no_vertex);
+    std::vector<bool> referenced(vertex_count, false);
+    for (uint32_t index : indices)
+    {
+        if (!referenced[index])
+        {
+            referenced[index] = true;
+            ++stats.vertices;
+        }
+        if (loaded_at[index] == c_no_vertex ||
+            stats.misses - loaded_at[index] > cache_size)
+        {
+            loaded_at[index] = stats.misses++;
+        }
+    }
+
+    if (stats.triangles > 0)
+    {
+        stats.acmr = static_cast<double>(stats.misses) / stats.triangles;
+    }
+    if (stats.vertices > 0)
+    {
+        stats.atvr = static_cast<double>(stats.misses) / stats.vertices;
+    }
+    return stats;
+}
+
+bool fitsShortIndices(std::size_t vertex_count)
+{
+    // Indices run up to vertex_count - 1; 0xFFFF stays free, it is the
+    // primitive restart index.
+    return vertex_count <= std::numeric_limits<uint16_t>::max();
+}
@@ -0,0 +1,88 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * CPU side mesh processing for indexed drawing. Vertices are handled as
+ * opaque blobs of vertex_size bytes, so any interleaved layout works.
+ */
+
+constexpr uint32_t c_default_vertex_cache_size = 16;
+
+struct VertexCacheStats
+{
+    uint32_t triangles = 0;
+    uint32_t vertices = 0;
+    // Simulated FIFO post-transform cache misses, i.e. vertex shader runs.
+    uint32_t misses = 0;
+    // Average cache miss ratio: misses per triangle, 0.5 is ideal for
+    // large grids and 3 means no reuse at all.
+    double acmr = 0.0;
+    // Average transformed vertex ratio: misses per vertex, 1 is ideal.
+    double atvr = 0.0;
+};
+
+/**
+ * Welds bitwise identical vertices of a non-indexed triangle list. Writes
+ * the unique vertices in first-use order and one index per input vertex.
+ */
+void generateIndexBuffer(
+    const void* vertices,
+    std::size_t vertex_count,
+    std::size_t vertex_size,
+    std::vector<uint8_t>& unique_vertices,
+    std::vector<uint32_t>& indices);
+
+/**
+ * Reorders triangles for post-transform vertex cache hits with Tipsify
+ * (Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced
+ * Overdraw"), which runs in linear time.
+ */
+void optimizeVertexCache(
+    std::vector<uint32_t>& indices,
+    std::size_t vertex_count,
+    uint32_t cache_size = c_default_vertex_cache_size);
+
+/**
+ * Reorders vertices in the order the indices first reference them, so
+ * vertex fetch walks memory mostly forward, and remaps the indices.
+ * Unreferenced vertices are dropped. Returns the new vertex count.
+ */
+std::size_t optimizeVertexFetch(
+    std::vector<uint32_t>& indices,
+    std::vector<uint8_t>& vertices,
+    std::size_t vertex_size);
+
+VertexCacheStats analyzeVertexCache(
+    const std::vector<uint32_t>& indices,
+    std::size_t vertex_count,
+    uint32_t cache_size = c_default_vertex_cache_size);
+
+/** True when every index fits into a 16 bit index buffer. */
+bool fitsShortIndices(std::size_t vertex_count);
@@ -0,0 +1,207 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pipeline_cache.h"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "file_utils.h"
+
+namespace {
+
+constexpr uint32_t c_file_magic = 0x43504B56; // "VKPC"
+
+struct FileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t data_size;
+    uint64_t checksum;
+};
+
+/** The header the Vulkan spec puts at the start of the cache data. */
+struct VulkanHeader
+{
+    uint32_t header_length;
+    uint32_t header_version;
+    uint32_t vendor_id;
+    uint32_t device_id;
+    uint8_t pipeline_cache_uuid[VK_UUID_SIZE];
+};
+
+static_assert(sizeof(VulkanHeader) == 16 + VK_UUID_SIZE, "Packed header");
+
+} // namespace
+
+PipelineCache::PipelineCache(
+    VkDevice device,
+    const VkPhysicalDeviceProperties& physical_device_props,
+    std::string path)
+    : device_(device)
+    , physical_device_props_(physical_device_props)
+    , path_(std::move(path))
+{
+}
+
+PipelineCache::~PipelineCache()
+{
+    if (pipeline_cache_ != VK_NULL_HANDLE)
+    {
+        vkDestroyPipelineCache(device_, pipeline_cache_, nullptr);
+    }
+}
+
+VkResult PipelineCache::create()
+{
+    std::string data;
+    if (readFile(data))
+    {
+        load_result_ = PipelineCacheLoad::Warm;
+        saved_checksum_ = fnv1a(data.data(), data.size());
+    }
+    else
+    {
+        data.clear();
+    }
+
+    VkPipelineCacheCreateInfo pipeline_cache_info = {};
+    pipeline_cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipeline_cache_info.initialDataSize = data.size();
+    pipeline_cache_info.pInitialData = data.data();
+    return vkCreatePipelineCache(
+        device_, &pipeline_cache_info, nullptr, &pipeline_cache_);
+}
+
+bool PipelineCache::readFile(std::string& data)
+{
+    std::ifstream file(path_, std::ios::binary);
+    if (!file)
+    {
+        load_result_ = PipelineCacheLoad::Missing;
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    const std::string bytes = contents.str();
+
+    FileHeader header = {};
+    if (bytes.size() < sizeof(header))
+    {
+        load_result_ = PipelineCacheLoad::Corrupt;
+        return false;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    data = bytes.substr(sizeof(header));
+    if (header.magic != c_file_magic || header.version != c_file_version ||
+        header.data_size != data.size() ||
+        header.checksum != fnv1a(data.data(), data.size()))
+    {
+        load_result_ = PipelineCacheLoad::Corrupt;
+        return false;
+    }
+
+    // Data of another driver or device is ignored by the driver as well,
+    // but not every driver checks it that carefully.
+    VulkanHeader vulkan_header = {};
+    if (data.size() < sizeof(vulkan_header))
+    {
+        load_result_ = PipelineCacheLoad::Corrupt;
+        return false;
+    }
+    std::memcpy(&vulkan_header, data.data(), sizeof(vulkan_header));
+    if (vulkan_header.header_length < sizeof(vulkan_header) ||
+        vulkan_header.header_version != VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+    {
+        load_result_ = PipelineCacheLoad::Corrupt;
+        return false;
+    }
+    if (vulkan_header.vendor_id != physical_device_props_.vendorID ||
+        vulkan_header.device_id != physical_device_props_.deviceID ||
+        std::memcmp(
+            vulkan_header.pipeline_cache_uuid,
+            physical_device_props_.pipelineCacheUUID,
+            VK_UUID_SIZE) != 0)
+    {
+        load_result_ = PipelineCacheLoad::OtherDevice;
+        return false;
+    }
+    return true;
+}
+
+bool PipelineCache::save()
+{
+    std::size_t size = 0;
+    if (vkGetPipelineCacheData(device_, pipeline_cache_, &size, nullptr) !=
+        VK_SUCCESS)
+    {
+        return false;
+    }
+    std::vector<uint8_t> data(size);
+    // VK_INCOMPLETE when pipelines were added in between, the prefix that
+    // fit is still a valid cache.
+    VkResult result =
+        vkGetPipelineCacheData(device_, pipeline_cache_, &size, data.data());
+    if (result != VK_SUCCESS && result != VK_INCOMPLETE)
+    {
+        return false;
+    }
+    data.resize(size);
+
+    FileHeader header = {};
+    header.magic = c_file_magic;
+    header.version = c_file_version;
+    header.data_size = data.size();
+    header.checksum = fnv1a(data.data(), data.size());
+    if (header.checksum == saved_checksum_)
+    {
+        return true;
+    }
+
+    if (!writeFileAtomically(
+            path_, {{&header, sizeof(header)}, {data.data(), data.size()}}))
+    {
+        return false;
+    }
+    saved_checksum_ = header.checksum;
+    return true;
+}
+
+const char* toString(PipelineCacheLoad load)
+{
+    switch (load)
+    {
+    case PipelineCacheLoad::Warm:
+        return "warm";
+    case PipelineCacheLoad::Missing:
+        return "missing";
+    case PipelineCacheLoad::Corrupt:
+        return "corrupt";
+    case PipelineCacheLoad::OtherDevice:
+        return "other device";
+    }
+    return "unknown";
+}
@@ -0,0 +1,90 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <string>
+
+enum class PipelineCacheLoad
+{
+    Warm,
+    Missing,
+    Corrupt,
+    OtherDevice,
+};
+
+/**
+ * VkPipelineCache kept in a file between runs. The driver data is wrapped
+ * in a small envelope with its size and checksum, so a truncated or
+ * damaged file is detected before the driver sees it, and the Vulkan
+ * header inside is checked against the vendor, device and cache UUID of
+ * this device. Anything that doesn't pass starts an empty cache which the
+ * next save() replaces.
+ *
+ * The cache may be used by several threads at once, pipelines are created
+ * with it while save() runs.
+ */
+class PipelineCache
+{
+public:
+    static constexpr uint32_t c_file_version = 1;
+
+    PipelineCache(
+        VkDevice device,
+        const VkPhysicalDeviceProperties& physical_device_props,
+        std::string path);
+    ~PipelineCache();
+
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+
+    VkResult create();
+
+    /**
+     * Writes the current contents through a temporary file and a rename,
+     * so a crash leaves either the old or the new file. Returns true when
+     * the file is up to date, also when nothing changed since the load or
+     * the last save and no write was needed.
+     */
+    bool save();
+
+    VkPipelineCache handle() const { return pipeline_cache_; }
+    PipelineCacheLoad loadResult() const { return load_result_; }
+
+private:
+    bool readFile(std::string& data);
+
+    VkDevice device_;
+    const VkPhysicalDeviceProperties& physical_device_props_;
+    const std::string path_;
+
+    VkPipelineCache pipeline_cache_ = VK_NULL_HANDLE;
+    PipelineCacheLoad load_result_ = PipelineCacheLoad::Missing;
+    uint64_t saved_checksum_ = 0;
+};
+
+const char* toString(PipelineCacheLoad load);
@@ -0,0 +1,350 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pipeline_factory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "file_utils.h"
+
+bool PipelineKey::setVertexInput(
+    const std::vector<VkVertexInputBindingDescription>& bindings,
+    const std::vector<VkVertexInputAttributeDescription>& attributes)
+{
+    if (bindings.size() > c_max_vertex_bindings ||
+        attributes.size() > c_max_vertex_attributes)
+    {
+        return false;
+    }
+    // Unused slots stay zero, so equal inputs give equal bytes.
+    std::fill(
+        std::begin(vertex_bindings),
+        std::end(vertex_bindings),
+        VkVertexInputBindingDescription{});
+    std::fill(
+        std::begin(vertex_attributes),
+        std::end(vertex_attributes),
+        VkVertexInputAttributeDescription{});
+    std::copy(bindings.begin(), bindings.end(), vertex_bindings);
+    std::copy(attributes.begin(), attributes.end(), vertex_attributes);
+    vertex_bindings_num = static_cast<uint32_t>(bindings.size());
+    vertex_attributes_num = static_cast<uint32_t>(attributes.size());
+    return true;
+}
+
+bool PipelineKey::operator==(const PipelineKey& other) const
+{
+    return std::memcmp(this, &other, sizeof(PipelineKey)) == 0;
+}
+
+std::size_t PipelineKeyHash::operator()(const PipelineKey& key) const
+{
+    return static_cast<std::size_t>(fnv1a(&key, sizeof(key)));
+}
+
+VkResult createGraphicsPipeline(
+    VkDevice device,
+    VkPipelineCache pipeline_cache,
+    const PipelineKey& key,
+    VkPipeline& pipeline)
+{
+    VkPipelineShaderStageCreateInfo shader_stages[2] = {};
+    shader_stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shader_stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    shader_stages[0].module = key.vertex_shader;
+    shader_stages[0].pName = "main";
+    shader_stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shader_stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    shader_stages[1].module = key.fragment_shader;
+    shader_stages[1].pName = "main";
+
+    VkDynamicState dynamic_states[3] = {
+        VK_DYNAMIC_STATE_VIEWPORT,
+        VK_DYNAMIC_STATE_SCISSOR,
+        VK_DYNAMIC_STATE_DEPTH_BIAS};
+
+    VkPipelineDynamicStateCreateInfo dyn_state_info = {};
+    dyn_state_info.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dyn_state_info.pDynamicStates = dynamic_states;
+    dyn_state_info.dynamicStateCount = key.depth_bias ? 3 : 2;
+
+    VkPipelineVertexInputStateCreateInfo vi_state_info = {};
+    vi_state_info.sType =
+        VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vi_state_info.vertexBindingDescriptionCount = key.vertex_bindings_num;
+    vi_state_info.pVertexBindingDescriptions = key.vertex_bindings;
+    vi_state_info.vertexAttributeDescriptionCount = key.vertex_attributes_num;
+    vi_state_info.pVertexAttributeDescriptions = key.vertex_attributes;
+
+    VkPipelineInputAssemblyStateCreateInfo ia_state_info = {};
+    ia_state_info.sType =
+        VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    ia_state_info.primitiveRestartEnable = key.primitive_restart;
+    ia_state_info.topology = static_cast<VkPrimitiveTopology>(key.topology);
+
+    VkPipelineRasterizationStateCreateInfo rs_state_info = {};
+    rs_state_info.sType =
+        VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rs_state_info.polygonMode = static_cast<VkPolygonMode>(key.polygon_mode);
+    rs_state_info.cullMode = key.cull_mode;
+    rs_state_info.frontFace = static_cast<VkFrontFace>(key.front_face);
+    rs_state_info.depthClampEnable = key.depth_clamp;
+    rs_state_info.rasterizerDiscardEnable = VK_FALSE;
+    rs_state_info.depthBiasEnable = key.depth_bias;
+    rs_state_info.lineWidth = 1.0f;
+
+    VkPipelineColorBlendAttachmentState cb_att_state = {};
+    cb_att_state.colorWriteMask = key.color_write_mask;
+    cb_att_state.blendEnable = key.blend_enable;
+    cb_att_state.srcColorBlendFactor =
+        static_cast<VkBlendFactor>(key.src_color_factor);
+    cb_att_state.dstColorBlendFactor =
+        static_cast<VkBlendFactor>(key.dst_color_factor);
+    cb_att_state.colorBlendOp = static_cast<VkBlendOp>(key.color_blend_op);
+    cb_att_state.srcAlphaBlendFactor =
+        static_cast<VkBlendFactor>(key.src_alpha_factor);
+    cb_att_state.dstAlphaBlendFactor =
+        static_cast<VkBlendFactor>(key.dst_alpha_factor);
+    cb_att_state.alphaBlendOp = static_cast<VkBlendOp>(key.alpha_blend_op);
+
+    VkPipelineColorBlendStateCreateInfo cb_state_info = {};
+    cb_state_info.sType =
+        VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    cb_state_info.attachmentCount = 1;
+    cb_state_info.pAttachments = &cb_att_state;
+    cb_state_info.logicOpEnable = VK_FALSE;
+    cb_state_info.logicOp = VK_LOGIC_OP_NO_OP;
+    cb_state_info.blendConstants[0] = 1.0f;
+    cb_state_info.blendConstants[1] = 1.0f;
+    cb_state_info.blendConstants[2] = 1.0f;
+    cb_state_info.blendConstants[3] = 1.0f;
+
+    VkPipelineViewportStateCreateInfo vp_state_info = {};
+    vp_state_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    vp_state_info.viewportCount = 1;
+    vp_state_info.scissorCount = 1;
+
+    VkPipelineDepthStencilStateCreateInfo ds_state_info = {};
+    ds_state_info.sType =
+        VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    ds_state_info.depthTestEnable = key.depth_test;
+    ds_state_info.depthWriteEnable = key.depth_write;
+    ds_state_info.depthCompareOp =
+        static_cast<VkCompareOp>(key.depth_compare_op);
+    ds_state_info.depthBoundsTestEnable = VK_FALSE;
+    ds_state_info.stencilTestEnable = VK_FALSE;
+    ds_state_info.back.failOp = VK_STENCIL_OP_KEEP;
+    ds_state_info.back.passOp = VK_STENCIL_OP_KEEP;
+    ds_state_info.back.compareOp = VK_COMPARE_OP_ALWAYS;
+    ds_state_info.back.depthFailOp = VK_STENCIL_OP_KEEP;
+    ds_state_info.front = ds_state_info.back;
+
+    VkPipelineMultisampleStateCreateInfo ms_state_info = {};
+    ms_state_info.sType =
+        VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    ms_state_info.rasterizationSamples =
+        static_cast<VkSampleCountFlagBits>(key.samples);
+    ms_state_info.sampleShadingEnable = VK_FALSE;
+    ms_state_info.alphaToCoverageEnable = key.alpha_to_coverage;
+    ms_state_info.alphaToOneEnable = VK_FALSE;
+
+    VkGraphicsPipelineCreateInfo pipeline_info = {};
+    pipeline_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipeline_info.layout = key.layout;
+    pipeline_info.pVertexInputState = &vi_state_info;
+    pipeline_info.pInputAssemblyState = &ia_state_info;
+    pipeline_info.pRasterizationState = &rs_state_info;
+    pipeline_info.pColorBlendState = &cb_state_info;
+    pipeline_info.pMultisampleState = &ms_state_info;
+    pipeline_info.pDynamicState = &dyn_state_info;
+    pipeline_info.pViewportState = &vp_state_info;
+    pipeline_info.pDepthStencilState = &ds_state_info;
+    pipeline_info.pStages = shader_stages;
+    pipeline_info.stageCount = 2;
+    pipeline_info.renderPass = key.render_pass;
+    pipeline_info.subpass = key.subpass;
+
+    return vkCreateGraphicsPipelines(
+        device, pipeline_cache, 1, &pipeline_info, nullptr, &pipeline);
+}
+
+PipelineFactory::PipelineFactory(
+    VkDevice device, VkPipelineCache pipeline_cache, uint32_t workers_num)
+    : device_(device)
+    , pipeline_cache_(pipeline_cache)
+    , workers_num_(
+          workers_num != 0 ? workers_num
+                           : std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+PipelineFactory::~PipelineFactory()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (std::thread& worker : workers_)
+    {
+        worker.join();
+    }
+    for (const auto& entry : entries_)
+    {
+        if (entry.second.pipeline != VK_NULL_HANDLE)
+        {
+            vkDestroyPipeline(device_, entry.second.pipeline, nullptr);
+        }
+    }
+}
+
+VkResult PipelineFactory::get(const PipelineKey& key, VkPipeline& pipeline)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++requests_;
+    auto it = entries_.try_emplace(key).first;
+    // A queued key is taken over, the worker skips it later.
+    if (it->second.state == State::Queued)
+    {
+        compile(key, it->second, lock);
+    }
+
+    // release() may erase the entry while this waits, so it is looked up
+    // again after every wake.
+    while (true)
+    {
+        it = entries_.find(key);
+        if (it == entries_.end())
+        {
+            pipeline = VK_NULL_HANDLE;
+            return VK_ERROR_INITIALIZATION_FAILED;
+        }
+        if (it->second.state == State::Ready ||
+            it->second.state == State::Failed)
+        {
+            break;
+        }
+        done_cv_.wait(lock);
+    }
+    pipeline = it->second.pipeline;
+    return it->second.result;
+}
+
+VkPipeline PipelineFactory::getOrFallback(
+    const PipelineKey& key, VkPipeline fallback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++requests_;
+    auto it = entries_.find(key);
+    if (it == entries_.end())
+    {
+        entries_.emplace(key, Entry());
+        queue_.push_back(key);
+        while (workers_.size() < workers_num_)
+        {
+            workers_.emplace_back(&PipelineFactory::workerLoop, this);
+        }
+        work_cv_.notify_one();
+    }
+    else if (it->second.state == State::Ready)
+    {
+        return it->second.pipeline;
+    }
+    ++fallbacks_;
+    return fallback;
+}
+
+VkPipeline PipelineFactory::release(const PipelineKey& key)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Another release() of the key may erase the entry while this waits.
+    auto it = entries_.find(key);
+    while (it != entries_.end() && it->second.state == State::Compiling)
+    {
+        done_cv_.wait(lock);
+        it = entries_.find(key);
+    }
+    if (it == entries_.end())
+    {
+        return VK_NULL_HANDLE;
+    }
+    VkPipeline pipeline = it->second.pipeline;
+    entries_.erase(it);
+    // Wakes get() calls waiting for the key, they fail now.
+    done_cv_.notify_all();
+    return pipeline;
+}
+
+void PipelineFactory::writeStats(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    out << "Pipeline factory: " << requests_ << " requests, " << compiled_
+        << " compiled in " << compile_ms_ << " ms, " << failed_
+        << " failed, " << fallbacks_ << " fallbacks" << std::endl;
+}
+
+void PipelineFactory::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        work_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (stop_)
+        {
+            return;
+        }
+        const PipelineKey key = queue_.front();
+        queue_.pop_front();
+        auto it = entries_.find(key);
+        // Taken over by get() or released meanwhile.
+        if (it != entries_.end() && it->second.state == State::Queued)
+        {
+            compile(key, it->second, lock);
+        }
+    }
+}
+
+void PipelineFactory::compile(
+    const PipelineKey& key, Entry& entry, std::unique_lock<std::mutex>& lock)
+{
+    entry.state = State::Compiling;
+    lock.unlock();
+
+    auto start = std::chrono::steady_clock::now();
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkResult result =
+        createGraphicsPipeline(device_, pipeline_cache_, key, pipeline);
+    std::chrono::duration<double, std::milli> compile_ms =
+        std::chrono::steady_clock::now() - start;
+
+    lock.lock();
+    entry.pipeline = pipeline;
+    entry.result = result;
+    entry.state = result == VK_SUCCESS ? State::Ready : State::Failed;
+    ++(result == VK_SUCCESS ? compiled_ : failed_);
+    compile_ms_ += compile_ms.count();
+    done_cv_.notify_all();
+}
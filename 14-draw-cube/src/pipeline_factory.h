@@ -0,0 +1,199 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Everything that decides a graphics pipeline, packed into a plain struct
+ * that is hashed and compared as bytes. Viewport and scissor are always
+ * dynamic and there is one color attachment.
+ *
+ * Shader modules are keyed by handle, so a module must outlive every key
+ * that names it; a handle the driver reuses after a destroy would alias
+ * the old pipelines.
+ */
+struct PipelineKey
+{
+    static constexpr uint32_t c_max_vertex_bindings = 4;
+    static constexpr uint32_t c_max_vertex_attributes = 16;
+
+    VkShaderModule vertex_shader = VK_NULL_HANDLE;
+    VkShaderModule fragment_shader = VK_NULL_HANDLE;
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    // Any render pass compatible with the one the pipeline is used in.
+    VkRenderPass render_pass = VK_NULL_HANDLE;
+    uint32_t subpass = 0;
+
+    uint32_t vertex_bindings_num = 0;
+    uint32_t vertex_attributes_num = 0;
+    VkVertexInputBindingDescription vertex_bindings[c_max_vertex_bindings] =
+        {};
+    VkVertexInputAttributeDescription
+        vertex_attributes[c_max_vertex_attributes] = {};
+
+    uint8_t topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    uint8_t primitive_restart = VK_FALSE;
+    uint8_t polygon_mode = VK_POLYGON_MODE_FILL;
+    uint8_t cull_mode = VK_CULL_MODE_BACK_BIT;
+    uint8_t front_face = VK_FRONT_FACE_CLOCKWISE;
+    uint8_t depth_clamp = VK_FALSE;
+
+    uint8_t depth_test = VK_TRUE;
+    uint8_t depth_write = VK_TRUE;
+    uint8_t depth_compare_op = VK_COMPARE_OP_LESS_OR_EQUAL;
+    // The bias values are dynamic state, set with vkCmdSetDepthBias.
+    uint8_t depth_bias = VK_FALSE;
+
+    uint8_t samples = VK_SAMPLE_COUNT_1_BIT;
+    uint8_t alpha_to_coverage = VK_FALSE;
+
+    uint8_t blend_enable = VK_FALSE;
+    uint8_t src_color_factor = VK_BLEND_FACTOR_ONE;
+    uint8_t dst_color_factor = VK_BLEND_FACTOR_ZERO;
+    uint8_t color_blend_op = VK_BLEND_OP_ADD;
+    uint8_t src_alpha_factor = VK_BLEND_FACTOR_ONE;
+    uint8_t dst_alpha_factor = VK_BLEND_FACTOR_ZERO;
+    uint8_t alpha_blend_op = VK_BLEND_OP_ADD;
+    uint8_t color_write_mask = 0xF;
+
+    /** Returns false when the layout has too many bindings or attributes. */
+    bool setVertexInput(
+        const std::vector<VkVertexInputBindingDescription>& bindings,
+        const std::vector<VkVertexInputAttributeDescription>& attributes);
+
+    bool operator==(const PipelineKey& other) const;
+};
+
+// Byte wise hashing and comparison need a key without padding.
+static_assert(
+    std::has_unique_object_representations_v<PipelineKey>,
+    "PipelineKey must not contain padding");
+
+struct PipelineKeyHash
+{
+    std::size_t operator()(const PipelineKey& key) const;
+};
+
+VkResult createGraphicsPipeline(
+    VkDevice device,
+    VkPipelineCache pipeline_cache,
+    const PipelineKey& key,
+    VkPipeline& pipeline);
+
+/**
+ * Creates every distinct pipeline key once. Identical requests share the
+ * pipeline, also while it is still compiling. Callers that can't wait use
+ * getOrFallback(), which queues a miss for the worker threads and returns
+ * the fallback until the pipeline is ready; get() blocks, and compiles a
+ * queued key on the calling thread instead of waiting for a worker.
+ *
+ * The factory owns the pipelines and destroys them with itself, unless
+ * they are handed out with release(). Safe to use from several threads.
+ */
+class PipelineFactory
+{
+public:
+    /** 0 workers picks the number of hardware threads. */
+    PipelineFactory(
+        VkDevice device, VkPipelineCache pipeline_cache, uint32_t workers_num);
+    ~PipelineFactory();
+
+    PipelineFactory(const PipelineFactory&) = delete;
+    PipelineFactory& operator=(const PipelineFactory&) = delete;
+
+    /**
+     * VK_ERROR_INITIALIZATION_FAILED when another thread releases the key
+     * while this one waits for it.
+     */
+    VkResult get(const PipelineKey& key, VkPipeline& pipeline);
+
+    /** Also returns the fallback for keys that failed to compile. */
+    VkPipeline getOrFallback(const PipelineKey& key, VkPipeline fallback);
+
+    /**
+     * Forgets the key and passes ownership of its pipeline to the caller,
+     * waits when it is being compiled. VK_NULL_HANDLE for unknown keys.
+     */
+    VkPipeline release(const PipelineKey& key);
+
+    void writeStats(std::ostream& out) const;
+
+private:
+    enum class State
+    {
+        Queued,
+        Compiling,
+        Ready,
+        Failed,
+    };
+
+    struct Entry
+    {
+        State state = State::Queued;
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkResult result = VK_SUCCESS;
+    };
+
+    using Entries = std::unordered_map<PipelineKey, Entry, PipelineKeyHash>;
+
+    void workerLoop();
+    /** Compiles with the lock released, entry stays valid meanwhile. */
+    void compile(
+        const PipelineKey& key,
+        Entry& entry,
+        std::unique_lock<std::mutex>& lock);
+
+    VkDevice device_;
+    VkPipelineCache pipeline_cache_;
+    const uint32_t workers_num_;
+
+    // Started with the first queued key.
+    std::vector<std::thread> workers_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    bool stop_ = false;
+    Entries entries_;
+    std::deque<PipelineKey> queue_;
+
+    uint64_t requests_ = 0;
+    uint64_t fallbacks_ = 0;
+    uint32_t compiled_ = 0;
+    uint32_t failed_ = 0;
+    double compile_ms_ = 0.0;
+};
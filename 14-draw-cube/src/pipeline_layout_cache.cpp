@@ -0,0 +1,328 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pipeline_layout_cache.h"
+
+#include <algorithm>
+
+namespace {
+
+std::vector<uint32_t> setLayoutKey(
+    const std::vector<VkDescriptorSetLayoutBinding>& bindings)
+{
+    std::vector<uint32_t> key;
+    key.reserve(bindings.size() * 4 + 1);
+    key.push_back(static_cast<uint32_t>(bindings.size()));
+    for (const VkDescriptorSetLayoutBinding& binding : bindings)
+    {
+        key.push_back(binding.binding);
+        key.push_back(static_cast<uint32_t>(binding.descriptorType));
+        key.push_back(binding.descriptorCount);
+        key.push_back(binding.stageFlags);
+    }
+    return key;
+}
+
+VkPushConstantRange mergePushConstants(
+    const std::vector<const ShaderReflection*>& stages)
+{
+    VkPushConstantRange push_constant_range = {};
+    for (const ShaderReflection* stage : stages)
+    {
+        if (!stage->has_push_constants)
+        {
+            continue;
+        }
+        uint32_t begin = stage->push_constants.size;
+        for (const BlockMember& member : stage->push_constants.members)
+        {
+            begin = std::min(begin, member.offset);
+        }
+        const uint32_t end = stage->push_constants.size;
+        if (push_constant_range.stageFlags == 0)
+        {
+            push_constant_range.offset = begin;
+            push_constant_range.size = end - begin;
+        }
+        else
+        {
+            const uint32_t merged_end = std::max(
+                end, push_constant_range.offset + push_constant_range.size);
+            push_constant_range.offset =
+                std::min(begin, push_constant_range.offset);
+            push_constant_range.size = merged_end - push_constant_range.offset;
+        }
+        push_constant_range.stageFlags |= stage->stage;
+    }
+    return push_constant_range;
+}
+
+VkDescriptorType dynamicVariant(VkDescriptorType type)
+{
+    switch (type)
+    {
+    case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+        return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    default:
+        return type;
+    }
+}
+
+} // namespace
+
+PipelineLayoutCache::PipelineLayoutCache(VkDevice device)
+    : device_(device)
+{
+}
+
+PipelineLayoutCache::~PipelineLayoutCache()
+{
+    for (const auto& entry : pipeline_layouts_)
+    {
+        vkDestroyPipelineLayout(
+            device_, entry.second.pipeline_layout, nullptr);
+    }
+    for (const auto& entry : set_layouts_)
+    {
+        vkDestroyDescriptorSetLayout(device_, entry.second, nullptr);
+    }
+}
+
+VkResult PipelineLayoutCache::getSetLayout(
+    const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+    VkDescriptorSetLayout& set_layout)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return getSetLayoutLocked(bindings, set_layout);
+}
+
+VkResult PipelineLayoutCache::getSetLayoutLocked(
+    const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+    VkDescriptorSetLayout& set_layout)
+{
+    std::vector<VkDescriptorSetLayoutBinding> sorted = bindings;
+    std::sort(
+        sorted.begin(),
+        sorted.end(),
+        [](const VkDescriptorSetLayoutBinding& a,
+           const VkDescriptorSetLayoutBinding& b) {
+            return a.binding < b.binding;
+        });
+    std::vector<uint32_t> key = setLayoutKey(sorted);
+    auto it = set_layouts_.find(key);
+    if (it != set_layouts_.end())
+    {
+        ++hits_;
+        set_layout = it->second;
+        return VK_SUCCESS;
+    }
+
+    VkDescriptorSetLayoutCreateInfo set_layout_info = {};
+    set_layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    set_layout_info.bindingCount = static_cast<uint32_t>(sorted.size());
+    set_layout_info.pBindings = sorted.data();
+    if (VkResult result = vkCreateDescriptorSetLayout(
+            device_, &set_layout_info, nullptr, &set_layout);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+    set_layouts_.emplace(std::move(key), set_layout);
+    return VK_SUCCESS;
+}
+
+VkResult PipelineLayoutCache::getPipelineLayout(
+    const std::vector<const ShaderReflection*>& stages,
+    bool dynamic_buffers,
+    VkPipelineLayout& pipeline_layout)
+{
+    // Merge the stages into per set bindings and a single push constant
+    // range.
+    std::vector<std::vector<VkDescriptorSetLayoutBinding>> sets;
+    for (const ShaderReflection* stage : stages)
+    {
+        for (const DescriptorBinding& binding : stage->bindings)
+        {
+            if (binding.count == 0)
+            {
+                return VK_ERROR_INITIALIZATION_FAILED;
+            }
+            if (binding.set >= sets.size())
+            {
+                sets.resize(binding.set + 1);
+            }
+            const VkDescriptorType type =
+                dynamic_buffers ? dynamicVariant(binding.type) : binding.type;
+            auto& set = sets[binding.set];
+            auto existing = std::find_if(
+                set.begin(),
+                set.end(),
+                [&binding](const VkDescriptorSetLayoutBinding& b) {
+                    return b.binding == binding.binding;
+                });
+            if (existing == set.end())
+            {
+                VkDescriptorSetLayoutBinding layout_binding = {};
+                layout_binding.binding = binding.binding;
+                layout_binding.descriptorType = type;
+                layout_binding.descriptorCount = binding.count;
+                layout_binding.stageFlags = stage->stage;
+                set.push_back(layout_binding);
+            }
+            else if (
+                existing->descriptorType != type ||
+                existing->descriptorCount != binding.count)
+            {
+                return VK_ERROR_INITIALIZATION_FAILED;
+            }
+            else
+            {
+                existing->stageFlags |= stage->stage;
+            }
+        }
+    }
+    const VkPushConstantRange push_constant_range = mergePushConstants(stages);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Unused set numbers below the highest one get an empty layout.
+    std::vector<VkDescriptorSetLayout> set_layouts(sets.size());
+    std::vector<uint32_t> key;
+    for (std::size_t i = 0; i < sets.size(); ++i)
+    {
+        std::sort(
+            sets[i].begin(),
+            sets[i].end(),
+            [](const VkDescriptorSetLayoutBinding& a,
+               const VkDescriptorSetLayoutBinding& b) {
+                return a.binding < b.binding;
+            });
+        if (VkResult result = getSetLayoutLocked(sets[i], set_layouts[i]);
+            result != VK_SUCCESS)
+        {
+            return result;
+        }
+        std::vector<uint32_t> set_key = setLayoutKey(sets[i]);
+        key.insert(key.end(), set_key.begin(), set_key.end());
+    }
+    return getPipelineLayoutLocked(
+        std::move(key),
+        std::move(set_layouts),
+        push_constant_range,
+        pipeline_layout);
+}
+
+VkResult PipelineLayoutCache::getPipelineLayoutForSets(
+    const std::vector<const ShaderReflection*>& stages,
+    const std::vector<VkDescriptorSetLayout>& set_layouts,
+    VkPipelineLayout& pipeline_layout)
+{
+    for (const ShaderReflection* stage : stages)
+    {
+        for (const DescriptorBinding& binding : stage->bindings)
+        {
+            if (binding.set >= set_layouts.size())
+            {
+                return VK_ERROR_INITIALIZATION_FAILED;
+            }
+        }
+    }
+    const VkPushConstantRange push_constant_range = mergePushConstants(stages);
+
+    // Reflected keys start with a binding count or stage flags, never with
+    // all bits set.
+    std::vector<uint32_t> key = {~0u};
+    for (VkDescriptorSetLayout set_layout : set_layouts)
+    {
+        const uint64_t handle = reinterpret_cast<uint64_t>(set_layout);
+        key.push_back(static_cast<uint32_t>(handle));
+        key.push_back(static_cast<uint32_t>(handle >> 32));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return getPipelineLayoutLocked(
+        std::move(key), set_layouts, push_constant_range, pipeline_layout);
+}
+
+VkResult PipelineLayoutCache::getPipelineLayoutLocked(
+    std::vector<uint32_t> key,
+    std::vector<VkDescriptorSetLayout> set_layouts,
+    const VkPushConstantRange& push_constant_range,
+    VkPipelineLayout& pipeline_layout)
+{
+    key.push_back(push_constant_range.stageFlags);
+    key.push_back(push_constant_range.offset);
+    key.push_back(push_constant_range.size);
+
+    auto it = pipeline_layouts_.find(key);
+    if (it != pipeline_layouts_.end())
+    {
+        ++hits_;
+        pipeline_layout = it->second.pipeline_layout;
+        return VK_SUCCESS;
+    }
+
+    VkPipelineLayoutCreateInfo pipeline_layout_info = {};
+    pipeline_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipeline_layout_info.setLayoutCount =
+        static_cast<uint32_t>(set_layouts.size());
+    pipeline_layout_info.pSetLayouts = set_layouts.data();
+    pipeline_layout_info.pushConstantRangeCount =
+        push_constant_range.stageFlags != 0 ? 1 : 0;
+    pipeline_layout_info.pPushConstantRanges = &push_constant_range;
+    if (VkResult result = vkCreatePipelineLayout(
+            device_, &pipeline_layout_info, nullptr, &pipeline_layout);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+    pipeline_layouts_.emplace(
+        std::move(key),
+        PipelineLayoutEntry{pipeline_layout, std::move(set_layouts)});
+    return VK_SUCCESS;
+}
+
+std::vector<VkDescriptorSetLayout> PipelineLayoutCache::setLayouts(
+    VkPipelineLayout pipeline_layout) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : pipeline_layouts_)
+    {
+        if (entry.second.pipeline_layout == pipeline_layout)
+        {
+            return entry.second.set_layouts;
+        }
+    }
+    return {};
+}
+
+void PipelineLayoutCache::writeStats(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    out << "Layout cache: " << set_layouts_.size() << " set layouts, "
+        << pipeline_layouts_.size() << " pipeline layouts, " << hits_
+        << " hits" << std::endl;
+}
@@ -0,0 +1,112 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "shader_reflection.h"
+
+/**
+ * Builds descriptor set layouts and pipeline layouts from reflected shader
+ * interfaces and shares them between pipelines whose interfaces match.
+ * The cache owns every layout it returns; they stay valid until it is
+ * destroyed. Safe to use from several threads.
+ */
+class PipelineLayoutCache
+{
+public:
+    explicit PipelineLayoutCache(VkDevice device);
+    ~PipelineLayoutCache();
+
+    PipelineLayoutCache(const PipelineLayoutCache&) = delete;
+    PipelineLayoutCache& operator=(const PipelineLayoutCache&) = delete;
+
+    VkResult getSetLayout(
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        VkDescriptorSetLayout& set_layout);
+
+    /**
+     * Merges the interfaces of all stages of one pipeline: a binding used
+     * by several stages is visible to all of them and the push constants
+     * become one range. dynamic_buffers turns uniform and storage buffers
+     * into their dynamic variants, which reflection can't tell apart.
+     * Returns VK_ERROR_INITIALIZATION_FAILED for conflicting bindings and
+     * runtime sized arrays.
+     */
+    VkResult getPipelineLayout(
+        const std::vector<const ShaderReflection*>& stages,
+        bool dynamic_buffers,
+        VkPipelineLayout& pipeline_layout);
+
+    /**
+     * Pipeline layout over set layouts the caller owns, like the one of a
+     * bindless heap, which must outlive the cache. The stages only add
+     * their push constants and must not use sets beyond set_layouts.
+     */
+    VkResult getPipelineLayoutForSets(
+        const std::vector<const ShaderReflection*>& stages,
+        const std::vector<VkDescriptorSetLayout>& set_layouts,
+        VkPipelineLayout& pipeline_layout);
+
+    /**
+     * Set layouts of a pipeline layout returned by getPipelineLayout(),
+     * indexed by set number.
+     */
+    std::vector<VkDescriptorSetLayout> setLayouts(
+        VkPipelineLayout pipeline_layout) const;
+
+    void writeStats(std::ostream& out) const;
+
+private:
+    struct PipelineLayoutEntry
+    {
+        VkPipelineLayout pipeline_layout;
+        std::vector<VkDescriptorSetLayout> set_layouts;
+    };
+
+    VkResult getSetLayoutLocked(
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        VkDescriptorSetLayout& set_layout);
+
+    VkResult getPipelineLayoutLocked(
+        std::vector<uint32_t> key,
+        std::vector<VkDescriptorSetLayout> set_layouts,
+        const VkPushConstantRange& push_constant_range,
+        VkPipelineLayout& pipeline_layout);
+
+    VkDevice device_;
+
+    mutable std::mutex mutex_;
+    // Keyed by the words of the sorted bindings and push constant ranges.
+    std::map<std::vector<uint32_t>, VkDescriptorSetLayout> set_layouts_;
+    std::map<std::vector<uint32_t>, PipelineLayoutEntry> pipeline_layouts_;
+    uint32_t hits_ = 0;
+};
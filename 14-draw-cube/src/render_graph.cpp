@@ -0,0 +1,1166 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "render_graph.h"
+
+#include <algorithm>
+
+namespace {
+
+struct UsageInfo
+{
+    VkPipelineStageFlags stages;
+    VkAccessFlags read_access;
+    VkAccessFlags write_access;
+    // UNDEFINED for usages that only apply to buffers.
+    VkImageLayout layout;
+    VkImageUsageFlags image_usage;
+    VkBufferUsageFlags buffer_usage;
+};
+
+UsageInfo usageInfo(ResourceUsage usage)
+{
+    switch (usage)
+    {
+    case ResourceUsage::ColorAttachment:
+        return {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                VK_ACCESS_COLOR_ATTACHMENT_READ_BIT,
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+                0};
+    case ResourceUsage::DepthAttachment:
+        return {VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                    VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+                0};
+    case ResourceUsage::Sampled:
+        return {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                VK_ACCESS_SHADER_READ_BIT,
+                0,
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_IMAGE_USAGE_SAMPLED_BIT,
+                VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT};
+    case ResourceUsage::StorageRead:
+        return {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                VK_ACCESS_SHADER_READ_BIT,
+                0,
+                VK_IMAGE_LAYOUT_GENERAL,
+                VK_IMAGE_USAGE_STORAGE_BIT,
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT};
+    case ResourceUsage::StorageWrite:
+        return {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                VK_ACCESS_SHADER_READ_BIT,
+                VK_ACCESS_SHADER_WRITE_BIT,
+                VK_IMAGE_LAYOUT_GENERAL,
+                VK_IMAGE_USAGE_STORAGE_BIT,
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT};
+    case ResourceUsage::VertexBuffer:
+        return {VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+                0,
+                VK_IMAGE_LAYOUT_UNDEFINED,
+                0,
+                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT};
+    case ResourceUsage::IndexBuffer:
+        return {VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                VK_ACCESS_INDEX_READ_BIT,
+                0,
+                VK_IMAGE_LAYOUT_UNDEFINED,
+                0,
+                VK_BUFFER_USAGE_INDEX_BUFFER_BIT};
+    case ResourceUsage::IndirectBuffer:
+        return {VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+                0,
+                VK_IMAGE_LAYOUT_UNDEFINED,
+                0,
+                VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT};
+    case ResourceUsage::TransferSrc:
+        return {VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_ACCESS_TRANSFER_READ_BIT,
+                0,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                VK_BUFFER_USAGE_TRANSFER_SRC_BIT};
+    case ResourceUsage::TransferDst:
+        return {VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0,
+                VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT};
+    }
+    return {};
+}
+
+bool isAttachment(ResourceUsage usage)
+{
+    return usage == ResourceUsage::ColorAttachment ||
+           usage == ResourceUsage::DepthAttachment;
+}
+
+bool hasStencil(VkFormat format)
+{
+    return format == VK_FORMAT_S8_UINT ||
+           format == VK_FORMAT_D16_UNORM_S8_UINT ||
+           format == VK_FORMAT_D24_UNORM_S8_UINT ||
+           format == VK_FORMAT_D32_SFLOAT_S8_UINT;
+}
+
+VkImageAspectFlags imageAspect(VkFormat format)
+{
+    switch (format)
+    {
+    case VK_FORMAT_D16_UNORM:
+    case VK_FORMAT_X8_D24_UNORM_PACK32:
+    case VK_FORMAT_D32_SFLOAT:
+        return VK_IMAGE_ASPECT_DEPTH_BIT;
+    case VK_FORMAT_S8_UINT:
+        return VK_IMAGE_ASPECT_STENCIL_BIT;
+    case VK_FORMAT_D16_UNORM_S8_UINT:
+    case VK_FORMAT_D24_UNORM_S8_UINT:
+    case VK_FORMAT_D32_SFLOAT_S8_UINT:
+        return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+    default:
+        return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+}
+
+VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/** The state a resource is tracked in while the barriers are derived. */
+struct Track
+{
+    bool touched = false;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    // The last write, or layout transition, and the reads since then.
+    VkPipelineStageFlags write_stages = 0;
+    VkAccessFlags write_access = 0;
+    VkPipelineStageFlags read_stages = 0;
+    // Where the last write has been made visible already.
+    VkPipelineStageFlags visible_stages = 0;
+    VkAccessFlags visible_access = 0;
+};
+
+} // namespace
+
+uint32_t RenderGraph::Barrier::barriersNum() const
+{
+    if (empty())
+    {
+        return 0;
+    }
+    // An execution dependency alone is still one barrier to the driver.
+    const bool memory = src_access != 0 || images.empty();
+    return static_cast<uint32_t>(images.size()) + (memory ? 1 : 0);
+}
+
+RenderGraph::RenderGraph(VkDevice device, MemoryAllocator& memory_allocator)
+    : device_(device), memory_allocator_(memory_allocator)
+{
+}
+
+RenderGraph::~RenderGraph()
+{
+    for (Pass& pass : passes_)
+    {
+        for (const auto& framebuffer : pass.framebuffers)
+        {
+            vkDestroyFramebuffer(device_, framebuffer.second, nullptr);
+        }
+        if (pass.render_pass != VK_NULL_HANDLE)
+        {
+            vkDestroyRenderPass(device_, pass.render_pass, nullptr);
+        }
+    }
+    for (Resource& resource : resources_)
+    {
+        if (resource.imported)
+        {
+            continue;
+        }
+        if (resource.view != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(device_, resource.view, nullptr);
+        }
+        if (resource.image != VK_NULL_HANDLE)
+        {
+            vkDestroyImage(device_, resource.image, nullptr);
+        }
+        if (resource.buffer != VK_NULL_HANDLE)
+        {
+            vkDestroyBuffer(device_, resource.buffer, nullptr);
+        }
+    }
+    for (Heap& heap : heaps_)
+    {
+        if (heap.allocation.memory != VK_NULL_HANDLE)
+        {
+            memory_allocator_.free(heap.allocation);
+        }
+    }
+}
+
+uint32_t RenderGraph::createImage(
+    const std::string& name, const ImageDesc& desc)
+{
+    Resource resource;
+    resource.name = name;
+    resource.is_image = true;
+    resource.image_desc = desc;
+    return addResource(std::move(resource));
+}
+
+uint32_t RenderGraph::createBuffer(const std::string& name, VkDeviceSize size)
+{
+    Resource resource;
+    resource.name = name;
+    resource.buffer_size = size;
+    return addResource(std::move(resource));
+}
+
+uint32_t RenderGraph::importImage(
+    const std::string& name,
+    const ImageDesc& desc,
+    const ResourceState& initial,
+    const ResourceState& final)
+{
+    Resource resource;
+    resource.name = name;
+    resource.is_image = true;
+    resource.imported = true;
+    resource.image_desc = desc;
+    resource.initial = initial;
+    resource.final = final;
+    return addResource(std::move(resource));
+}
+
+uint32_t RenderGraph::importBuffer(
+    const std::string& name,
+    const ResourceState& initial,
+    const ResourceState& final)
+{
+    Resource resource;
+    resource.name = name;
+    resource.imported = true;
+    resource.initial = initial;
+    resource.final = final;
+    return addResource(std::move(resource));
+}
+
+uint32_t RenderGraph::addPass(const std::string& name, PassType type)
+{
+    Pass pass;
+    pass.name = name;
+    pass.type = type;
+    passes_.push_back(std::move(pass));
+    return static_cast<uint32_t>(passes_.size() - 1);
+}
+
+void RenderGraph::read(uint32_t pass, uint32_t resource, ResourceUsage usage)
+{
+    Access& access = addAccess(pass, resource);
+    access.usage = usage;
+}
+
+void RenderGraph::write(uint32_t pass, uint32_t resource, ResourceUsage usage)
+{
+    Access& access = addAccess(pass, resource);
+    access.usage = usage;
+    access.write = true;
+}
+
+void RenderGraph::clear(
+    uint32_t pass, uint32_t resource, const VkClearValue& value)
+{
+    Access& access = addAccess(pass, resource);
+    access.write = true;
+    access.clear = true;
+    access.clear_value = value;
+}
+
+void RenderGraph::setSideEffects(uint32_t pass)
+{
+    passes_[pass].side_effects = true;
+}
+
+void RenderGraph::setRecord(uint32_t pass, RecordPass record)
+{
+    passes_[pass].record = std::move(record);
+}
+
+void RenderGraph::setHooks(uint32_t pass, RecordPass before, RecordPass after)
+{
+    passes_[pass].before = std::move(before);
+    passes_[pass].after = std::move(after);
+}
+
+VkResult RenderGraph::compile()
+{
+    cullPasses();
+
+    for (uint32_t p = 0; p < passes_.size(); ++p)
+    {
+        if (!passes_[p].live)
+        {
+            continue;
+        }
+        for (const Access& access : passes_[p].accesses)
+        {
+            Resource& resource = resources_[access.resource];
+            const UsageInfo info = usageInfo(access.usage);
+            resource.image_usage |= info.image_usage;
+            resource.buffer_usage |= info.buffer_usage;
+            if (resource.first_pass == c_invalid)
+            {
+                resource.first_pass = p;
+            }
+            resource.last_pass = p;
+        }
+    }
+
+    // Neither loaded nor stored, such an image can live in tile memory for
+    // the whole pass and needs no backing unless the device spills it.
+    const VkImageUsageFlags attachment_usage =
+        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    for (Resource& resource : resources_)
+    {
+        resource.transient_attachment =
+            resource.is_image && !resource.imported &&
+            resource.first_pass != c_invalid &&
+            resource.first_pass == resource.last_pass &&
+            (resource.image_usage & ~attachment_usage) == 0;
+        if (resource.transient_attachment)
+        {
+            resource.image_usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        }
+    }
+
+    if (VkResult result = createTransientResources(); result != VK_SUCCESS)
+    {
+        return result;
+    }
+    deriveBarriers();
+
+    for (uint32_t p = 0; p < passes_.size(); ++p)
+    {
+        if (!passes_[p].live || passes_[p].type != PassType::Graphics)
+        {
+            continue;
+        }
+        if (VkResult result = createRenderPass(p); result != VK_SUCCESS)
+        {
+            return result;
+        }
+    }
+    compiled_ = true;
+    return VK_SUCCESS;
+}
+
+void RenderGraph::setImage(uint32_t resource, VkImage image, VkImageView view)
+{
+    resources_[resource].image = image;
+    resources_[resource].view = view;
+}
+
+VkResult RenderGraph::execute(VkCommandBuffer cmd_buffer)
+{
+    if (!compiled_)
+    {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    // Nothing is recorded unless every imported image in use is bound.
+    for (const Resource& resource : resources_)
+    {
+        if (resource.imported && resource.is_image &&
+            resource.first_pass != c_invalid &&
+            resource.image == VK_NULL_HANDLE)
+        {
+            return VK_ERROR_INITIALIZATION_FAILED;
+        }
+    }
+
+    for (Pass& pass : passes_)
+    {
+        if (!pass.live)
+        {
+            continue;
+        }
+        if (pass.before)
+        {
+            pass.before(cmd_buffer);
+        }
+        recordBarrier(cmd_buffer, pass.barrier);
+
+        if (pass.type != PassType::Graphics)
+        {
+            if (pass.record)
+            {
+                pass.record(cmd_buffer);
+            }
+            if (pass.after)
+            {
+                pass.after(cmd_buffer);
+            }
+            continue;
+        }
+
+        VkFramebuffer framebuffer = VK_NULL_HANDLE;
+        if (VkResult result = getFramebuffer(pass, framebuffer);
+            result != VK_SUCCESS)
+        {
+            return result;
+        }
+
+        VkRenderPassBeginInfo rp_begin = {};
+        rp_begin.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        rp_begin.renderPass = pass.render_pass;
+        rp_begin.framebuffer = framebuffer;
+        rp_begin.renderArea.offset.x = 0;
+        rp_begin.renderArea.offset.y = 0;
+        rp_begin.renderArea.extent = pass.extent;
+        rp_begin.clearValueCount =
+            static_cast<uint32_t>(pass.clear_values.size());
+        rp_begin.pClearValues = pass.clear_values.data();
+        vkCmdBeginRenderPass(cmd_buffer, &rp_begin, VK_SUBPASS_CONTENTS_INLINE);
+        if (pass.record)
+        {
+            pass.record(cmd_buffer);
+        }
+        vkCmdEndRenderPass(cmd_buffer);
+        if (pass.after)
+        {
+            pass.after(cmd_buffer);
+        }
+    }
+
+    recordBarrier(cmd_buffer, final_barrier_);
+    return VK_SUCCESS;
+}
+
+RenderGraphStats RenderGraph::stats() const
+{
+    RenderGraphStats stats;
+    stats.passes_num = static_cast<uint32_t>(passes_.size());
+    for (const Pass& pass : passes_)
+    {
+        if (!pass.live)
+        {
+            ++stats.culled_passes_num;
+        }
+        stats.barriers_num += pass.barrier.barriersNum();
+    }
+    stats.barriers_num += final_barrier_.barriersNum();
+    for (const Resource& resource : resources_)
+    {
+        if (resource.heap != c_invalid)
+        {
+            ++stats.transient_resources_num;
+            stats.transient_bytes += resource.size;
+        }
+        if (resource.transient_attachment)
+        {
+            ++stats.transient_attachments_num;
+        }
+    }
+    const VkPhysicalDeviceMemoryProperties& mem_props =
+        memory_allocator_.memoryProperties();
+    for (const Heap& heap : heaps_)
+    {
+        stats.aliased_bytes += heap.size;
+        if (mem_props.memoryTypes[heap.memory_type_index].propertyFlags &
+            VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+        {
+            stats.lazy_bytes += heap.size;
+        }
+    }
+    return stats;
+}
+
+void RenderGraph::writeStats(std::ostream& out) const
+{
+    const RenderGraphStats graph_stats = stats();
+    out << "Render graph: " << graph_stats.passes_num << " passes, "
+        << graph_stats.culled_passes_num << " culled, "
+        << graph_stats.barriers_num << " barriers, "
+        << graph_stats.transient_resources_num
+        << " transient resources in " << graph_stats.aliased_bytes << " of "
+        << graph_stats.transient_bytes << " bytes, "
+        << graph_stats.transient_attachments_num
+        << " transient attachments, " << graph_stats.lazy_bytes
+        << " bytes lazily allocated" << std::endl;
+    for (const Pass& pass : passes_)
+    {
+        if (!pass.live)
+        {
+            out << "Culled pass: " << pass.name << std::endl;
+        }
+    }
+}
+
+uint32_t RenderGraph::addResource(Resource resource)
+{
+    resources_.push_back(std::move(resource));
+    return static_cast<uint32_t>(resources_.size() - 1);
+}
+
+RenderGraph::Access& RenderGraph::addAccess(uint32_t pass, uint32_t resource)
+{
+    // A pass touches a resource once, clear() and write() of an attachment
+    // end up in the same access.
+    std::vector<Access>& accesses = passes_[pass].accesses;
+    for (Access& access : accesses)
+    {
+        if (access.resource == resource)
+        {
+            return access;
+        }
+    }
+    Access access;
+    access.resource = resource;
+    accesses.push_back(access);
+    return accesses.back();
+}
+
+void RenderGraph::cullPasses()
+{
+    // Walks the passes backwards, a pass survives if it writes something a
+    // surviving later pass reads. A clear discards what was written
+    // before, every other write may keep some of it.
+    std::vector<bool> needed(resources_.size(), false);
+    for (uint32_t p = static_cast<uint32_t>(passes_.size()); p-- > 0;)
+    {
+        Pass& pass = passes_[p];
+        pass.live = pass.side_effects;
+        for (const Access& access : pass.accesses)
+        {
+            if (access.write &&
+                (resources_[access.resource].imported ||
+                 needed[access.resource]))
+            {
+                pass.live = true;
+            }
+        }
+        if (!pass.live)
+        {
+            continue;
+        }
+        for (const Access& access : pass.accesses)
+        {
+            needed[access.resource] = !access.clear;
+        }
+    }
+}
+
+VkResult RenderGraph::createTransientResources()
+{
+    const VkPhysicalDeviceMemoryProperties& mem_props =
+        memory_allocator_.memoryProperties();
+
+    // Optimal tiling images and everything else get separate heaps, so
+    // no two neighbours ever need bufferImageGranularity padding.
+    std::vector<std::vector<uint32_t>> heap_resources;
+    for (uint32_t r = 0; r < resources_.size(); ++r)
+    {
+        Resource& resource = resources_[r];
+        if (resource.imported || resource.first_pass == c_invalid)
+        {
+            continue;
+        }
+
+        VkMemoryRequirements mem_reqs = {};
+        bool optimal_image = false;
+        if (resource.is_image)
+        {
+            VkImageCreateInfo image_info = {};
+            image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            image_info.imageType = VK_IMAGE_TYPE_2D;
+            image_info.format = resource.image_desc.format;
+            image_info.extent.width = resource.image_desc.extent.width;
+            image_info.extent.height = resource.image_desc.extent.height;
+            image_info.extent.depth = 1;
+            image_info.mipLevels = 1;
+            image_info.arrayLayers = 1;
+            image_info.tiling = resource.image_desc.tiling;
+            image_info.samples = VK_SAMPLE_COUNT_1_BIT;
+            image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            image_info.usage = resource.image_usage;
+            image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            if (VkResult result = vkCreateImage(
+                    device_, &image_info, nullptr, &resource.image);
+                result != VK_SUCCESS)
+            {
+                return result;
+            }
+            vkGetImageMemoryRequirements(device_, resource.image, &mem_reqs);
+            optimal_image =
+                resource.image_desc.tiling == VK_IMAGE_TILING_OPTIMAL;
+        }
+        else
+        {
+            VkBufferCreateInfo buffer_info = {};
+            buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            buffer_info.size = resource.buffer_size;
+            buffer_info.usage = resource.buffer_usage;
+            buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            if (VkResult result = vkCreateBuffer(
+                    device_, &buffer_info, nullptr, &resource.buffer);
+                result != VK_SUCCESS)
+            {
+                return result;
+            }
+            vkGetBufferMemoryRequirements(device_, resource.buffer, &mem_reqs);
+        }
+
+        // Without a lazily allocated type a transient attachment is backed
+        // like any other image.
+        auto[found, type_index] = findMemoryType(
+            mem_props,
+            mem_reqs.memoryTypeBits,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            resource.transient_attachment
+                ? VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT
+                : 0);
+        if (!found)
+        {
+            return VK_ERROR_FEATURE_NOT_PRESENT;
+        }
+
+        uint32_t heap = 0;
+        while (heap < heaps_.size() &&
+               (heaps_[heap].memory_type_index != type_index ||
+                heaps_[heap].images != optimal_image))
+        {
+            ++heap;
+        }
+        if (heap == heaps_.size())
+        {
+            Heap new_heap;
+            new_heap.memory_type_index = type_index;
+            new_heap.images = optimal_image;
+            heaps_.push_back(new_heap);
+            heap_resources.emplace_back();
+        }
+        resource.heap = heap;
+        resource.size = mem_reqs.size;
+        heaps_[heap].alignment =
+            std::max(heaps_[heap].alignment, mem_reqs.alignment);
+        heap_resources[heap].push_back(r);
+    }
+
+    for (uint32_t h = 0; h < heaps_.size(); ++h)
+    {
+        Heap& heap = heaps_[h];
+        placeTransientResources(heap_resources[h]);
+
+        VkMemoryRequirements heap_reqs = {};
+        heap_reqs.size = heap.size;
+        heap_reqs.alignment = heap.alignment;
+        heap_reqs.memoryTypeBits = 1u << heap.memory_type_index;
+        if (VkResult result = memory_allocator_.allocate(
+                heap_reqs,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                0,
+                heap.images,
+                heap.allocation);
+            result != VK_SUCCESS)
+        {
+            return result;
+        }
+
+        for (uint32_t r : heap_resources[h])
+        {
+            Resource& resource = resources_[r];
+            const VkDeviceSize offset =
+                heap.allocation.offset + resource.offset;
+            if (!resource.is_image)
+            {
+                if (VkResult result = vkBindBufferMemory(
+                        device_,
+                        resource.buffer,
+                        heap.allocation.memory,
+                        offset);
+                    result != VK_SUCCESS)
+                {
+                    return result;
+                }
+                continue;
+            }
+
+            if (VkResult result = vkBindImageMemory(
+                    device_, resource.image, heap.allocation.memory, offset);
+                result != VK_SUCCESS)
+            {
+                return result;
+            }
+
+            VkImageViewCreateInfo view_info = {};
+            view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            view_info.image = resource.image;
+            view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            view_info.format = resource.image_desc.format;
+            view_info.components.r = VK_COMPONENT_SWIZZLE_R;
+            view_info.components.g = VK_COMPONENT_SWIZZLE_G;
+            view_info.components.b = VK_COMPONENT_SWIZZLE_B;
+            view_info.components.a = VK_COMPONENT_SWIZZLE_A;
+            view_info.subresourceRange.aspectMask =
+                imageAspect(resource.image_desc.format);
+            view_info.subresourceRange.baseMipLevel = 0;
+            view_info.subresourceRange.levelCount = 1;
+            view_info.subresourceRange.baseArrayLayer = 0;
+            view_info.subresourceRange.layerCount = 1;
+            if (VkResult result = vkCreateImageView(
+                    device_, &view_info, nullptr, &resource.view);
+                result != VK_SUCCESS)
+            {
+                return result;
+            }
+        }
+    }
+    return VK_SUCCESS;
+}
+
+void RenderGraph::placeTransientResources(
+    const std::vector<uint32_t>& resources)
+{
+    // Largest first, each at the lowest offset that doesn't collide with an
+    // already placed resource whose lifetime overlaps its own.
+    std::vector<uint32_t> order = resources;
+    std::stable_sort(
+        order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+            return resources_[a].size > resources_[b].size;
+        });
+
+    std::vector<uint32_t> placed;
+    for (uint32_t r : order)
+    {
+        Resource& resource = resources_[r];
+        Heap& heap = heaps_[resource.heap];
+
+        std::vector<std::pair<VkDeviceSize, VkDeviceSize>> taken;
+        for (uint32_t other : placed)
+        {
+            const Resource& placed_resource = resources_[other];
+            if (placed_resource.first_pass <= resource.last_pass &&
+                resource.first_pass <= placed_resource.last_pass)
+            {
+                taken.emplace_back(
+                    placed_resource.offset,
+                    placed_resource.offset + placed_resource.size);
+            }
+        }
+        std::sort(taken.begin(), taken.end());
+
+        VkDeviceSize offset = 0;
+        for (const auto& range : taken)
+        {
+            if (offset + resource.size <= range.first)
+            {
+                break;
+            }
+            offset = std::max(offset, alignUp(range.second, heap.alignment));
+        }
+        resource.offset = offset;
+        heap.size = std::max(heap.size, offset + resource.size);
+        placed.push_back(r);
+    }
+}
+
+void RenderGraph::deriveBarriers()
+{
+    // Where every resource ends up once the frame is done. The memory of a
+    // transient resource may have been used by any of its aliases, in this
+    // frame or the previous one, so its first use waits for all of them.
+    std::vector<ResourceState> end_states(resources_.size());
+    for (const Pass& pass : passes_)
+    {
+        if (!pass.live)
+        {
+            continue;
+        }
+        for (const Access& access : pass.accesses)
+        {
+            const UsageInfo info = usageInfo(access.usage);
+            ResourceState& end = end_states[access.resource];
+            if (access.write)
+            {
+                end.stages = info.stages;
+                end.access = info.write_access;
+            }
+            else
+            {
+                end.stages |= info.stages;
+            }
+        }
+    }
+
+    std::vector<Track> tracks(resources_.size());
+    for (uint32_t r = 0; r < resources_.size(); ++r)
+    {
+        const Resource& resource = resources_[r];
+        Track& track = tracks[r];
+        if (resource.imported)
+        {
+            track.layout = resource.initial.layout;
+            track.write_stages = resource.initial.stages;
+            track.write_access = resource.initial.access;
+            continue;
+        }
+        if (resource.heap == c_invalid)
+        {
+            continue;
+        }
+        for (uint32_t a = 0; a < resources_.size(); ++a)
+        {
+            const Resource& alias = resources_[a];
+            if (alias.heap == resource.heap &&
+                alias.offset < resource.offset + resource.size &&
+                resource.offset < alias.offset + alias.size)
+            {
+                track.write_stages |= end_states[a].stages;
+                track.write_access |= end_states[a].access;
+            }
+        }
+    }
+
+    auto add_barrier = [this](
+                           Barrier& barrier,
+                           uint32_t resource,
+                           VkPipelineStageFlags src_stages,
+                           VkAccessFlags src_access,
+                           VkPipelineStageFlags dst_stages,
+                           VkAccessFlags dst_access,
+                           VkImageLayout old_layout,
+                           VkImageLayout new_layout) {
+        barrier.src_stages |=
+            src_stages != 0 ? src_stages
+                            : static_cast<VkPipelineStageFlags>(
+                                  VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+        barrier.dst_stages |= dst_stages;
+        if (!resources_[resource].is_image)
+        {
+            barrier.src_access |= src_access;
+            barrier.dst_access |= dst_access;
+            return;
+        }
+        ImageBarrier image_barrier;
+        image_barrier.resource = resource;
+        image_barrier.src_access = src_access;
+        image_barrier.dst_access = dst_access;
+        image_barrier.old_layout = old_layout;
+        image_barrier.new_layout = new_layout;
+        barrier.images.push_back(image_barrier);
+    };
+
+    for (Pass& pass : passes_)
+    {
+        if (!pass.live)
+        {
+            continue;
+        }
+        for (const Access& access : pass.accesses)
+        {
+            const Resource& resource = resources_[access.resource];
+            Track& track = tracks[access.resource];
+            const UsageInfo info = usageInfo(access.usage);
+            const VkAccessFlags dst_access =
+                access.write ? info.read_access | info.write_access
+                             : info.read_access;
+            const VkImageLayout layout =
+                resource.is_image ? info.layout : VK_IMAGE_LAYOUT_UNDEFINED;
+
+            if (!resource.imported && !track.touched)
+            {
+                // The aliases' writes are to other resources, only a global
+                // memory barrier covers them; the contents are discarded.
+                pass.barrier.src_access |= track.write_access;
+                pass.barrier.dst_access |= dst_access;
+                add_barrier(
+                    pass.barrier,
+                    access.resource,
+                    track.write_stages,
+                    0,
+                    info.stages,
+                    dst_access,
+                    VK_IMAGE_LAYOUT_UNDEFINED,
+                    layout);
+            }
+            else if (access.write || track.layout != layout)
+            {
+                // Writes and layout transitions wait for the reads too.
+                const VkPipelineStageFlags src_stages =
+                    track.write_stages | track.read_stages;
+                if (src_stages != 0 || track.layout != layout)
+                {
+                    add_barrier(
+                        pass.barrier,
+                        access.resource,
+                        src_stages,
+                        track.write_access,
+                        info.stages,
+                        dst_access,
+                        track.layout,
+                        layout);
+                }
+            }
+            else if (
+                track.write_stages != 0 &&
+                ((info.stages & ~track.visible_stages) != 0 ||
+                 (dst_access & ~track.visible_access) != 0))
+            {
+                add_barrier(
+                    pass.barrier,
+                    access.resource,
+                    track.write_stages,
+                    track.write_access,
+                    info.stages,
+                    dst_access,
+                    layout,
+                    layout);
+                track.visible_stages |= info.stages;
+                track.visible_access |= dst_access;
+                track.read_stages |= info.stages;
+                continue;
+            }
+            else
+            {
+                track.read_stages |= info.stages;
+                continue;
+            }
+
+            // Either a write or a transition, which counts as one.
+            track.touched = true;
+            track.layout = layout;
+            track.write_stages = info.stages;
+            track.write_access = access.write ? info.write_access : 0;
+            track.read_stages = access.write ? 0 : info.stages;
+            track.visible_stages = access.write ? 0 : info.stages;
+            track.visible_access = access.write ? 0 : dst_access;
+        }
+    }
+
+    for (uint32_t r = 0; r < resources_.size(); ++r)
+    {
+        const Resource& resource = resources_[r];
+        const Track& track = tracks[r];
+        if (!resource.imported || resource.first_pass == c_invalid ||
+            resource.final.stages == 0)
+        {
+            continue;
+        }
+        const VkImageLayout final_layout =
+            resource.final.layout != VK_IMAGE_LAYOUT_UNDEFINED
+                ? resource.final.layout
+                : track.layout;
+        add_barrier(
+            final_barrier_,
+            r,
+            track.write_stages | track.read_stages,
+            track.write_access,
+            resource.final.stages,
+            resource.final.access,
+            track.layout,
+            final_layout);
+    }
+}
+
+VkResult RenderGraph::createRenderPass(uint32_t p)
+{
+    Pass& pass = passes_[p];
+    std::vector<VkAttachmentDescription> attachment_descs;
+    std::vector<VkAttachmentReference> color_references;
+    VkAttachmentReference depth_reference = {};
+    bool has_depth = false;
+
+    for (const Access& access : pass.accesses)
+    {
+        if (!isAttachment(access.usage))
+        {
+            continue;
+        }
+        const Resource& resource = resources_[access.resource];
+        const UsageInfo info = usageInfo(access.usage);
+
+        // Contents survive from an earlier pass or from outside the
+        // frame, and are needed by a later pass or outside of it.
+        const bool has_contents =
+            resource.first_pass != p ||
+            (resource.imported &&
+             resource.initial.layout != VK_IMAGE_LAYOUT_UNDEFINED);
+        const bool keep_contents =
+            resource.last_pass != p || resource.imported;
+
+        VkAttachmentDescription desc = {};
+        desc.format = resource.image_desc.format;
+        desc.samples = VK_SAMPLE_COUNT_1_BIT;
+        desc.loadOp = access.clear ? VK_ATTACHMENT_LOAD_OP_CLEAR
+                                   : has_contents
+                                         ? VK_ATTACHMENT_LOAD_OP_LOAD
+                                         : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        desc.storeOp = keep_contents ? VK_ATTACHMENT_STORE_OP_STORE
+                                     : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        const bool stencil = hasStencil(desc.format);
+        desc.stencilLoadOp =
+            stencil ? desc.loadOp : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        desc.stencilStoreOp =
+            stencil ? desc.storeOp : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        desc.initialLayout = info.layout;
+        desc.finalLayout = info.layout;
+
+        VkAttachmentReference reference = {};
+        reference.attachment =
+            static_cast<uint32_t>(attachment_descs.size());
+        reference.layout = info.layout;
+        if (access.usage == ResourceUsage::DepthAttachment)
+        {
+            depth_reference = reference;
+            has_depth = true;
+        }
+        else
+        {
+            color_references.push_back(reference);
+        }
+
+        if (attachment_descs.empty())
+        {
+            pass.extent = resource.image_desc.extent;
+        }
+        attachment_descs.push_back(desc);
+        pass.attachments.push_back(access.resource);
+        pass.clear_values.push_back(access.clear_value);
+    }
+
+    VkSubpassDescription subpass = {};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount =
+        static_cast<uint32_t>(color_references.size());
+    subpass.pColorAttachments = color_references.data();
+    subpass.pDepthStencilAttachment = has_depth ? &depth_reference : nullptr;
+
+    // No dependencies: the barriers recorded before the pass and after it
+    // already order it against everything else.
+    VkRenderPassCreateInfo render_pass_info = {};
+    render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    render_pass_info.attachmentCount =
+        static_cast<uint32_t>(attachment_descs.size());
+    render_pass_info.pAttachments = attachment_descs.data();
+    render_pass_info.subpassCount = 1;
+    render_pass_info.pSubpasses = &subpass;
+    return vkCreateRenderPass(
+        device_, &render_pass_info, nullptr, &pass.render_pass);
+}
+
+VkResult RenderGraph::getFramebuffer(Pass& pass, VkFramebuffer& framebuffer)
+{
+    std::vector<VkImageView> views;
+    views.reserve(pass.attachments.size());
+    for (uint32_t resource : pass.attachments)
+    {
+        if (resources_[resource].view == VK_NULL_HANDLE)
+        {
+            return VK_ERROR_INITIALIZATION_FAILED;
+        }
+        views.push_back(resources_[resource].view);
+    }
+
+    auto found = pass.framebuffers.find(views);
+    if (found != pass.framebuffers.end())
+    {
+        framebuffer = found->second;
+        return VK_SUCCESS;
+    }
+
+    VkFramebufferCreateInfo fb_info = {};
+    fb_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    fb_info.renderPass = pass.render_pass;
+    fb_info.attachmentCount = static_cast<uint32_t>(views.size());
+    fb_info.pAttachments = views.data();
+    fb_info.width = pass.extent.width;
+    fb_info.height = pass.extent.height;
+    fb_info.layers = 1;
+    if (VkResult result =
+            vkCreateFramebuffer(device_, &fb_info, nullptr, &framebuffer);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+    pass.framebuffers.emplace(std::move(views), framebuffer);
+    return VK_SUCCESS;
+}
+
+void RenderGraph::recordBarrier(
+    VkCommandBuffer cmd_buffer, const Barrier& barrier)
+{
+    if (barrier.empty())
+    {
+        return;
+    }
+
+    VkMemoryBarrier memory_barrier = {};
+    memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memory_barrier.srcAccessMask = barrier.src_access;
+    memory_barrier.dstAccessMask = barrier.dst_access;
+
+    std::vector<VkImageMemoryBarrier> image_barriers(barrier.images.size());
+    for (std::size_t i = 0; i < barrier.images.size(); ++i)
+    {
+        const ImageBarrier& image = barrier.images[i];
+        const Resource& resource = resources_[image.resource];
+        VkImageMemoryBarrier& image_barrier = image_barriers[i];
+        image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        image_barrier.srcAccessMask = image.src_access;
+        image_barrier.dstAccessMask = image.dst_access;
+        image_barrier.oldLayout = image.old_layout;
+        image_barrier.newLayout = image.new_layout;
+        image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        image_barrier.image = resource.image;
+        image_barrier.subresourceRange.aspectMask =
+            imageAspect(resource.image_desc.format);
+        image_barrier.subresourceRange.baseMipLevel = 0;
+        image_barrier.subresourceRange.levelCount = 1;
+        image_barrier.subresourceRange.baseArrayLayer = 0;
+        image_barrier.subresourceRange.layerCount = 1;
+    }
+
+    vkCmdPipelineBarrier(
+        cmd_buffer,
+        barrier.src_stages,
+        barrier.dst_stages,
+        0,
+        barrier.src_access != 0 ? 1 : 0,
+        &memory_barrier,
+        0,
+        nullptr,
+        static_cast<uint32_t>(image_barriers.size()),
+        image_barriers.data());
+}
@@ -0,0 +1,319 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "memory_allocator.h"
+
+/** How a pass touches a resource, which decides stages, access and layout. */
+enum class ResourceUsage
+{
+    ColorAttachment,
+    DepthAttachment,
+    Sampled,
+    StorageRead,
+    StorageWrite,
+    VertexBuffer,
+    IndexBuffer,
+    IndirectBuffer,
+    TransferSrc,
+    TransferDst
+};
+
+enum class PassType
+{
+    Graphics,
+    Compute,
+    Transfer
+};
+
+/** Where a resource is in the frame: who last touched it and how. */
+struct ResourceState
+{
+    VkPipelineStageFlags stages = 0;
+    VkAccessFlags access = 0;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+};
+
+struct ImageDesc
+{
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkExtent2D extent = {};
+    VkImageTiling tiling = VK_IMAGE_TILING_OPTIMAL;
+};
+
+struct RenderGraphStats
+{
+    uint32_t passes_num = 0;
+    uint32_t culled_passes_num = 0;
+    uint32_t barriers_num = 0;
+    uint32_t transient_resources_num = 0;
+    // Memory the transient resources would take without aliasing.
+    VkDeviceSize transient_bytes = 0;
+    VkDeviceSize aliased_bytes = 0;
+    uint32_t transient_attachments_num = 0;
+    // Part of aliased_bytes that is only committed when the device needs
+    // it, on tilers usually never.
+    VkDeviceSize lazy_bytes = 0;
+};
+
+/**
+ * A frame described as passes that declare which named resources they read
+ * and write. compile() orders nothing - passes run in the order they were
+ * added, so a pass may only read what an earlier pass wrote - but derives
+ * everything the hand written frame used to spell out:
+ *
+ * - passes whose results never reach an imported resource are culled,
+ *   unless they are marked as having side effects;
+ * - pipeline barriers and image layout transitions between the passes,
+ *   buffers get a global memory barrier since per buffer ranges buy
+ *   nothing on current drivers;
+ * - a VkRenderPass per graphics pass, whose load and store ops follow from
+ *   whether earlier passes wrote an attachment and later ones read it;
+ * - memory for the transient images and buffers, where resources whose
+ *   lifetimes don't overlap share the same range;
+ * - transient attachments, images that never leave the render pass of the
+ *   one pass using them, which get lazily allocated memory where the
+ *   device has it.
+ *
+ * Imported resources live outside the graph, e.g. swapchain images; their
+ * state before and after the frame is declared up front and the images are
+ * bound with setImage() before every execute(). The layouts of the render
+ * passes never change, every transition is a barrier recorded by the
+ * graph, so a graphics pass can be recorded into any framebuffer.
+ *
+ * Handles returned by the graph index its resources and passes and stay
+ * valid for its lifetime. Declaring anything after compile() isn't allowed.
+ */
+class RenderGraph
+{
+public:
+    using RecordPass = std::function<void(VkCommandBuffer cmd_buffer)>;
+
+    static constexpr uint32_t c_invalid = ~0u;
+
+    RenderGraph(VkDevice device, MemoryAllocator& memory_allocator);
+    ~RenderGraph();
+
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    /** Transient resources are created, aliased and owned by the graph. */
+    uint32_t createImage(const std::string& name, const ImageDesc& desc);
+    uint32_t createBuffer(const std::string& name, VkDeviceSize size);
+
+    /**
+     * initial is the state the resource is in when the frame starts, with
+     * an UNDEFINED layout if its contents may be discarded. The graph
+     * transitions the resource to final after its last pass, final stages
+     * of 0 leave it in whatever state that pass left it in.
+     */
+    uint32_t importImage(
+        const std::string& name,
+        const ImageDesc& desc,
+        const ResourceState& initial,
+        const ResourceState& final);
+    uint32_t importBuffer(
+        const std::string& name,
+        const ResourceState& initial,
+        const ResourceState& final);
+
+    uint32_t addPass(const std::string& name, PassType type);
+    void read(uint32_t pass, uint32_t resource, ResourceUsage usage);
+    /**
+     * Attachments are written; without a clear value the pass loads what
+     * earlier passes left in them.
+     */
+    void write(uint32_t pass, uint32_t resource, ResourceUsage usage);
+    /** Clears an attachment the pass writes, discarding earlier contents. */
+    void clear(uint32_t pass, uint32_t resource, const VkClearValue& value);
+    /** Keeps a pass that writes nothing the graph can see, e.g. queries. */
+    void setSideEffects(uint32_t pass);
+    /**
+     * Graphics passes are recorded inside their render pass, with the
+     * viewport and scissor left to the callback.
+     */
+    void setRecord(uint32_t pass, RecordPass record);
+    /**
+     * Recorded around all of the pass, its barrier and render pass
+     * included, e.g. for profiler scopes. Either may be empty.
+     */
+    void setHooks(uint32_t pass, RecordPass before, RecordPass after);
+
+    /**
+     * Culls, creates the render passes and the transient resources and
+     * derives the barriers. Runs once, the result is reused by every
+     * execute().
+     */
+    VkResult compile();
+
+    void setImage(uint32_t resource, VkImage image, VkImageView view);
+
+    /**
+     * Records the passes that survived culling. Framebuffers are created
+     * on first use of a set of attachments and kept until the graph dies.
+     */
+    VkResult execute(VkCommandBuffer cmd_buffer);
+
+    /** The render pass a graphics pass is recorded in, for pipelines. */
+    VkRenderPass renderPass(uint32_t pass) const
+    {
+        return passes_[pass].render_pass;
+    }
+    bool culled(uint32_t pass) const { return !passes_[pass].live; }
+    VkImage image(uint32_t resource) const
+    {
+        return resources_[resource].image;
+    }
+    VkImageView imageView(uint32_t resource) const
+    {
+        return resources_[resource].view;
+    }
+    /** Only transient buffers have a handle. */
+    VkBuffer buffer(uint32_t resource) const
+    {
+        return resources_[resource].buffer;
+    }
+
+    RenderGraphStats stats() const;
+    /** Writes the stats and the names of the culled passes. */
+    void writeStats(std::ostream& out) const;
+
+private:
+    struct Resource
+    {
+        std::string name;
+        bool is_image = false;
+        bool imported = false;
+        ImageDesc image_desc;
+        VkDeviceSize buffer_size = 0;
+        ResourceState initial;
+        ResourceState final;
+
+        // Derived by compile() from the passes that survived culling.
+        VkImageUsageFlags image_usage = 0;
+        VkBufferUsageFlags buffer_usage = 0;
+        uint32_t first_pass = c_invalid;
+        uint32_t last_pass = c_invalid;
+        bool transient_attachment = false;
+        uint32_t heap = c_invalid;
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VkBuffer buffer = VK_NULL_HANDLE;
+    };
+
+    struct Access
+    {
+        uint32_t resource = c_invalid;
+        ResourceUsage usage = ResourceUsage::StorageRead;
+        bool write = false;
+        bool clear = false;
+        VkClearValue clear_value = {};
+    };
+
+    struct ImageBarrier
+    {
+        uint32_t resource = c_invalid;
+        VkAccessFlags src_access = 0;
+        VkAccessFlags dst_access = 0;
+        VkImageLayout old_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        VkImageLayout new_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    };
+
+    /** Everything recorded as one vkCmdPipelineBarrier. */
+    struct Barrier
+    {
+        VkPipelineStageFlags src_stages = 0;
+        VkPipelineStageFlags dst_stages = 0;
+        // Global memory barrier, covers the buffers.
+        VkAccessFlags src_access = 0;
+        VkAccessFlags dst_access = 0;
+        std::vector<ImageBarrier> images;
+
+        bool empty() const { return src_stages == 0 && dst_stages == 0; }
+        uint32_t barriersNum() const;
+    };
+
+    struct Pass
+    {
+        std::string name;
+        PassType type = PassType::Graphics;
+        std::vector<Access> accesses;
+        bool side_effects = false;
+        RecordPass record;
+        RecordPass before;
+        RecordPass after;
+
+        // Derived by compile().
+        bool live = false;
+        Barrier barrier;
+        VkRenderPass render_pass = VK_NULL_HANDLE;
+        std::vector<uint32_t> attachments;
+        std::vector<VkClearValue> clear_values;
+        VkExtent2D extent = {};
+        std::map<std::vector<VkImageView>, VkFramebuffer> framebuffers;
+    };
+
+    /** One allocation shared by transient resources of one memory type. */
+    struct Heap
+    {
+        uint32_t memory_type_index = 0;
+        bool images = false;
+        VkDeviceSize size = 0;
+        VkDeviceSize alignment = 1;
+        MemoryAllocation allocation;
+    };
+
+    uint32_t addResource(Resource resource);
+    Access& addAccess(uint32_t pass, uint32_t resource);
+    void cullPasses();
+    VkResult createTransientResources();
+    void placeTransientResources(const std::vector<uint32_t>& resources);
+    void deriveBarriers();
+    VkResult createRenderPass(uint32_t pass);
+    VkResult getFramebuffer(Pass& pass, VkFramebuffer& framebuffer);
+    void recordBarrier(VkCommandBuffer cmd_buffer, const Barrier& barrier);
+
+    VkDevice device_;
+    MemoryAllocator& memory_allocator_;
+    std::vector<Resource> resources_;
+    std::vector<Pass> passes_;
+    std::vector<Heap> heaps_;
+    // Transitions the imported resources into their final state.
+    Barrier final_barrier_;
+    bool compiled_ = false;
+};
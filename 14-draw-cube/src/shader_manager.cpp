@@ -0,0 +1,242 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "shader_manager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "file_utils.h"
+
+namespace {
+
+constexpr uint32_t c_spirv_magic = 0x07230203;
+
+constexpr shaderc_optimization_level c_optimization_level =
+    shaderc_optimization_level_performance;
+constexpr uint32_t c_target_env_version = shaderc_env_version_vulkan_1_0;
+
+/** FNV-1a, fed field by field with the field sizes as separators. */
+class Hasher
+{
+public:
+    void add(const void* data, std::size_t size)
+    {
+        hash_ = fnv1a(data, size, hash_);
+    }
+
+    void add(const std::string& text)
+    {
+        const uint64_t size = text.size();
+        add(&size, sizeof(size));
+        add(text.data(), text.size());
+    }
+
+    void add(uint32_t value) { add(&value, sizeof(value)); }
+
+    uint64_t hash() const { return hash_; }
+
+private:
+    uint64_t hash_ = c_fnv1a_seed;
+};
+
+bool readFile(const std::string& path, std::string& text)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    text = contents.str();
+    return true;
+}
+
+} // namespace
+
+ShaderManager::ShaderManager(std::string cache_dir, ThreadPool& thread_pool)
+    : cache_dir_(std::move(cache_dir))
+    , thread_pool_(thread_pool)
+{
+    if (!cache_dir_.empty())
+    {
+        std::error_code error;
+        std::filesystem::create_directories(cache_dir_, error);
+    }
+}
+
+ShaderBinary ShaderManager::load(const ShaderSource& source)
+{
+    ShaderBinary binary;
+
+    std::string text;
+    if (!readFile(source.path, text))
+    {
+        binary.log = "Can't read '" + source.path + "'.";
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        ++failed_;
+        return binary;
+    }
+
+    const std::string cache_path =
+        cache_dir_.empty() ? std::string() : cachePath(cacheKey(text, source));
+    if (!cache_path.empty() && readCache(cache_path, binary.spirv))
+    {
+        binary.ok = true;
+        binary.from_cache = true;
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        ++cache_hits_;
+        return binary;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    shaderc::CompileOptions options;
+    for (const auto& [name, value] : source.defines)
+    {
+        options.AddMacroDefinition(name, value);
+    }
+    options.SetOptimizationLevel(c_optimization_level);
+    options.SetTargetEnvironment(
+        shaderc_target_env_vulkan, c_target_env_version);
+
+    // A compiler per call keeps concurrent compilations independent.
+    const shaderc::Compiler compiler;
+    const shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(
+        text, source.kind, source.path.c_str(), options);
+    binary.log = result.GetErrorMessage();
+    binary.ok =
+        result.GetCompilationStatus() == shaderc_compilation_status_success;
+    if (binary.ok)
+    {
+        const auto* begin = reinterpret_cast<const uint8_t*>(result.cbegin());
+        const auto* end = reinterpret_cast<const uint8_t*>(result.cend());
+        binary.spirv.assign(begin, end);
+        if (!cache_path.empty())
+        {
+            writeCache(cache_path, binary.spirv);
+        }
+    }
+
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    ++(binary.ok ? compiled_ : failed_);
+    compile_ms_ += elapsed.count();
+    return binary;
+}
+
+std::vector<ShaderBinary> ShaderManager::loadAll(
+    const std::vector<ShaderSource>& sources)
+{
+    std::vector<ShaderBinary> binaries(sources.size());
+    thread_pool_.parallelFor(
+        sources.size(),
+        1,
+        [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                binaries[i] = load(sources[i]);
+            }
+        });
+    return binaries;
+}
+
+void ShaderManager::writeStats(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    out << "Shaders: " << cache_hits_ << " from cache, " << compiled_
+        << " compiled in " << compile_ms_ << " ms, " << failed_ << " failed"
+        << std::endl;
+}
+
+uint64_t ShaderManager::cacheKey(
+    const std::string& text, const ShaderSource& source) const
+{
+    // Macro order doesn't change the result, so it doesn't change the key.
+    auto defines = source.defines;
+    std::sort(defines.begin(), defines.end());
+
+    Hasher hasher;
+    hasher.add(c_cache_version);
+    hasher.add(text);
+    hasher.add(static_cast<uint32_t>(source.kind));
+    hasher.add(static_cast<uint32_t>(defines.size()));
+    for (const auto& [name, value] : defines)
+    {
+        hasher.add(name);
+        hasher.add(value);
+    }
+    hasher.add(static_cast<uint32_t>(c_optimization_level));
+    hasher.add(c_target_env_version);
+    return hasher.hash();
+}
+
+std::string ShaderManager::cachePath(uint64_t key) const
+{
+    std::ostringstream path;
+    path << cache_dir_ << "/" << std::hex << std::setw(16) << std::setfill('0')
+         << key << ".spv";
+    return path.str();
+}
+
+bool ShaderManager::readCache(
+    const std::string& path, std::vector<uint8_t>& spirv) const
+{
+    std::string contents;
+    if (!readFile(path, contents))
+    {
+        return false;
+    }
+
+    // A truncated or foreign file is treated as a miss and overwritten.
+    uint32_t magic = 0;
+    if (contents.size() < sizeof(magic) * 5 ||
+        contents.size() % sizeof(magic) != 0)
+    {
+        return false;
+    }
+    std::memcpy(&magic, contents.data(), sizeof(magic));
+    if (magic != c_spirv_magic)
+    {
+        return false;
+    }
+
+    spirv.assign(contents.begin(), contents.end());
+    return true;
+}
+
+void ShaderManager::writeCache(
+    const std::string& path, const std::vector<uint8_t>& spirv) const
+{
+    // Entries are content addressed, so when two writers race either
+    // result is correct; a failed write only costs a recompile.
+    writeFileAtomically(path, {{spirv.data(), spirv.size()}});
+}
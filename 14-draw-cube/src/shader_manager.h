@@ -0,0 +1,100 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <shaderc/shaderc.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.h"
+
+/** A GLSL file and the macros it is compiled with. */
+struct ShaderSource
+{
+    std::string path;
+    shaderc_shader_kind kind = shaderc_glsl_infer_from_source;
+    std::vector<std::pair<std::string, std::string>> defines;
+};
+
+struct ShaderBinary
+{
+    bool ok = false;
+    bool from_cache = false;
+    std::vector<uint8_t> spirv;
+    // Compiler errors and warnings, or why the source couldn't be read.
+    std::string log;
+};
+
+/**
+ * Compiles GLSL to SPIR-V with shaderc and keeps the results in an on-disk
+ * cache. Entries are addressed by a hash of the source text, the defines
+ * and the compile options, so an edited file simply misses the cache and
+ * a warm start reads every binary without compiling. #include isn't
+ * supported, since included files would not be part of the key.
+ *
+ * Stale entries are never deleted; removing the directory resets the
+ * cache. Bump c_cache_version when the compiler or the options change in
+ * a way the key doesn't capture.
+ */
+class ShaderManager
+{
+public:
+    static constexpr uint32_t c_cache_version = 1;
+
+    /** An empty cache_dir disables the disk cache. */
+    ShaderManager(std::string cache_dir, ThreadPool& thread_pool);
+
+    ShaderManager(const ShaderManager&) = delete;
+    ShaderManager& operator=(const ShaderManager&) = delete;
+
+    ShaderBinary load(const ShaderSource& source);
+
+    /** Loads the sources in parallel, the results keep their order. */
+    std::vector<ShaderBinary> loadAll(const std::vector<ShaderSource>& sources);
+
+    void writeStats(std::ostream& out) const;
+
+private:
+    uint64_t cacheKey(const std::string& text, const ShaderSource& source)
+        const;
+    std::string cachePath(uint64_t key) const;
+    bool readCache(const std::string& path, std::vector<uint8_t>& spirv) const;
+    void writeCache(const std::string& path, const std::vector<uint8_t>& spirv)
+        const;
+
+    const std::string cache_dir_;
+    ThreadPool& thread_pool_;
+
+    mutable std::mutex stats_mutex_;
+    uint32_t cache_hits_ = 0;
+    uint32_t compiled_ = 0;
+    uint32_t failed_ = 0;
+    double compile_ms_ = 0.0;
+};
@@ -0,0 +1,693 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "shader_reflection.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t c_spirv_magic = 0x07230203;
+constexpr uint32_t c_header_words = 5;
+constexpr uint32_t c_no_value = ~0u;
+
+// The subset of the SPIR-V grammar the reflection reads.
+enum class Op : uint32_t
+{
+    None = 0,
+    Name = 5,
+    MemberName = 6,
+    EntryPoint = 15,
+    TypeBool = 20,
+    TypeInt = 21,
+    TypeFloat = 22,
+    TypeVector = 23,
+    TypeMatrix = 24,
+    TypeImage = 25,
+    TypeSampler = 26,
+    TypeSampledImage = 27,
+    TypeArray = 28,
+    TypeRuntimeArray = 29,
+    TypeStruct = 30,
+    TypePointer = 32,
+    Constant = 43,
+    Variable = 59,
+    Decorate = 71,
+    MemberDecorate = 72,
+};
+
+enum class Decoration : uint32_t
+{
+    Block = 2,
+    BufferBlock = 3,
+    RowMajor = 4,
+    ArrayStride = 6,
+    MatrixStride = 7,
+    BuiltIn = 11,
+    Location = 30,
+    Binding = 33,
+    DescriptorSet = 34,
+    Offset = 35,
+};
+
+enum class StorageClass : uint32_t
+{
+    UniformConstant = 0,
+    Input = 1,
+    Uniform = 2,
+    Output = 3,
+    PushConstant = 9,
+    StorageBuffer = 12,
+};
+
+enum class NumericType
+{
+    Float,
+    Sint,
+    Uint,
+};
+
+constexpr uint32_t c_dim_buffer = 5;
+constexpr uint32_t c_dim_subpass_data = 6;
+constexpr uint32_t c_image_storage = 2;
+
+struct Member
+{
+    std::string name;
+    uint32_t offset = 0;
+    uint32_t matrix_stride = 0;
+    bool row_major = false;
+    bool builtin = false;
+};
+
+/** Everything known about one result id. */
+struct Id
+{
+    Op op = Op::None;
+    // Operands following the result id; the value of a constant.
+    std::vector<uint32_t> operands;
+    std::string name;
+    std::vector<Member> members;
+    uint32_t set = 0;
+    uint32_t binding = 0;
+    uint32_t location = c_no_value;
+    uint32_t array_stride = 0;
+    bool buffer_block = false;
+    bool builtin = false;
+};
+
+struct Variable
+{
+    uint32_t id;
+    uint32_t pointer_type;
+    StorageClass storage;
+};
+
+struct Module
+{
+    std::vector<Id> ids;
+    std::vector<Variable> variables;
+    uint32_t execution_model = c_no_value;
+    std::string entry_point;
+
+    const Id& id(uint32_t index) const
+    {
+        static const Id c_none;
+        return index < ids.size() ? ids[index] : c_none;
+    }
+};
+
+uint32_t operand(const Id& id, std::size_t index)
+{
+    return index < id.operands.size() ? id.operands[index] : 0;
+}
+
+std::string readString(const uint32_t* words, std::size_t words_num)
+{
+    const char* chars = reinterpret_cast<const char*>(words);
+    std::size_t length = 0;
+    while (length < words_num * sizeof(uint32_t) && chars[length] != '\0')
+    {
+        ++length;
+    }
+    return std::string(chars, length);
+}
+
+Member& member(Id& id, uint32_t index)
+{
+    if (index >= id.members.size())
+    {
+        id.members.resize(index + 1);
+    }
+    return id.members[index];
+}
+
+/** Returns false for lengths given by specialization constants. */
+bool arrayLength(const Module& module, const Id& type, uint32_t& length)
+{
+    const Id& constant = module.id(operand(type, 1));
+    length = operand(constant, 0);
+    return constant.op == Op::Constant;
+}
+
+BlockLayout blockLayout(const Module& module, uint32_t struct_id);
+
+/**
+ * The stride separates the columns of a matrix, or its rows when it is
+ * row major; without one the matrix is packed tightly column by column.
+ */
+uint32_t typeSize(
+    const Module& module,
+    uint32_t type_id,
+    uint32_t matrix_stride,
+    bool row_major)
+{
+    const Id& type = module.id(type_id);
+    switch (type.op)
+    {
+    case Op::TypeBool:
+        return 4;
+    case Op::TypeInt:
+    case Op::TypeFloat:
+        return operand(type, 0) / 8;
+    case Op::TypeVector:
+        return operand(type, 1) *
+               typeSize(module, operand(type, 0), 0, false);
+    case Op::TypeMatrix:
+    {
+        const uint32_t column_id = operand(type, 0);
+        if (matrix_stride == 0)
+        {
+            return operand(type, 1) * typeSize(module, column_id, 0, false);
+        }
+        const uint32_t rows = operand(module.id(column_id), 1);
+        return (row_major ? rows : operand(type, 1)) * matrix_stride;
+    }
+    case Op::TypeArray:
+    {
+        uint32_t length = 0;
+        arrayLength(module, type, length);
+        return length *
+               (type.array_stride != 0
+                    ? type.array_stride
+                    : typeSize(
+                          module, operand(type, 0), matrix_stride, row_major));
+    }
+    case Op::TypeStruct:
+        return blockLayout(module, type_id).size;
+    default:
+        // Runtime arrays and opaque types take no space in a block.
+        return 0;
+    }
+}
+
+BlockLayout blockLayout(const Module& module, uint32_t struct_id)
+{
+    const Id& type = module.id(struct_id);
+    BlockLayout layout;
+    layout.name = type.name;
+    for (std::size_t i = 0; i < type.operands.size(); ++i)
+    {
+        const Member info =
+            i < type.members.size() ? type.members[i] : Member();
+        BlockMember block_member;
+        block_member.name = info.name;
+        block_member.offset = info.offset;
+        block_member.size =
+            typeSize(
+                module, type.operands[i], info.matrix_stride, info.row_major);
+        layout.size =
+            std::max(layout.size, block_member.offset + block_member.size);
+        layout.members.push_back(block_member);
+    }
+    return layout;
+}
+
+VkFormat vectorFormat(const Module& module, uint32_t scalar_id, uint32_t size)
+{
+    static const VkFormat c_float_formats[4] = {
+        VK_FORMAT_R32_SFLOAT,
+        VK_FORMAT_R32G32_SFLOAT,
+        VK_FORMAT_R32G32B32_SFLOAT,
+        VK_FORMAT_R32G32B32A32_SFLOAT};
+    static const VkFormat c_sint_formats[4] = {
+        VK_FORMAT_R32_SINT,
+        VK_FORMAT_R32G32_SINT,
+        VK_FORMAT_R32G32B32_SINT,
+        VK_FORMAT_R32G32B32A32_SINT};
+    static const VkFormat c_uint_formats[4] = {
+        VK_FORMAT_R32_UINT,
+        VK_FORMAT_R32G32_UINT,
+        VK_FORMAT_R32G32B32_UINT,
+        VK_FORMAT_R32G32B32A32_UINT};
+
+    const Id& scalar = module.id(scalar_id);
+    if (size == 0 || size > 4 || operand(scalar, 0) != 32)
+    {
+        return VK_FORMAT_UNDEFINED;
+    }
+    if (scalar.op == Op::TypeFloat)
+    {
+        return c_float_formats[size - 1];
+    }
+    if (scalar.op == Op::TypeInt)
+    {
+        return operand(scalar, 1) != 0 ? c_sint_formats[size - 1]
+                                       : c_uint_formats[size - 1];
+    }
+    return VK_FORMAT_UNDEFINED;
+}
+
+bool interfaceVariable(
+    const Module& module,
+    uint32_t type_id,
+    InterfaceVariable& variable,
+    std::string& error)
+{
+    uint32_t element_id = type_id;
+    while (module.id(element_id).op == Op::TypeArray)
+    {
+        uint32_t length = 0;
+        if (!arrayLength(module, module.id(element_id), length))
+        {
+            error = "Array size of '" + variable.name + "' isn't constant";
+            return false;
+        }
+        variable.locations *= length;
+        element_id = operand(module.id(element_id), 0);
+    }
+    if (module.id(element_id).op == Op::TypeMatrix)
+    {
+        variable.locations *= operand(module.id(element_id), 1);
+        element_id = operand(module.id(element_id), 0);
+    }
+    const Id& element = module.id(element_id);
+    variable.format =
+        element.op == Op::TypeVector
+            ? vectorFormat(module, operand(element, 0), operand(element, 1))
+            : vectorFormat(module, element_id, 1);
+    return true;
+}
+
+bool descriptorType(const Id& type, VkDescriptorType& out)
+{
+    switch (type.op)
+    {
+    case Op::TypeSampler:
+        out = VK_DESCRIPTOR_TYPE_SAMPLER;
+        return true;
+    case Op::TypeSampledImage:
+        out = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        return true;
+    case Op::TypeImage:
+    {
+        const uint32_t dim = operand(type, 1);
+        const bool storage = operand(type, 5) == c_image_storage;
+        if (dim == c_dim_subpass_data)
+        {
+            out = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+        }
+        else if (dim == c_dim_buffer)
+        {
+            out = storage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER
+                          : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+        }
+        else
+        {
+            out = storage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE
+                          : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool parse(
+    const std::vector<uint8_t>& spirv, Module& module, std::string& error)
+{
+    const std::size_t words_num = spirv.size() / sizeof(uint32_t);
+    std::vector<uint32_t> words(words_num);
+    if (words_num > 0)
+    {
+        std::memcpy(words.data(), spirv.data(), words_num * sizeof(uint32_t));
+    }
+    if (spirv.size() % sizeof(uint32_t) != 0 || words_num < c_header_words ||
+        words[0] != c_spirv_magic)
+    {
+        error = "Not a SPIR-V module";
+        return false;
+    }
+
+    module.ids.resize(words[3]);
+    for (std::size_t i = c_header_words; i < words_num;)
+    {
+        const uint32_t* inst = words.data() + i;
+        const Op op = static_cast<Op>(inst[0] & 0xFFFF);
+        const uint32_t inst_words = inst[0] >> 16;
+        if (inst_words == 0 || i + inst_words > words_num)
+        {
+            error = "Truncated instruction";
+            return false;
+        }
+        i += inst_words;
+
+        if (op == Op::EntryPoint)
+        {
+            if (module.execution_model == c_no_value && inst_words > 3)
+            {
+                module.execution_model = inst[1];
+                module.entry_point = readString(inst + 3, inst_words - 3);
+            }
+            continue;
+        }
+        const bool read = op == Op::Name || op == Op::MemberName ||
+                          (op >= Op::TypeBool && op <= Op::TypePointer) ||
+                          op == Op::Constant || op == Op::Variable ||
+                          op == Op::Decorate || op == Op::MemberDecorate;
+        if (!read)
+        {
+            continue;
+        }
+
+        // Constants and variables name their result after the result type,
+        // everything else read here names its target first.
+        const uint32_t target_word =
+            op == Op::Constant || op == Op::Variable ? 2 : 1;
+        const uint32_t min_words =
+            op == Op::Constant || op == Op::Variable ||
+                    op == Op::MemberDecorate
+                ? 4
+                : op == Op::Decorate || op == Op::MemberName ? 3 : 2;
+        if (inst_words < min_words || inst[target_word] >= module.ids.size())
+        {
+            error = "Malformed instruction";
+            return false;
+        }
+        const uint32_t target = inst[target_word];
+
+        Id& id = module.ids[target];
+        switch (op)
+        {
+        case Op::Name:
+            id.name = readString(inst + 2, inst_words - 2);
+            break;
+        case Op::MemberName:
+            member(id, inst[2]).name = readString(inst + 3, inst_words - 3);
+            break;
+        case Op::Constant:
+            id.op = op;
+            id.operands.assign(1, inst[3]);
+            break;
+        case Op::Variable:
+            module.variables.push_back(
+                {target, inst[1], static_cast<StorageClass>(inst[3])});
+            break;
+        case Op::Decorate:
+        {
+            const uint32_t value = inst_words > 3 ? inst[3] : 0;
+            switch (static_cast<Decoration>(inst[2]))
+            {
+            case Decoration::BufferBlock:
+                id.buffer_block = true;
+                break;
+            case Decoration::ArrayStride:
+                id.array_stride = value;
+                break;
+            case Decoration::BuiltIn:
+                id.builtin = true;
+                break;
+            case Decoration::Location:
+                id.location = value;
+                break;
+            case Decoration::Binding:
+                id.binding = value;
+                break;
+            case Decoration::DescriptorSet:
+                id.set = value;
+                break;
+            default:
+                break;
+            }
+            break;
+        }
+        case Op::MemberDecorate:
+        {
+            Member& info = member(id, inst[2]);
+            const uint32_t value = inst_words > 4 ? inst[4] : 0;
+            switch (static_cast<Decoration>(inst[3]))
+            {
+            case Decoration::RowMajor:
+                info.row_major = true;
+                break;
+            case Decoration::MatrixStride:
+                info.matrix_stride = value;
+                break;
+            case Decoration::BuiltIn:
+                info.builtin = true;
+                break;
+            case Decoration::Offset:
+                info.offset = value;
+                break;
+            default:
+                break;
+            }
+            break;
+        }
+        default:
+            id.op = op;
+            id.operands.assign(inst + 2, inst + inst_words);
+            break;
+        }
+    }
+    return true;
+}
+
+bool stageFromModel(uint32_t execution_model, VkShaderStageFlagBits& stage)
+{
+    static const VkShaderStageFlagBits c_stages[] = {
+        VK_SHADER_STAGE_VERTEX_BIT,
+        VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT,
+        VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT,
+        VK_SHADER_STAGE_GEOMETRY_BIT,
+        VK_SHADER_STAGE_FRAGMENT_BIT,
+        VK_SHADER_STAGE_COMPUTE_BIT};
+    if (execution_model >= sizeof(c_stages) / sizeof(c_stages[0]))
+    {
+        return false;
+    }
+    stage = c_stages[execution_model];
+    return true;
+}
+
+NumericType numericType(VkFormat format)
+{
+    switch (format)
+    {
+    case VK_FORMAT_R8_SINT:
+    case VK_FORMAT_R8G8_SINT:
+    case VK_FORMAT_R8G8B8A8_SINT:
+    case VK_FORMAT_R16_SINT:
+    case VK_FORMAT_R16G16_SINT:
+    case VK_FORMAT_R16G16B16A16_SINT:
+    case VK_FORMAT_R32_SINT:
+    case VK_FORMAT_R32G32_SINT:
+    case VK_FORMAT_R32G32B32_SINT:
+    case VK_FORMAT_R32G32B32A32_SINT:
+        return NumericType::Sint;
+    case VK_FORMAT_R8_UINT:
+    case VK_FORMAT_R8G8_UINT:
+    case VK_FORMAT_R8G8B8A8_UINT:
+    case VK_FORMAT_R16_UINT:
+    case VK_FORMAT_R16G16_UINT:
+    case VK_FORMAT_R16G16B16A16_UINT:
+    case VK_FORMAT_R32_UINT:
+    case VK_FORMAT_R32G32_UINT:
+    case VK_FORMAT_R32G32B32_UINT:
+    case VK_FORMAT_R32G32B32A32_UINT:
+        return NumericType::Uint;
+    default:
+        return NumericType::Float;
+    }
+}
+
+} // namespace
+
+bool reflectShader(
+    const std::vector<uint8_t>& spirv,
+    ShaderReflection& reflection,
+    std::string& error)
+{
+    Module module;
+    if (!parse(spirv, module, error))
+    {
+        return false;
+    }
+    if (!stageFromModel(module.execution_model, reflection.stage))
+    {
+        error = "No supported entry point";
+        return false;
+    }
+    reflection.entry_point = module.entry_point;
+
+    for (const Variable& variable : module.variables)
+    {
+        const Id& id = module.id(variable.id);
+        const Id& pointer = module.id(variable.pointer_type);
+        const uint32_t type_id = operand(pointer, 1);
+        const Id& type = module.id(type_id);
+
+        if (variable.storage == StorageClass::Input ||
+            variable.storage == StorageClass::Output)
+        {
+            const bool builtin =
+                id.builtin ||
+                std::any_of(
+                    type.members.begin(),
+                    type.members.end(),
+                    [](const Member& info) { return info.builtin; });
+            if (builtin || id.location == c_no_value)
+            {
+                continue;
+            }
+            InterfaceVariable interface;
+            interface.name = id.name;
+            interface.location = id.location;
+            if (!interfaceVariable(module, type_id, interface, error))
+            {
+                return false;
+            }
+            (variable.storage == StorageClass::Input ? reflection.inputs
+                                                     : reflection.outputs)
+                .push_back(interface);
+            continue;
+        }
+
+        if (variable.storage == StorageClass::PushConstant)
+        {
+            reflection.has_push_constants = true;
+            reflection.push_constants = blockLayout(module, type_id);
+            continue;
+        }
+
+        if (variable.storage != StorageClass::UniformConstant &&
+            variable.storage != StorageClass::Uniform &&
+            variable.storage != StorageClass::StorageBuffer)
+        {
+            continue;
+        }
+
+        DescriptorBinding binding;
+        binding.set = id.set;
+        binding.binding = id.binding;
+        binding.name = id.name;
+        uint32_t element_id = type_id;
+        if (type.op == Op::TypeArray)
+        {
+            if (!arrayLength(module, type, binding.count))
+            {
+                error = "Array size of '" + id.name + "' isn't constant";
+                return false;
+            }
+            element_id = operand(type, 0);
+        }
+        else if (type.op == Op::TypeRuntimeArray)
+        {
+            binding.count = 0;
+            element_id = operand(type, 0);
+        }
+        const Id& element = module.id(element_id);
+
+        if (variable.storage == StorageClass::UniformConstant)
+        {
+            if (!descriptorType(element, binding.type))
+            {
+                // Not a descriptor, e.g. an acceleration structure this
+                // reflection doesn't know.
+                continue;
+            }
+        }
+        else
+        {
+            binding.type = variable.storage == StorageClass::StorageBuffer ||
+                                   element.buffer_block
+                               ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+                               : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            binding.block = blockLayout(module, element_id);
+        }
+        reflection.bindings.push_back(binding);
+    }
+
+    std::sort(
+        reflection.bindings.begin(),
+        reflection.bindings.end(),
+        [](const DescriptorBinding& a, const DescriptorBinding& b) {
+            return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+        });
+    auto by_location = [](const InterfaceVariable& a,
+                          const InterfaceVariable& b) {
+        return a.location < b.location;
+    };
+    std::sort(reflection.inputs.begin(), reflection.inputs.end(), by_location);
+    std::sort(
+        reflection.outputs.begin(), reflection.outputs.end(), by_location);
+    return true;
+}
+
+bool checkVertexInput(
+    const ShaderReflection& reflection,
+    const std::vector<VkVertexInputAttributeDescription>& attributes,
+    std::string& error)
+{
+    for (const InterfaceVariable& input : reflection.inputs)
+    {
+        for (uint32_t location = input.location;
+             location < input.location + input.locations;
+             ++location)
+        {
+            auto attribute = std::find_if(
+                attributes.begin(),
+                attributes.end(),
+                [location](const VkVertexInputAttributeDescription& a) {
+                    return a.location == location;
+                });
+            if (attribute == attributes.end())
+            {
+                error = "No attribute for input '" + input.name +
+                        "' at location " + std::to_string(location);
+                return false;
+            }
+            if (numericType(attribute->format) != numericType(input.format))
+            {
+                error = "Attribute format of input '" + input.name +
+                        "' at location " + std::to_string(location) +
+                        " has another numeric type";
+                return false;
+            }
+        }
+    }
+    return true;
+}
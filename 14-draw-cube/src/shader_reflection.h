@@ -0,0 +1,104 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct BlockMember
+{
+    std::string name;
+    uint32_t offset = 0;
+    uint32_t size = 0;
+};
+
+/**
+ * Explicit layout of a uniform, storage or push constant block as laid out
+ * by the compiler (std140, std430 or scalar). size ends at the last byte
+ * of the last member and is 0 for a sole runtime array.
+ */
+struct BlockLayout
+{
+    std::string name;
+    uint32_t size = 0;
+    std::vector<BlockMember> members;
+};
+
+struct DescriptorBinding
+{
+    uint32_t set = 0;
+    uint32_t binding = 0;
+    VkDescriptorType type = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+    // 0 for a runtime sized array.
+    uint32_t count = 1;
+    std::string name;
+    // Buffers only.
+    BlockLayout block;
+};
+
+/** A stage input or output, a matrix or array takes several locations. */
+struct InterfaceVariable
+{
+    std::string name;
+    uint32_t location = 0;
+    uint32_t locations = 1;
+    // The 32 bit format of one location, e.g. R32G32B32A32_SFLOAT for vec4.
+    VkFormat format = VK_FORMAT_UNDEFINED;
+};
+
+struct ShaderReflection
+{
+    VkShaderStageFlagBits stage = VK_SHADER_STAGE_VERTEX_BIT;
+    std::string entry_point;
+    std::vector<DescriptorBinding> bindings;
+    std::vector<InterfaceVariable> inputs;
+    std::vector<InterfaceVariable> outputs;
+    bool has_push_constants = false;
+    BlockLayout push_constants;
+};
+
+/**
+ * Extracts the resource interface of the first entry point straight from
+ * the SPIR-V words. Built-in variables are skipped. Returns false with a
+ * message for malformed modules; constructs a tool can't map to Vulkan,
+ * like specialization constant array sizes, are reported the same way.
+ */
+bool reflectShader(
+    const std::vector<uint8_t>& spirv,
+    ShaderReflection& reflection,
+    std::string& error);
+
+/**
+ * Checks that attributes feed every input of a vertex shader with a format
+ * of the same numeric type: float, signed or unsigned integer. Normalized
+ * and half formats count as float.
+ */
+bool checkVertexInput(
+    const ShaderReflection& reflection,
+    const std::vector<VkVertexInputAttributeDescription>& attributes,
+    std::string& error);
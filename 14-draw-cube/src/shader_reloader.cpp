@@ -0,0 +1,174 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "shader_reloader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+const std::chrono::milliseconds c_poll_timeout(100);
+// Editors often write a file in several steps; changes that arrive within
+// this window are handled together.
+const std::chrono::milliseconds c_debounce(50);
+
+} // namespace
+
+ShaderReloader::ShaderReloader(
+    VkDevice device, ShaderManager& shader_manager, std::ostream& log)
+    : device_(device)
+    , shader_manager_(shader_manager)
+    , log_(log)
+{
+}
+
+ShaderReloader::~ShaderReloader()
+{
+    stop_ = true;
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+    for (const RebuiltPipeline& rebuilt : rebuilt_)
+    {
+        vkDestroyPipeline(device_, rebuilt.pipeline, nullptr);
+    }
+}
+
+uint32_t ShaderReloader::addPipeline(
+    std::vector<ShaderSource> sources, BuildPipeline build)
+{
+    targets_.push_back({std::move(sources), std::move(build)});
+    return static_cast<uint32_t>(targets_.size() - 1);
+}
+
+bool ShaderReloader::start(const std::string& dir)
+{
+    // The watch is set up before returning, so no change made after
+    // start() is missed.
+    if (!watcher_.watch(dir))
+    {
+        return false;
+    }
+    thread_ = std::thread(&ShaderReloader::run, this);
+    return true;
+}
+
+std::vector<RebuiltPipeline> ShaderReloader::takeRebuilt()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::exchange(rebuilt_, {});
+}
+
+void ShaderReloader::run()
+{
+    while (!stop_)
+    {
+        std::vector<std::string> changed = watcher_.poll(c_poll_timeout);
+        if (changed.empty())
+        {
+            continue;
+        }
+        std::this_thread::sleep_for(c_debounce);
+        for (const std::string& name :
+             watcher_.poll(std::chrono::milliseconds(0)))
+        {
+            if (std::find(changed.begin(), changed.end(), name) ==
+                changed.end())
+            {
+                changed.push_back(name);
+            }
+        }
+
+        for (uint32_t id = 0; id < targets_.size(); ++id)
+        {
+            const std::vector<ShaderSource>& sources = targets_[id].sources;
+            bool affected = std::any_of(
+                sources.begin(),
+                sources.end(),
+                [&changed](const ShaderSource& source) {
+                    const std::string name =
+                        std::filesystem::path(source.path).filename().string();
+                    return std::find(changed.begin(), changed.end(), name) !=
+                           changed.end();
+                });
+            if (affected)
+            {
+                rebuild(id);
+            }
+        }
+    }
+}
+
+void ShaderReloader::rebuild(uint32_t id)
+{
+    const Target& target = targets_[id];
+    std::vector<ShaderBinary> binaries;
+    binaries.reserve(target.sources.size());
+    for (const ShaderSource& source : target.sources)
+    {
+        binaries.push_back(shader_manager_.load(source));
+        if (!binaries.back().ok)
+        {
+            std::cerr << "Shader reload failed, keeping the current pipeline"
+                      << std::endl
+                      << binaries.back().log;
+            return;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    if (VkResult result = target.build(binaries, pipeline);
+        result != VK_SUCCESS)
+    {
+        std::cerr << "Shader reload failed to build the pipeline: " << result
+                  << std::endl;
+        return;
+    }
+    std::chrono::duration<double, std::milli> build_ms =
+        std::chrono::steady_clock::now() - start;
+    log_ << "Rebuilt pipeline " << id << " in " << build_ms.count() << " ms"
+         << std::endl;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto pending = std::find_if(
+        rebuilt_.begin(), rebuilt_.end(), [id](const RebuiltPipeline& r) {
+            return r.id == id;
+        });
+    if (pending != rebuilt_.end())
+    {
+        // Never bound, the render thread hasn't taken it yet.
+        vkDestroyPipeline(device_, pending->pipeline, nullptr);
+        pending->pipeline = pipeline;
+    }
+    else
+    {
+        rebuilt_.push_back({id, pipeline});
+    }
+}
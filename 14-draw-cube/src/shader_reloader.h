@@ -0,0 +1,110 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "file_watcher.h"
+#include "shader_manager.h"
+
+struct RebuiltPipeline
+{
+    uint32_t id = 0;
+    VkPipeline pipeline = VK_NULL_HANDLE;
+};
+
+/**
+ * Rebuilds pipelines when their shader sources change on disk. A
+ * background thread watches the shader directory, recompiles the sources
+ * of every affected pipeline and builds the new pipeline itself, so the
+ * render thread only swaps handles at a frame boundary and never waits
+ * for the compiler or the driver.
+ *
+ * A source that fails to compile is reported and leaves the pipeline in
+ * use untouched; saving a fixed version triggers the next attempt.
+ */
+class ShaderReloader
+{
+public:
+    /**
+     * Receives the binaries in the order of the registered sources. Called
+     * on the reloader thread, so it may only read state that the render
+     * thread doesn't modify while the reloader runs.
+     */
+    using BuildPipeline = std::function<VkResult(
+        const std::vector<ShaderBinary>& binaries, VkPipeline& pipeline)>;
+
+    /** Rebuilt pipelines are reported to log, failures to std::cerr. */
+    ShaderReloader(
+        VkDevice device, ShaderManager& shader_manager, std::ostream& log);
+    ~ShaderReloader();
+
+    ShaderReloader(const ShaderReloader&) = delete;
+    ShaderReloader& operator=(const ShaderReloader&) = delete;
+
+    /** Returns the id that identifies the pipeline in takeRebuilt(). */
+    uint32_t addPipeline(
+        std::vector<ShaderSource> sources, BuildPipeline build);
+
+    /** Must be called after all pipelines have been added. */
+    bool start(const std::string& dir);
+
+    /**
+     * Returns the pipelines built since the last call, at most one per id.
+     * The caller owns them and the pipelines they replace.
+     */
+    std::vector<RebuiltPipeline> takeRebuilt();
+
+private:
+    struct Target
+    {
+        std::vector<ShaderSource> sources;
+        BuildPipeline build;
+    };
+
+    void run();
+    void rebuild(uint32_t id);
+
+    VkDevice device_;
+    ShaderManager& shader_manager_;
+    std::ostream& log_;
+    std::vector<Target> targets_;
+    FileWatcher watcher_;
+
+    std::thread thread_;
+    std::atomic<bool> stop_{false};
+
+    std::mutex mutex_;
+    std::vector<RebuiltPipeline> rebuilt_;
+};
@@ -0,0 +1,386 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "staging_uploader.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Copies are done in multiples of this to keep the source offsets friendly
+// to the copy engine, it satisfies optimalBufferCopyOffsetAlignment on
+// common hardware.
+constexpr VkDeviceSize c_ring_alignment = 256;
+
+VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+StagingUploader::StagingUploader(
+    VkDevice device,
+    VkQueue queue,
+    uint32_t queue_family_index,
+    MemoryAllocator& memory_allocator,
+    VkDeviceSize ring_size)
+    : device_(device)
+    , queue_(queue)
+    , queue_family_index_(queue_family_index)
+    , memory_allocator_(memory_allocator)
+    , ring_size_(alignUp(ring_size, c_ring_alignment))
+{
+}
+
+StagingUploader::~StagingUploader()
+{
+    if (device_ == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    waitIdle();
+    for (const auto& batch : free_batches_)
+    {
+        vkDestroyFence(device_, batch.fence, nullptr);
+    }
+    if (recording_.fence != VK_NULL_HANDLE)
+    {
+        vkDestroyFence(device_, recording_.fence, nullptr);
+    }
+    if (cmd_pool_ != VK_NULL_HANDLE)
+    {
+        // Frees the command buffers of all batches as well.
+        vkDestroyCommandPool(device_, cmd_pool_, nullptr);
+    }
+    if (ring_buf_ != VK_NULL_HANDLE)
+    {
+        vkDestroyBuffer(device_, ring_buf_, nullptr);
+    }
+    memory_allocator_.free(ring_mem_);
+}
+
+VkResult StagingUploader::create()
+{
+    VkCommandPoolCreateInfo cmd_pool_info = {};
+    cmd_pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    cmd_pool_info.queueFamilyIndex = queue_family_index_;
+    cmd_pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT |
+                          VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    if (VkResult result =
+            vkCreateCommandPool(device_, &cmd_pool_info, nullptr, &cmd_pool_);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkBufferCreateInfo ring_buf_info = {};
+    ring_buf_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    ring_buf_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    ring_buf_info.size = ring_size_;
+    ring_buf_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (VkResult result =
+            vkCreateBuffer(device_, &ring_buf_info, nullptr, &ring_buf_);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    // The GPU reads staging data once, write combined system memory is the
+    // best fit, device local host visible memory is kept for direct writes.
+    return memory_allocator_.allocateBuffer(
+        ring_buf_,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        0,
+        ring_mem_);
+}
+
+VkResult StagingUploader::createBuffer(
+    const void* data,
+    VkDeviceSize size,
+    VkBufferUsageFlags usage,
+    VkBuffer& buffer,
+    MemoryAllocation& allocation)
+{
+    VkBufferCreateInfo buf_info = {};
+    buf_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buf_info.usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    buf_info.size = size;
+    buf_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (VkResult result = vkCreateBuffer(device_, &buf_info, nullptr, &buffer);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    if (VkResult result = memory_allocator_.allocateBuffer(
+            buffer,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            allocation);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    const VkMemoryPropertyFlags mem_flags =
+        memory_allocator_.memoryProperties()
+            .memoryTypes[allocation.memory_type_index]
+            .propertyFlags;
+    if (allocation.mapped != nullptr &&
+        (mem_flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0)
+    {
+        std::memcpy(allocation.mapped, data, size);
+        direct_bytes_ += size;
+        return VK_SUCCESS;
+    }
+
+    return upload(buffer, 0, data, size);
+}
+
+VkResult StagingUploader::upload(
+    VkBuffer dst, VkDeviceSize dst_offset, const void* data, VkDeviceSize size)
+{
+    const auto* src = static_cast<const uint8_t*>(data);
+    while (size > 0)
+    {
+        const VkDeviceSize chunk_size = std::min(size, ring_size_);
+
+        VkDeviceSize ring_offset = 0;
+        if (VkResult result = reserve(chunk_size, ring_offset);
+            result != VK_SUCCESS)
+        {
+            return result;
+        }
+        if (VkResult result = beginBatch(); result != VK_SUCCESS)
+        {
+            return result;
+        }
+
+        std::memcpy(ring_mem_.mapped + ring_offset, src, chunk_size);
+
+        VkBufferCopy region = {};
+        region.srcOffset = ring_offset;
+        region.dstOffset = dst_offset;
+        region.size = chunk_size;
+        vkCmdCopyBuffer(recording_.cmd_buffer, ring_buf_, dst, 1, &region);
+
+        staged_bytes_ += chunk_size;
+        src += chunk_size;
+        dst_offset += chunk_size;
+        size -= chunk_size;
+    }
+    return VK_SUCCESS;
+}
+
+VkResult StagingUploader::flush()
+{
+    if (!recording_started_)
+    {
+        return VK_SUCCESS;
+    }
+
+    // Uploaded buffers can be read by any later stage: vertex and index
+    // fetch, uniform and storage reads or indirect draws.
+    VkMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+    vkCmdPipelineBarrier(
+        recording_.cmd_buffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        1,
+        &barrier,
+        0,
+        nullptr,
+        0,
+        nullptr);
+
+    if (VkResult result = vkEndCommandBuffer(recording_.cmd_buffer);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkSubmitInfo submit_info = {};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &recording_.cmd_buffer;
+    if (VkResult result =
+            vkQueueSubmit(queue_, 1, &submit_info, recording_.fence);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    submitted_.push_back(recording_);
+    recording_ = {};
+    recording_started_ = false;
+    ++submits_;
+    return VK_SUCCESS;
+}
+
+VkResult StagingUploader::waitIdle()
+{
+    while (!submitted_.empty())
+    {
+        if (VkResult result = retireOldestBatch(); result != VK_SUCCESS)
+        {
+            return result;
+        }
+    }
+    return VK_SUCCESS;
+}
+
+void StagingUploader::writeStats(std::ostream& out) const
+{
+    out << "Uploads: staged: " << staged_bytes_ << " bytes in " << submits_
+        << " submits, ring stalls: " << ring_stalls_
+        << ", direct: " << direct_bytes_ << " bytes" << std::endl;
+}
+
+VkResult StagingUploader::reserve(VkDeviceSize size, VkDeviceSize& offset)
+{
+    const VkDeviceSize aligned_size = alignUp(size, c_ring_alignment);
+    for (;;)
+    {
+        // Allocations never straddle the end of the ring, the tail that
+        // doesn't fit is skipped and counted as used.
+        const VkDeviceSize wasted =
+            head_ + aligned_size > ring_size_ ? ring_size_ - head_ : 0;
+        const VkDeviceSize needed = wasted + aligned_size;
+        if (used_ + needed <= ring_size_)
+        {
+            offset = wasted > 0 ? 0 : head_;
+            head_ = (offset + aligned_size) % ring_size_;
+            used_ += needed;
+            recording_.ring_bytes += needed;
+            return VK_SUCCESS;
+        }
+
+        // The ring is full: hand the pending copies to the GPU and wait for
+        // the oldest batch to give its space back.
+        if (VkResult result = flush(); result != VK_SUCCESS)
+        {
+            return result;
+        }
+        if (submitted_.empty())
+        {
+            return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        }
+        ++ring_stalls_;
+        if (VkResult result = retireOldestBatch(); result != VK_SUCCESS)
+        {
+            return result;
+        }
+    }
+}
+
+VkResult StagingUploader::beginBatch()
+{
+    if (recording_started_)
+    {
+        return VK_SUCCESS;
+    }
+
+    if (recording_.cmd_buffer == VK_NULL_HANDLE)
+    {
+        if (!free_batches_.empty())
+        {
+            const VkDeviceSize ring_bytes = recording_.ring_bytes;
+            recording_ = free_batches_.back();
+            recording_.ring_bytes = ring_bytes;
+            free_batches_.pop_back();
+        }
+        else
+        {
+            VkCommandBufferAllocateInfo cmd_buffer_info = {};
+            cmd_buffer_info.sType =
+                VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            cmd_buffer_info.commandPool = cmd_pool_;
+            cmd_buffer_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            cmd_buffer_info.commandBufferCount = 1;
+            if (VkResult result = vkAllocateCommandBuffers(
+                    device_, &cmd_buffer_info, &recording_.cmd_buffer);
+                result != VK_SUCCESS)
+            {
+                return result;
+            }
+
+            VkFenceCreateInfo fence_info = {};
+            fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            if (VkResult result = vkCreateFence(
+                    device_, &fence_info, nullptr, &recording_.fence);
+                result != VK_SUCCESS)
+            {
+                return result;
+            }
+        }
+    }
+
+    VkCommandBufferBeginInfo begin_info = {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (VkResult result =
+            vkBeginCommandBuffer(recording_.cmd_buffer, &begin_info);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+    recording_started_ = true;
+    return VK_SUCCESS;
+}
+
+VkResult StagingUploader::retireOldestBatch()
+{
+    Batch batch = submitted_.front();
+    if (VkResult result =
+            vkWaitForFences(device_, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+    if (VkResult result = vkResetFences(device_, 1, &batch.fence);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+    if (VkResult result = vkResetCommandBuffer(batch.cmd_buffer, 0);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    submitted_.pop_front();
+    used_ -= batch.ring_bytes;
+    batch.ring_bytes = 0;
+    free_batches_.push_back(batch);
+    return VK_SUCCESS;
+}
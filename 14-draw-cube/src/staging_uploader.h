@@ -0,0 +1,132 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <deque>
+#include <ostream>
+#include <vector>
+
+#include "memory_allocator.h"
+
+/**
+ * Uploads data into DEVICE_LOCAL buffers through a persistently mapped
+ * staging ring buffer.
+ *
+ * Copies are batched into one command buffer until flush() submits them.
+ * Every submitted batch owns the part of the ring it copied from until its
+ * fence signals; when the ring is full the oldest batches are waited on and
+ * their space is reused. Buffers that land in DEVICE_LOCAL memory which is
+ * also host visible and coherent (resizable BAR, integrated GPUs) are
+ * written directly and skip the ring altogether.
+ */
+class StagingUploader
+{
+public:
+    static constexpr VkDeviceSize c_default_ring_size = 8 * 1024 * 1024;
+
+    StagingUploader(
+        VkDevice device,
+        VkQueue queue,
+        uint32_t queue_family_index,
+        MemoryAllocator& memory_allocator,
+        VkDeviceSize ring_size = c_default_ring_size);
+    ~StagingUploader();
+
+    StagingUploader(const StagingUploader&) = delete;
+    StagingUploader& operator=(const StagingUploader&) = delete;
+
+    VkResult create();
+
+    /**
+     * Creates a DEVICE_LOCAL buffer and uploads data into it. The contents
+     * are only visible to the GPU after the next flush().
+     */
+    VkResult createBuffer(
+        const void* data,
+        VkDeviceSize size,
+        VkBufferUsageFlags usage,
+        VkBuffer& buffer,
+        MemoryAllocation& allocation);
+
+    /**
+     * Queues a copy into dst. The buffer needs TRANSFER_DST usage. Data
+     * larger than the ring is split into several copies.
+     */
+    VkResult upload(
+        VkBuffer dst,
+        VkDeviceSize dst_offset,
+        const void* data,
+        VkDeviceSize size);
+
+    /**
+     * Submits the queued copies followed by a barrier that makes them
+     * visible to all later commands on the queue.
+     */
+    VkResult flush();
+
+    /** Waits for all submitted batches. */
+    VkResult waitIdle();
+
+    void writeStats(std::ostream& out) const;
+
+private:
+    struct Batch
+    {
+        VkCommandBuffer cmd_buffer = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+        // Ring bytes the batch copies from, including wrap around waste.
+        VkDeviceSize ring_bytes = 0;
+    };
+
+    VkResult reserve(VkDeviceSize size, VkDeviceSize& offset);
+    VkResult beginBatch();
+    VkResult retireOldestBatch();
+
+    VkDevice device_;
+    VkQueue queue_;
+    uint32_t queue_family_index_;
+    MemoryAllocator& memory_allocator_;
+    const VkDeviceSize ring_size_;
+
+    VkCommandPool cmd_pool_ = VK_NULL_HANDLE;
+    VkBuffer ring_buf_ = VK_NULL_HANDLE;
+    MemoryAllocation ring_mem_;
+
+    VkDeviceSize head_ = 0;
+    VkDeviceSize used_ = 0;
+
+    Batch recording_;
+    bool recording_started_ = false;
+    std::deque<Batch> submitted_;
+    std::vector<Batch> free_batches_;
+
+    uint64_t staged_bytes_ = 0;
+    uint64_t direct_bytes_ = 0;
+    uint64_t submits_ = 0;
+    uint64_t ring_stalls_ = 0;
+};
@@ -0,0 +1,119 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "thread_pool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(uint32_t threads_num)
+{
+    if (threads_num == 0)
+    {
+        threads_num = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (uint32_t i = 1; i < threads_num; ++i)
+    {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (std::thread& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(
+    std::size_t count,
+    std::size_t chunk_size,
+    const std::function<void(std::size_t, std::size_t, std::size_t)>& body)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    chunk_size = std::max<std::size_t>(chunk_size, 1);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    body_ = &body;
+    count_ = count;
+    chunk_size_ = chunk_size;
+    chunks_num_ = (count + chunk_size - 1) / chunk_size;
+    next_chunk_ = 0;
+    chunks_done_ = 0;
+    ++generation_;
+    if (chunks_num_ > 1)
+    {
+        work_cv_.notify_all();
+    }
+
+    runChunks(lock);
+    done_cv_.wait(lock, [this] { return chunks_done_ == chunks_num_; });
+    body_ = nullptr;
+}
+
+void ThreadPool::workerLoop()
+{
+    uint64_t seen_generation = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        work_cv_.wait(lock, [&] {
+            return stop_ || generation_ != seen_generation;
+        });
+        if (stop_)
+        {
+            return;
+        }
+        seen_generation = generation_;
+        runChunks(lock);
+    }
+}
+
+void ThreadPool::runChunks(std::unique_lock<std::mutex>& lock)
+{
+    while (body_ != nullptr && next_chunk_ < chunks_num_)
+    {
+        const std::size_t chunk = next_chunk_++;
+        const std::size_t begin = chunk * chunk_size_;
+        const std::size_t end = std::min(begin + chunk_size_, count_);
+        const auto* body = body_;
+
+        lock.unlock();
+        (*body)(chunk, begin, end);
+        lock.lock();
+
+        if (++chunks_done_ == chunks_num_)
+        {
+            done_cv_.notify_all();
+        }
+    }
+}
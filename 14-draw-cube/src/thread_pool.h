@@ -0,0 +1,84 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed set of worker threads for data parallel loops. The calling thread
+ * works on the loop as well, so a pool of one thread runs it inline.
+ */
+class ThreadPool
+{
+public:
+    /** 0 picks the number of hardware threads. */
+    explicit ThreadPool(uint32_t threads_num = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /** Threads taking part in a loop, including the calling one. */
+    uint32_t size() const { return static_cast<uint32_t>(workers_.size()) + 1; }
+
+    /**
+     * Splits [0, count) into chunks of chunk_size and runs body(chunk,
+     * begin, end) for every chunk, returns when all are done. Chunks are
+     * numbered in order, so results can be stored per chunk and merged
+     * deterministically. Only one loop can run at a time.
+     */
+    void parallelFor(
+        std::size_t count,
+        std::size_t chunk_size,
+        const std::function<void(std::size_t, std::size_t, std::size_t)>&
+            body);
+
+private:
+    void workerLoop();
+    /** Runs chunks of the current loop until none is left. */
+    void runChunks(std::unique_lock<std::mutex>& lock);
+
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    bool stop_ = false;
+    uint64_t generation_ = 0;
+
+    const std::function<void(std::size_t, std::size_t, std::size_t)>* body_ =
+        nullptr;
+    std::size_t count_ = 0;
+    std::size_t chunk_size_ = 0;
+    std::size_t chunks_num_ = 0;
+    std::size_t next_chunk_ = 0;
+    std::size_t chunks_done_ = 0;
+};
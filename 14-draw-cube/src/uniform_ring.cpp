@@ -0,0 +1,117 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "uniform_ring.h"
+
+#include <algorithm>
+#include <limits>
+
+UniformRing::UniformRing(
+    VkDevice device,
+    MemoryAllocator& memory_allocator,
+    const VkPhysicalDeviceLimits& limits,
+    VkDescriptorType descriptor_type)
+    : device_(device)
+    , memory_allocator_(memory_allocator)
+    , storage_(
+          descriptor_type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC ||
+          descriptor_type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+    , alignment_(std::max<VkDeviceSize>(
+          storage_ ? limits.minStorageBufferOffsetAlignment
+                   : limits.minUniformBufferOffsetAlignment,
+          1))
+    , max_range_(
+          storage_ ? limits.maxStorageBufferRange
+                   : limits.maxUniformBufferRange)
+{
+}
+
+UniformRing::~UniformRing()
+{
+    if (buffer_ != VK_NULL_HANDLE)
+    {
+        vkDestroyBuffer(device_, buffer_, nullptr);
+    }
+    memory_allocator_.free(buffer_mem_);
+}
+
+VkResult UniformRing::create(VkDeviceSize region_size, uint32_t regions_num)
+{
+    region_size_ = alignedSize(region_size);
+    regions_num_ = regions_num;
+
+    // Dynamic offsets are 32 bit.
+    const VkDeviceSize size = region_size_ * regions_num_;
+    if (size == 0 || size > std::numeric_limits<uint32_t>::max())
+    {
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+
+    VkBufferCreateInfo buffer_info = {};
+    buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_info.usage = storage_ ? VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+                                 : VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    buffer_info.size = size;
+    buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (VkResult result =
+            vkCreateBuffer(device_, &buffer_info, nullptr, &buffer_);
+        result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    // CPU writes every frame and the GPU reads once, so device local host
+    // visible memory is preferred where available.
+    return memory_allocator_.allocateBuffer(
+        buffer_,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        buffer_mem_);
+}
+
+VkDeviceSize UniformRing::alignedSize(VkDeviceSize size) const
+{
+    return (size + alignment_ - 1) / alignment_ * alignment_;
+}
+
+void UniformRing::beginRegion(uint32_t region)
+{
+    region_begin_ = region_size_ * region;
+    region_head_ = region_begin_;
+}
+
+std::pair<uint8_t*, uint32_t> UniformRing::allocate(VkDeviceSize size)
+{
+    const VkDeviceSize aligned_size = alignedSize(size);
+    if (size > max_range_ ||
+        region_head_ + aligned_size > region_begin_ + region_size_)
+    {
+        return {nullptr, 0};
+    }
+
+    const VkDeviceSize offset = region_head_;
+    region_head_ += aligned_size;
+    return {buffer_mem_.mapped + offset, static_cast<uint32_t>(offset)};
+}
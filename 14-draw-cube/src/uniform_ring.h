@@ -0,0 +1,111 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "memory_allocator.h"
+
+/**
+ * Persistently mapped uniform buffer split into regions, one per set of
+ * command buffers that can be in flight at once. Every frame writes its
+ * uniforms into its own region with a bump allocator, and the shaders read
+ * them through a single VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC descriptor
+ * with the returned offsets as dynamic offsets.
+ *
+ * The same scheme backs VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, with the
+ * storage buffer alignment and range limits. Plain storage buffer
+ * descriptors, e.g. of a bindless heap, cover a region each instead.
+ *
+ * A region must not be reset while the GPU can still read it, i.e. before
+ * the fence of the frame that used it last has been waited on.
+ */
+class UniformRing
+{
+public:
+    UniformRing(
+        VkDevice device,
+        MemoryAllocator& memory_allocator,
+        const VkPhysicalDeviceLimits& limits,
+        VkDescriptorType descriptor_type =
+            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+    ~UniformRing();
+
+    UniformRing(const UniformRing&) = delete;
+    UniformRing& operator=(const UniformRing&) = delete;
+
+    VkResult create(VkDeviceSize region_size, uint32_t regions_num);
+
+    VkBuffer buffer() const { return buffer_; }
+    VkDeviceSize alignment() const { return alignment_; }
+
+    /** Rounds size up to the offset alignment of the descriptor type. */
+    VkDeviceSize alignedSize(VkDeviceSize size) const;
+
+    VkDeviceSize regionOffset(uint32_t region) const
+    {
+        return region_size_ * region;
+    }
+
+    /** Restarts allocation at the beginning of the region. */
+    void beginRegion(uint32_t region);
+
+    /**
+     * Returns the mapped pointer and the dynamic offset of size bytes in the
+     * current region, the pointer is null when the region is full.
+     */
+    std::pair<uint8_t*, uint32_t> allocate(VkDeviceSize size);
+
+    template <typename T>
+    std::pair<bool, uint32_t> push(const T& value)
+    {
+        auto[data, offset] = allocate(sizeof(T));
+        if (data == nullptr)
+        {
+            return {false, 0};
+        }
+        std::memcpy(data, &value, sizeof(T));
+        return {true, offset};
+    }
+
+private:
+    VkDevice device_;
+    MemoryAllocator& memory_allocator_;
+    const bool storage_;
+    const VkDeviceSize alignment_;
+    const VkDeviceSize max_range_;
+
+    VkBuffer buffer_ = VK_NULL_HANDLE;
+    MemoryAllocation buffer_mem_;
+    VkDeviceSize region_size_ = 0;
+    uint32_t regions_num_ = 0;
+
+    VkDeviceSize region_begin_ = 0;
+    VkDeviceSize region_head_ = 0;
+};
@@ -0,0 +1,334 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "vertex_format.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// VERTEX_FORMAT_NO_SIMD forces the scalar encoders, the tests build both.
+#if (defined(__SSE2__) || defined(_M_X64)) && !defined(VERTEX_FORMAT_NO_SIMD)
+#include <immintrin.h>
+#define VERTEX_FORMAT_SSE2 1
+#endif
+
+namespace {
+
+uint32_t positionSize(PositionEncoding encoding)
+{
+    return encoding == PositionEncoding::Float32 ? 12 : 8;
+}
+
+uint32_t colorSize(ColorEncoding encoding)
+{
+    return encoding == ColorEncoding::Float32 ? 12 : 4;
+}
+
+uint32_t normalSize(NormalEncoding encoding)
+{
+    switch (encoding)
+    {
+    case NormalEncoding::None:
+        return 0;
+    case NormalEncoding::Float32:
+        return 12;
+    case NormalEncoding::Octahedral16:
+        return 4;
+    }
+    return 0;
+}
+
+uint32_t floatBits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float bitsFloat(uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/** Float to half with round to nearest even, after F. Giesen. */
+uint16_t floatToHalf(float value)
+{
+    uint32_t bits = floatBits(value);
+    const uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint32_t half;
+    if (bits >= 0x47800000u)
+    {
+        // Overflow to infinity, NaN stays NaN.
+        half = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+    }
+    else if (bits < 0x38800000u)
+    {
+        // Subnormal or zero: let the FPU round by adding a magic number
+        // that pushes the mantissa bits into place.
+        const float magic = bitsFloat(126u << 23);
+        half = floatBits(bitsFloat(bits) + magic) - (126u << 23);
+    }
+    else
+    {
+        const uint32_t mantissa_odd = (bits >> 13) & 1u;
+        bits += ((15u - 127u) << 23) + 0xFFFu + mantissa_odd;
+        half = bits >> 13;
+    }
+    return static_cast<uint16_t>((sign >> 16) | half);
+}
+
+// std::nearbyint rounds half to even in the default rounding mode, like
+// _mm_cvtps_epi32 does, so the encoders give the same bytes on every ISA.
+int16_t toSnorm16(float value)
+{
+    return static_cast<int16_t>(
+        std::nearbyint(std::clamp(value, -1.f, 1.f) * 32767.f));
+}
+
+#if !VERTEX_FORMAT_SSE2
+uint8_t toUnorm8(float value)
+{
+    return static_cast<uint8_t>(
+        std::nearbyint(std::clamp(value, 0.f, 1.f) * 255.f));
+}
+#endif
+
+/** Writes x, y, z and w = 1 as four normalized 16 bit integers. */
+void encodeSnorm16x4(const float* xyz, uint8_t* out)
+{
+#if VERTEX_FORMAT_SSE2
+    __m128 v = _mm_setr_ps(xyz[0], xyz[1], xyz[2], 1.f);
+    v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-1.f)), _mm_set1_ps(1.f));
+    const __m128i i = _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(32767.f)));
+    _mm_storel_epi64(
+        reinterpret_cast<__m128i*>(out), _mm_packs_epi32(i, i));
+#else
+    const int16_t packed[4] = {
+        toSnorm16(xyz[0]), toSnorm16(xyz[1]), toSnorm16(xyz[2]), 32767};
+    std::memcpy(out, packed, sizeof(packed));
+#endif
+}
+
+/** Writes x, y, z and w = 1 as four half floats. */
+void encodeHalfx4(const float* xyz, uint8_t* out)
+{
+#if VERTEX_FORMAT_SSE2 && defined(__F16C__)
+    const __m128 v = _mm_setr_ps(xyz[0], xyz[1], xyz[2], 1.f);
+    _mm_storel_epi64(
+        reinterpret_cast<__m128i*>(out),
+        _mm_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+#else
+    const uint16_t packed[4] = {
+        floatToHalf(xyz[0]), floatToHalf(xyz[1]), floatToHalf(xyz[2]), 0x3C00};
+    std::memcpy(out, packed, sizeof(packed));
+#endif
+}
+
+/** Writes r, g, b and alpha = 1 as four normalized bytes. */
+void encodeUnorm8x4(const float* rgb, uint8_t* out)
+{
+#if VERTEX_FORMAT_SSE2
+    __m128 v = _mm_setr_ps(rgb[0], rgb[1], rgb[2], 1.f);
+    v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.f));
+    const __m128i i = _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(255.f)));
+    const __m128i words = _mm_packs_epi32(i, i);
+    const int packed = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+    std::memcpy(out, &packed, sizeof(packed));
+#else
+    const uint8_t packed[4] = {
+        toUnorm8(rgb[0]), toUnorm8(rgb[1]), toUnorm8(rgb[2]), 255};
+    std::memcpy(out, packed, sizeof(packed));
+#endif
+}
+
+/**
+ * Projects the direction onto the octahedron |x| + |y| + |z| = 1 and
+ * unfolds the lower half over the diagonals into the [-1, 1] square.
+ */
+void encodeOctahedral16(const float* normal, uint8_t* out)
+{
+    float x = normal[0];
+    float y = normal[1];
+    const float z = normal[2];
+    const float length = std::fabs(x) + std::fabs(y) + std::fabs(z);
+    if (length > 0.f)
+    {
+        x /= length;
+        y /= length;
+    }
+    if (z < 0.f)
+    {
+        const float folded_x = (1.f - std::fabs(y)) * (x >= 0.f ? 1.f : -1.f);
+        const float folded_y = (1.f - std::fabs(x)) * (y >= 0.f ? 1.f : -1.f);
+        x = folded_x;
+        y = folded_y;
+    }
+    const int16_t packed[2] = {toSnorm16(x), toSnorm16(y)};
+    std::memcpy(out, packed, sizeof(packed));
+}
+
+} // namespace
+
+uint32_t VertexFormat::stride() const
+{
+    return positionSize(position) + colorSize(color) + normalSize(normal);
+}
+
+std::vector<VkVertexInputAttributeDescription> VertexFormat::attributes(
+    uint32_t binding, uint32_t first_location) const
+{
+    std::vector<VkVertexInputAttributeDescription> attributes;
+
+    VkVertexInputAttributeDescription attribute = {};
+    attribute.binding = binding;
+    attribute.location = first_location;
+    attribute.offset = 0;
+    switch (position)
+    {
+    case PositionEncoding::Float32:
+        attribute.format = VK_FORMAT_R32G32B32_SFLOAT;
+        break;
+    case PositionEncoding::Snorm16:
+        attribute.format = VK_FORMAT_R16G16B16A16_SNORM;
+        break;
+    case PositionEncoding::Half:
+        attribute.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+        break;
+    }
+    attributes.push_back(attribute);
+
+    attribute.location++;
+    attribute.offset += positionSize(position);
+    attribute.format = color == ColorEncoding::Float32
+                           ? VK_FORMAT_R32G32B32_SFLOAT
+                           : VK_FORMAT_R8G8B8A8_UNORM;
+    attributes.push_back(attribute);
+
+    if (normal != NormalEncoding::None)
+    {
+        attribute.location++;
+        attribute.offset += colorSize(color);
+        attribute.format = normal == NormalEncoding::Float32
+                               ? VK_FORMAT_R32G32B32_SFLOAT
+                               : VK_FORMAT_R16G16_SNORM;
+        attributes.push_back(attribute);
+    }
+    return attributes;
+}
+
+void encodeVertices(
+    const VertexFormat& format, const VertexStreams& streams, uint8_t* out)
+{
+    const uint32_t color_offset = positionSize(format.position);
+    const uint32_t normal_offset = color_offset + colorSize(format.color);
+    const uint32_t stride = format.stride();
+
+    for (std::size_t i = 0; i < streams.count; ++i)
+    {
+        const float* position = streams.positions + i * streams.stride;
+        const float* color = streams.colors + i * streams.stride;
+        uint8_t* vertex = out + i * stride;
+
+        switch (format.position)
+        {
+        case PositionEncoding::Float32:
+            std::memcpy(vertex, position, 3 * sizeof(float));
+            break;
+        case PositionEncoding::Snorm16:
+            encodeSnorm16x4(position, vertex);
+            break;
+        case PositionEncoding::Half:
+            encodeHalfx4(position, vertex);
+            break;
+        }
+
+        if (format.color == ColorEncoding::Float32)
+        {
+            std::memcpy(vertex + color_offset, color, 3 * sizeof(float));
+        }
+        else
+        {
+            encodeUnorm8x4(color, vertex + color_offset);
+        }
+
+        if (format.normal == NormalEncoding::None)
+        {
+            continue;
+        }
+        const float* normal = streams.normals + i * streams.stride;
+        if (format.normal == NormalEncoding::Float32)
+        {
+            std::memcpy(vertex + normal_offset, normal, 3 * sizeof(float));
+        }
+        else
+        {
+            encodeOctahedral16(normal, vertex + normal_offset);
+        }
+    }
+}
+
+const char* toString(PositionEncoding encoding)
+{
+    switch (encoding)
+    {
+    case PositionEncoding::Float32:
+        return "float";
+    case PositionEncoding::Snorm16:
+        return "snorm16";
+    case PositionEncoding::Half:
+        return "half";
+    }
+    return "unknown";
+}
+
+const char* toString(ColorEncoding encoding)
+{
+    switch (encoding)
+    {
+    case ColorEncoding::Float32:
+        return "float";
+    case ColorEncoding::Unorm8:
+        return "unorm8";
+    }
+    return "unknown";
+}
+
+const char* toString(NormalEncoding encoding)
+{
+    switch (encoding)
+    {
+    case NormalEncoding::None:
+        return "none";
+    case NormalEncoding::Float32:
+        return "float";
+    case NormalEncoding::Octahedral16:
+        return "octahedral16";
+    }
+    return "unknown";
+}
@@ -0,0 +1,105 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Compact vertex layouts. Attributes are interleaved in the order position,
+ * color, normal; the shaders see the same vec4 inputs for every encoding
+ * because the formats expand to float on fetch.
+ */
+
+enum class PositionEncoding
+{
+    // R32G32B32_SFLOAT, 12 bytes.
+    Float32,
+    // R16G16B16A16_SNORM with w = 1, 8 bytes. Positions must lie in
+    // [-1, 1]; larger meshes fold their bounds into the model matrix.
+    Snorm16,
+    // R16G16B16A16_SFLOAT with w = 1, 8 bytes.
+    Half,
+};
+
+enum class ColorEncoding
+{
+    // R32G32B32_SFLOAT, 12 bytes.
+    Float32,
+    // R8G8B8A8_UNORM with alpha = 1, 4 bytes.
+    Unorm8,
+};
+
+enum class NormalEncoding
+{
+    None,
+    // R32G32B32_SFLOAT, 12 bytes.
+    Float32,
+    // Octahedral mapping to R16G16_SNORM, 4 bytes. The shader decodes
+    // n = (e.x, e.y, 1 - |e.x| - |e.y|) and folds x, y back where n.z < 0.
+    Octahedral16,
+};
+
+struct VertexFormat
+{
+    PositionEncoding position = PositionEncoding::Float32;
+    ColorEncoding color = ColorEncoding::Float32;
+    NormalEncoding normal = NormalEncoding::None;
+
+    uint32_t stride() const;
+
+    /**
+     * Describes the attributes of one vertex in the binding. Position,
+     * color and normal take consecutive locations from first_location.
+     */
+    std::vector<VkVertexInputAttributeDescription> attributes(
+        uint32_t binding, uint32_t first_location) const;
+};
+
+/**
+ * Float vertex data to encode. The streams share the stride in floats
+ * between consecutive vertices, so an interleaved array can be passed
+ * as is. Colors are RGB and normals need not be normalized.
+ */
+struct VertexStreams
+{
+    std::size_t count = 0;
+    std::size_t stride = 3;
+    const float* positions = nullptr;
+    const float* colors = nullptr;
+    // May be null when the format has no normal.
+    const float* normals = nullptr;
+};
+
+/** Writes count * format.stride() bytes to out. */
+void encodeVertices(
+    const VertexFormat& format, const VertexStreams& streams, uint8_t* out);
+
+const char* toString(PositionEncoding encoding);
+const char* toString(ColorEncoding encoding);
+const char* toString(NormalEncoding encoding);
@@ -0,0 +1,136 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "descriptor_allocator.h"
+#include "fake_vulkan.h"
+#include "test_check.h"
+
+namespace {
+
+VkDescriptorSetLayout makeLayout(
+    uintptr_t id, const std::vector<VkDescriptorPoolSize>& layout_sizes)
+{
+    auto layout = reinterpret_cast<VkDescriptorSetLayout>(id);
+    fake_vulkan::set_layouts[layout] = layout_sizes;
+    return layout;
+}
+
+void testSetsPerPool()
+{
+    fake_vulkan::reset();
+    {
+        const std::vector<VkDescriptorPoolSize> layout_sizes = {
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1}};
+        const VkDescriptorSetLayout layout = makeLayout(1, layout_sizes);
+
+        // Pools of 2, 4 and 8 sets.
+        DescriptorAllocator allocator(VK_NULL_HANDLE, 2);
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        for (int i = 0; i < 7; ++i)
+        {
+            CHECK(allocator.allocate(layout, layout_sizes, set) == VK_SUCCESS);
+        }
+        CHECK(allocator.poolsNum() == 3);
+        CHECK(fake_vulkan::pool_overflows_num == 0);
+
+        // The pools are reused in the order they were created.
+        CHECK(allocator.reset() == VK_SUCCESS);
+        for (int i = 0; i < 14; ++i)
+        {
+            CHECK(allocator.allocate(layout, layout_sizes, set) == VK_SUCCESS);
+        }
+        CHECK(allocator.poolsNum() == 3);
+        CHECK(fake_vulkan::pool_overflows_num == 0);
+    }
+    CHECK(fake_vulkan::live_descriptor_pools_num == 0);
+}
+
+void testDescriptorsPerPool()
+{
+    fake_vulkan::reset();
+    // A pool of 2 sets holds 4 storage buffers.
+    DescriptorAllocator allocator(VK_NULL_HANDLE, 2);
+    VkDescriptorSet set = VK_NULL_HANDLE;
+
+    // The second set still fits the pool's set count, not its descriptors.
+    const std::vector<VkDescriptorPoolSize> layout_sizes = {
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2}};
+    const VkDescriptorSetLayout layout = makeLayout(1, layout_sizes);
+    CHECK(allocator.allocate(layout, layout_sizes, set) == VK_SUCCESS);
+    CHECK(allocator.allocate(layout, layout_sizes, set) == VK_SUCCESS);
+    CHECK(allocator.poolsNum() == 2);
+    CHECK(fake_vulkan::pool_overflows_num == 0);
+
+    // More than a fresh pool holds is refused without touching the pool.
+    const std::vector<VkDescriptorPoolSize> huge_sizes = {
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 64}};
+    const VkDescriptorSetLayout huge_layout = makeLayout(2, huge_sizes);
+    CHECK(
+        allocator.allocate(huge_layout, huge_sizes, set) ==
+        VK_ERROR_OUT_OF_POOL_MEMORY);
+    CHECK(fake_vulkan::pool_overflows_num == 0);
+}
+
+void testSetCache()
+{
+    fake_vulkan::reset();
+    DescriptorAllocator allocator(VK_NULL_HANDLE, 2);
+    DescriptorSetCache cache(VK_NULL_HANDLE, allocator);
+    const VkDescriptorSetLayout layout =
+        makeLayout(1, {{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1}});
+
+    DescriptorBufferBinding binding;
+    binding.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    binding.info.buffer = reinterpret_cast<VkBuffer>(uintptr_t{1});
+    binding.info.range = 64;
+
+    VkDescriptorSet first = VK_NULL_HANDLE;
+    VkDescriptorSet second = VK_NULL_HANDLE;
+    CHECK(cache.get(layout, {binding}, {}, first) == VK_SUCCESS);
+    CHECK(cache.get(layout, {binding}, {}, second) == VK_SUCCESS);
+    CHECK(first == second);
+    CHECK(fake_vulkan::descriptor_writes_num == 1);
+
+    // A pool of 2 sets holds 2 dynamic uniform buffers, the rest of the
+    // sets go to the next pools.
+    for (VkDeviceSize offset = 64; offset < 64 * 8; offset += 64)
+    {
+        binding.info.offset = offset;
+        CHECK(cache.get(layout, {binding}, {}, second) == VK_SUCCESS);
+        CHECK(first != second);
+    }
+    CHECK(fake_vulkan::descriptor_writes_num == 8);
+    CHECK(allocator.poolsNum() == 3);
+    CHECK(fake_vulkan::pool_overflows_num == 0);
+}
+
+} // namespace
+
+int main()
+{
+    testSetsPerPool();
+    testDescriptorsPerPool();
+    testSetCache();
+    return checkResult();
+}
@@ -0,0 +1,523 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "fake_vulkan.h"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace fake_vulkan {
+
+std::vector<VkMemoryAllocateInfo> allocations;
+uint32_t live_allocations_num = 0;
+uint32_t failing_types = 0;
+VkMemoryRequirements memory_requirements = {};
+uint32_t transient_memory_type_bits = 0;
+std::vector<MemoryBinding> memory_bindings;
+std::vector<uint8_t> pipeline_cache_data;
+std::size_t pipeline_cache_growth = 0;
+std::vector<uint8_t> pipeline_cache_initial_data;
+std::map<VkDescriptorSetLayout, std::vector<VkDescriptorPoolSize>>
+    set_layouts;
+uint32_t pool_overflows_num = 0;
+uint32_t live_descriptor_pools_num = 0;
+uint32_t descriptor_writes_num = 0;
+std::chrono::milliseconds pipeline_compile_time(0);
+std::atomic<uint32_t> created_pipelines_num(0);
+std::atomic<uint32_t> live_pipelines_num(0);
+std::map<VkFormat, VkFormatProperties> format_properties;
+uint32_t format_queries_num = 0;
+uint32_t live_images_num = 0;
+uint32_t live_image_views_num = 0;
+uint32_t live_buffers_num = 0;
+uint32_t live_render_passes_num = 0;
+uint32_t live_framebuffers_num = 0;
+std::vector<VkImageUsageFlags> image_usages;
+std::vector<VkAttachmentDescription> render_pass_attachments;
+std::vector<PipelineBarrier> pipeline_barriers;
+std::vector<std::string> commands;
+
+void reset()
+{
+    allocations.clear();
+    live_allocations_num = 0;
+    failing_types = 0;
+    memory_requirements = {};
+    transient_memory_type_bits = 0;
+    memory_bindings.clear();
+    pipeline_cache_data.clear();
+    pipeline_cache_growth = 0;
+    pipeline_cache_initial_data.clear();
+    set_layouts.clear();
+    pool_overflows_num = 0;
+    live_descriptor_pools_num = 0;
+    descriptor_writes_num = 0;
+    pipeline_compile_time = std::chrono::milliseconds(0);
+    created_pipelines_num = 0;
+    live_pipelines_num = 0;
+    format_properties.clear();
+    format_queries_num = 0;
+    live_images_num = 0;
+    live_image_views_num = 0;
+    live_buffers_num = 0;
+    live_render_passes_num = 0;
+    live_framebuffers_num = 0;
+    image_usages.clear();
+    render_pass_attachments.clear();
+    pipeline_barriers.clear();
+    commands.clear();
+}
+
+} // namespace fake_vulkan
+
+namespace {
+
+// Handles only have to be unique and non-null, nothing dereferences them.
+template <typename Handle>
+Handle makeHandle(uintptr_t value)
+{
+    return reinterpret_cast<Handle>(value);
+}
+
+// Mapped pointers are only offset, never written through.
+uint8_t g_mapped_memory[1];
+
+struct DescriptorPoolSpace
+{
+    uint32_t sets_num = 0;
+    std::map<VkDescriptorType, uint32_t> descriptors_num;
+};
+
+struct DescriptorPool
+{
+    DescriptorPoolSpace capacity;
+    DescriptorPoolSpace left;
+};
+
+// Takes count out of left, true when there wasn't enough.
+bool take(uint32_t& left, uint32_t count)
+{
+    const bool overflow = left < count;
+    left = overflow ? 0 : left - count;
+    return overflow;
+}
+
+std::map<VkDescriptorPool, DescriptorPool> g_descriptor_pools;
+uintptr_t g_descriptor_handles_num = 0;
+
+// Images, views, buffers, render passes and framebuffers.
+uintptr_t g_object_handles_num = 0;
+std::set<VkImage> g_transient_images;
+
+} // namespace
+
+VkResult vkAllocateMemory(
+    VkDevice device,
+    const VkMemoryAllocateInfo* allocate_info,
+    const VkAllocationCallbacks* allocator,
+    VkDeviceMemory* memory)
+{
+    if (fake_vulkan::failing_types & (1u << allocate_info->memoryTypeIndex))
+    {
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+    fake_vulkan::allocations.push_back(*allocate_info);
+    ++fake_vulkan::live_allocations_num;
+    *memory = makeHandle<VkDeviceMemory>(fake_vulkan::allocations.size());
+    return VK_SUCCESS;
+}
+
+void vkFreeMemory(
+    VkDevice device,
+    VkDeviceMemory memory,
+    const VkAllocationCallbacks* allocator)
+{
+    if (memory != VK_NULL_HANDLE)
+    {
+        --fake_vulkan::live_allocations_num;
+    }
+}
+
+VkResult vkMapMemory(
+    VkDevice device,
+    VkDeviceMemory memory,
+    VkDeviceSize offset,
+    VkDeviceSize size,
+    VkMemoryMapFlags flags,
+    void** data)
+{
+    *data = g_mapped_memory;
+    return VK_SUCCESS;
+}
+
+void vkUnmapMemory(VkDevice device, VkDeviceMemory memory)
+{
+}
+
+void vkGetDeviceMemoryCommitment(
+    VkDevice device,
+    VkDeviceMemory memory,
+    VkDeviceSize* committed_bytes)
+{
+    *committed_bytes = 0;
+}
+
+void vkGetBufferMemoryRequirements(
+    VkDevice device, VkBuffer buffer, VkMemoryRequirements* mem_reqs)
+{
+    *mem_reqs = fake_vulkan::memory_requirements;
+}
+
+void vkGetImageMemoryRequirements(
+    VkDevice device, VkImage image, VkMemoryRequirements* mem_reqs)
+{
+    *mem_reqs = fake_vulkan::memory_requirements;
+    if (g_transient_images.count(image) != 0)
+    {
+        mem_reqs->memoryTypeBits |= fake_vulkan::transient_memory_type_bits;
+    }
+}
+
+VkResult vkBindBufferMemory(
+    VkDevice device,
+    VkBuffer buffer,
+    VkDeviceMemory memory,
+    VkDeviceSize offset)
+{
+    fake_vulkan::memory_bindings.push_back({memory, offset});
+    return VK_SUCCESS;
+}
+
+VkResult vkBindImageMemory(
+    VkDevice device, VkImage image, VkDeviceMemory memory, VkDeviceSize offset)
+{
+    fake_vulkan::memory_bindings.push_back({memory, offset});
+    return VK_SUCCESS;
+}
+
+VkResult vkCreateImage(
+    VkDevice device,
+    const VkImageCreateInfo* create_info,
+    const VkAllocationCallbacks* allocator,
+    VkImage* image)
+{
+    *image = makeHandle<VkImage>(++g_object_handles_num);
+    if (create_info->usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT)
+    {
+        g_transient_images.insert(*image);
+    }
+    fake_vulkan::image_usages.push_back(create_info->usage);
+    ++fake_vulkan::live_images_num;
+    return VK_SUCCESS;
+}
+
+void vkDestroyImage(
+    VkDevice device, VkImage image, const VkAllocationCallbacks* allocator)
+{
+    if (image != VK_NULL_HANDLE)
+    {
+        g_transient_images.erase(image);
+        --fake_vulkan::live_images_num;
+    }
+}
+
+VkResult vkCreateImageView(
+    VkDevice device,
+    const VkImageViewCreateInfo* create_info,
+    const VkAllocationCallbacks* allocator,
+    VkImageView* view)
+{
+    *view = makeHandle<VkImageView>(++g_object_handles_num);
+    ++fake_vulkan::live_image_views_num;
+    return VK_SUCCESS;
+}
+
+void vkDestroyImageView(
+    VkDevice device, VkImageView view, const VkAllocationCallbacks* allocator)
+{
+    if (view != VK_NULL_HANDLE)
+    {
+        --fake_vulkan::live_image_views_num;
+    }
+}
+
+VkResult vkCreateBuffer(
+    VkDevice device,
+    const VkBufferCreateInfo* create_info,
+    const VkAllocationCallbacks* allocator,
+    VkBuffer* buffer)
+{
+    *buffer = makeHandle<VkBuffer>(++g_object_handles_num);
+    ++fake_vulkan::live_buffers_num;
+    return VK_SUCCESS;
+}
+
+void vkDestroyBuffer(
+    VkDevice device, VkBuffer buffer, const VkAllocationCallbacks* allocator)
+{
+    if (buffer != VK_NULL_HANDLE)
+    {
+        --fake_vulkan::live_buffers_num;
+    }
+}
+
+VkResult vkCreateRenderPass(
+    VkDevice device,
+    const VkRenderPassCreateInfo* create_info,
+    const VkAllocationCallbacks* allocator,
+    VkRenderPass* render_pass)
+{
+    fake_vulkan::render_pass_attachments.assign(
+        create_info->pAttachments,
+        create_info->pAttachments + create_info->attachmentCount);
+    *render_pass = makeHandle<VkRenderPass>(++g_object_handles_num);
+    ++fake_vulkan::live_render_passes_num;
+    return VK_SUCCESS;
+}
+
+void vkDestroyRenderPass(
+    VkDevice device,
+    VkRenderPass render_pass,
+    const VkAllocationCallbacks* allocator)
+{
+    if (render_pass != VK_NULL_HANDLE)
+    {
+        --fake_vulkan::live_render_passes_num;
+    }
+}
+
+VkResult vkCreateFramebuffer(
+    VkDevice device,
+    const VkFramebufferCreateInfo* create_info,
+    const VkAllocationCallbacks* allocator,
+    VkFramebuffer* framebuffer)
+{
+    *framebuffer = makeHandle<VkFramebuffer>(++g_object_handles_num);
+    ++fake_vulkan::live_framebuffers_num;
+    return VK_SUCCESS;
+}
+
+void vkDestroyFramebuffer(
+    VkDevice device,
+    VkFramebuffer framebuffer,
+    const VkAllocationCallbacks* allocator)
+{
+    if (framebuffer != VK_NULL_HANDLE)
+    {
+        --fake_vulkan::live_framebuffers_num;
+    }
+}
+
+void vkCmdBeginRenderPass(
+    VkCommandBuffer cmd_buffer,
+    const VkRenderPassBeginInfo* begin_info,
+    VkSubpassContents contents)
+{
+    fake_vulkan::commands.push_back("begin");
+}
+
+void vkCmdEndRenderPass(VkCommandBuffer cmd_buffer)
+{
+    fake_vulkan::commands.push_back("end");
+}
+
+void vkCmdPipelineBarrier(
+    VkCommandBuffer cmd_buffer,
+    VkPipelineStageFlags src_stages,
+    VkPipelineStageFlags dst_stages,
+    VkDependencyFlags dependency_flags,
+    uint32_t memory_barriers_num,
+    const VkMemoryBarrier* memory_barriers,
+    uint32_t buffer_barriers_num,
+    const VkBufferMemoryBarrier* buffer_barriers,
+    uint32_t image_barriers_num,
+    const VkImageMemoryBarrier* image_barriers)
+{
+    fake_vulkan::PipelineBarrier barrier;
+    barrier.src_stages = src_stages;
+    barrier.dst_stages = dst_stages;
+    barrier.memory_barriers.assign(
+        memory_barriers, memory_barriers + memory_barriers_num);
+    barrier.image_barriers.assign(
+        image_barriers, image_barriers + image_barriers_num);
+    fake_vulkan::pipeline_barriers.push_back(barrier);
+    fake_vulkan::commands.push_back("barrier");
+}
+
+VkResult vkCreateGraphicsPipelines(
+    VkDevice device,
+    VkPipelineCache pipeline_cache,
+    uint32_t create_infos_num,
+    const VkGraphicsPipelineCreateInfo* create_infos,
+    const VkAllocationCallbacks* allocator,
+    VkPipeline* pipelines)
+{
+    std::this_thread::sleep_for(fake_vulkan::pipeline_compile_time);
+    for (uint32_t i = 0; i < create_infos_num; ++i)
+    {
+        pipelines[i] =
+            makeHandle<VkPipeline>(++fake_vulkan::created_pipelines_num);
+        ++fake_vulkan::live_pipelines_num;
+    }
+    return VK_SUCCESS;
+}
+
+void vkDestroyPipeline(
+    VkDevice device,
+    VkPipeline pipeline,
+    const VkAllocationCallbacks* allocator)
+{
+    if (pipeline != VK_NULL_HANDLE)
+    {
+        --fake_vulkan::live_pipelines_num;
+    }
+}
+
+VkResult vkCreatePipelineCache(
+    VkDevice device,
+    const VkPipelineCacheCreateInfo* create_info,
+    const VkAllocationCallbacks* allocator,
+    VkPipelineCache* pipeline_cache)
+{
+    const auto* initial_data =
+        static_cast<const uint8_t*>(create_info->pInitialData);
+    fake_vulkan::pipeline_cache_initial_data.assign(
+        initial_data, initial_data + create_info->initialDataSize);
+    *pipeline_cache = makeHandle<VkPipelineCache>(1);
+    return VK_SUCCESS;
+}
+
+void vkDestroyPipelineCache(
+    VkDevice device,
+    VkPipelineCache pipeline_cache,
+    const VkAllocationCallbacks* allocator)
+{
+}
+
+VkResult vkGetPipelineCacheData(
+    VkDevice device, VkPipelineCache pipeline_cache, size_t* size, void* data)
+{
+    std::vector<uint8_t>& cache_data = fake_vulkan::pipeline_cache_data;
+    if (data == nullptr)
+    {
+        *size = cache_data.size();
+        cache_data.resize(
+            cache_data.size() + fake_vulkan::pipeline_cache_growth);
+        fake_vulkan::pipeline_cache_growth = 0;
+        return VK_SUCCESS;
+    }
+    const size_t copied = std::min(*size, cache_data.size());
+    std::memcpy(data, cache_data.data(), copied);
+    *size = copied;
+    return copied < cache_data.size() ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+void vkGetPhysicalDeviceFormatProperties(
+    VkPhysicalDevice physical_device,
+    VkFormat format,
+    VkFormatProperties* format_properties)
+{
+    ++fake_vulkan::format_queries_num;
+    auto it = fake_vulkan::format_properties.find(format);
+    *format_properties =
+        it != fake_vulkan::format_properties.end() ? it->second
+                                                   : VkFormatProperties{};
+}
+
+VkResult vkCreateDescriptorPool(
+    VkDevice device,
+    const VkDescriptorPoolCreateInfo* create_info,
+    const VkAllocationCallbacks* allocator,
+    VkDescriptorPool* descriptor_pool)
+{
+    *descriptor_pool = makeHandle<VkDescriptorPool>(++g_descriptor_handles_num);
+    DescriptorPool& pool = g_descriptor_pools[*descriptor_pool];
+    pool.capacity.sets_num = create_info->maxSets;
+    for (uint32_t i = 0; i < create_info->poolSizeCount; ++i)
+    {
+        const VkDescriptorPoolSize& size = create_info->pPoolSizes[i];
+        pool.capacity.descriptors_num[size.type] += size.descriptorCount;
+    }
+    pool.left = pool.capacity;
+    ++fake_vulkan::live_descriptor_pools_num;
+    return VK_SUCCESS;
+}
+
+void vkDestroyDescriptorPool(
+    VkDevice device,
+    VkDescriptorPool descriptor_pool,
+    const VkAllocationCallbacks* allocator)
+{
+    if (g_descriptor_pools.erase(descriptor_pool) != 0)
+    {
+        --fake_vulkan::live_descriptor_pools_num;
+    }
+}
+
+VkResult vkResetDescriptorPool(
+    VkDevice device,
+    VkDescriptorPool descriptor_pool,
+    VkDescriptorPoolResetFlags flags)
+{
+    DescriptorPool& pool = g_descriptor_pools[descriptor_pool];
+    pool.left = pool.capacity;
+    return VK_SUCCESS;
+}
+
+VkResult vkAllocateDescriptorSets(
+    VkDevice device,
+    const VkDescriptorSetAllocateInfo* allocate_info,
+    VkDescriptorSet* descriptor_sets)
+{
+    DescriptorPool& pool = g_descriptor_pools[allocate_info->descriptorPool];
+    for (uint32_t i = 0; i < allocate_info->descriptorSetCount; ++i)
+    {
+        bool overflow = take(pool.left.sets_num, 1);
+        for (const VkDescriptorPoolSize& size :
+             fake_vulkan::set_layouts[allocate_info->pSetLayouts[i]])
+        {
+            overflow |= take(
+                pool.left.descriptors_num[size.type], size.descriptorCount);
+        }
+        if (overflow)
+        {
+            ++fake_vulkan::pool_overflows_num;
+        }
+        descriptor_sets[i] =
+            makeHandle<VkDescriptorSet>(++g_descriptor_handles_num);
+    }
+    return VK_SUCCESS;
+}
+
+void vkUpdateDescriptorSets(
+    VkDevice device,
+    uint32_t descriptor_writes_num,
+    const VkWriteDescriptorSet* descriptor_writes,
+    uint32_t descriptor_copies_num,
+    const VkCopyDescriptorSet* descriptor_copies)
+{
+    fake_vulkan::descriptor_writes_num += descriptor_writes_num;
+}
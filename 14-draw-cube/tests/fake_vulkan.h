@@ -0,0 +1,122 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Stands in for the Vulkan loader so the modules that only talk to the
+ * device through a handful of entry points can be tested without a GPU.
+ * The entry points record their calls here and answer from this state.
+ */
+namespace fake_vulkan {
+
+/** Every successful vkAllocateMemory call, in order. */
+extern std::vector<VkMemoryAllocateInfo> allocations;
+extern uint32_t live_allocations_num;
+/** Bit i makes allocations from memory type i run out of device memory. */
+extern uint32_t failing_types;
+
+/** Returned for every buffer and image. */
+extern VkMemoryRequirements memory_requirements;
+/**
+ * Added to the memory types of images with TRANSIENT_ATTACHMENT usage,
+ * e.g. a lazily allocated type.
+ */
+extern uint32_t transient_memory_type_bits;
+
+struct MemoryBinding
+{
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+};
+/** Every vkBindBufferMemory and vkBindImageMemory call, in order. */
+extern std::vector<MemoryBinding> memory_bindings;
+
+/** What vkGetPipelineCacheData reports as the cache contents. */
+extern std::vector<uint8_t> pipeline_cache_data;
+/**
+ * Bytes the cache grows by right after vkGetPipelineCacheData reported its
+ * size, like when another thread creates a pipeline in between.
+ */
+extern std::size_t pipeline_cache_growth;
+/** Initial data of the last created pipeline cache. */
+extern std::vector<uint8_t> pipeline_cache_initial_data;
+
+/** Descriptors of each type in the set layouts the test allocates. */
+extern std::map<VkDescriptorSetLayout, std::vector<VkDescriptorPoolSize>>
+    set_layouts;
+/**
+ * Allocations past the sets or descriptors of a pool. They succeed like
+ * they may on a Vulkan 1.0 device without VK_KHR_maintenance1.
+ */
+extern uint32_t pool_overflows_num;
+extern uint32_t live_descriptor_pools_num;
+extern uint32_t descriptor_writes_num;
+
+/** How long every vkCreateGraphicsPipelines call takes. */
+extern std::chrono::milliseconds pipeline_compile_time;
+/** Pipelines are created on worker threads, so these count atomically. */
+extern std::atomic<uint32_t> created_pipelines_num;
+extern std::atomic<uint32_t> live_pipelines_num;
+
+/** Formats missing here report no features. */
+extern std::map<VkFormat, VkFormatProperties> format_properties;
+extern uint32_t format_queries_num;
+
+extern uint32_t live_images_num;
+extern uint32_t live_image_views_num;
+extern uint32_t live_buffers_num;
+extern uint32_t live_render_passes_num;
+extern uint32_t live_framebuffers_num;
+/** Usage of every created image, in order. */
+extern std::vector<VkImageUsageFlags> image_usages;
+/** Attachments of the last created render pass. */
+extern std::vector<VkAttachmentDescription> render_pass_attachments;
+
+struct PipelineBarrier
+{
+    VkPipelineStageFlags src_stages = 0;
+    VkPipelineStageFlags dst_stages = 0;
+    std::vector<VkMemoryBarrier> memory_barriers;
+    std::vector<VkImageMemoryBarrier> image_barriers;
+};
+extern std::vector<PipelineBarrier> pipeline_barriers;
+/**
+ * The recorded commands by name, "barrier", "begin" and "end" for the
+ * render passes. Tests log their own callbacks here to check the order.
+ */
+extern std::vector<std::string> commands;
+
+void reset();
+
+} // namespace fake_vulkan
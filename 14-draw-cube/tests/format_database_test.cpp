@@ -0,0 +1,151 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "fake_vulkan.h"
+#include "format_database.h"
+#include "test_check.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+// Written to the working directory, which ctest points at the build tree.
+const char* c_path = "format_database_test.bin";
+
+constexpr VkFormatFeatureFlags c_depth_features =
+    VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT;
+
+VkPhysicalDeviceProperties makeDeviceProperties()
+{
+    VkPhysicalDeviceProperties props = {};
+    props.vendorID = 1;
+    props.deviceID = 2;
+    props.driverVersion = 3;
+    return props;
+}
+
+/**
+ * D32 is unsupported, D24S8 only supports linear tiling and D16 supports
+ * both tilings.
+ */
+void setDepthFormats()
+{
+    fake_vulkan::format_properties[VK_FORMAT_D24_UNORM_S8_UINT]
+        .linearTilingFeatures = c_depth_features;
+    VkFormatProperties& d16 =
+        fake_vulkan::format_properties[VK_FORMAT_D16_UNORM];
+    d16.linearTilingFeatures = c_depth_features;
+    d16.optimalTilingFeatures = c_depth_features;
+}
+
+void testSelect()
+{
+    fake_vulkan::reset();
+    setDepthFormats();
+    FormatDatabase db(VK_NULL_HANDLE, makeDeviceProperties());
+
+    // Optimal tiling of a later candidate beats linear of an earlier one.
+    FormatChoice choice =
+        db.select(FormatDatabase::c_depth_formats, c_depth_features);
+    CHECK(choice.found());
+    CHECK(choice.format == VK_FORMAT_D16_UNORM);
+    CHECK(choice.tiling == VK_IMAGE_TILING_OPTIMAL);
+
+    // Linear tiling is the last resort.
+    choice = db.select(
+        {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D24_UNORM_S8_UINT}, c_depth_features);
+    CHECK(choice.format == VK_FORMAT_D24_UNORM_S8_UINT);
+    CHECK(choice.tiling == VK_IMAGE_TILING_LINEAR);
+
+    CHECK(!db.select({VK_FORMAT_D32_SFLOAT}, c_depth_features).found());
+
+    // Every format is queried once, however often it's looked at.
+    CHECK(fake_vulkan::format_queries_num == 3);
+    CHECK(db.queriesNum() == 3);
+    CHECK(db.formatsNum() == 3);
+}
+
+void testLoadAndSave()
+{
+    fake_vulkan::reset();
+    setDepthFormats();
+    std::remove(c_path);
+    const VkPhysicalDeviceProperties props = makeDeviceProperties();
+    {
+        FormatDatabase db(VK_NULL_HANDLE, props);
+        CHECK(db.load(c_path) == FormatDatabaseLoad::Missing);
+        db.select(FormatDatabase::c_depth_formats, c_depth_features);
+        CHECK(db.save(c_path));
+    }
+
+    // A warm start answers from the file without asking the device.
+    fake_vulkan::format_queries_num = 0;
+    {
+        FormatDatabase db(VK_NULL_HANDLE, props);
+        CHECK(db.load(c_path) == FormatDatabaseLoad::Warm);
+        CHECK(db.formatsNum() == 3);
+        const FormatChoice choice =
+            db.select(FormatDatabase::c_depth_formats, c_depth_features);
+        CHECK(choice.format == VK_FORMAT_D16_UNORM);
+        CHECK(db.queriesNum() == 0);
+        CHECK(fake_vulkan::format_queries_num == 0);
+
+        // Nothing new was queried, so nothing is written.
+        std::remove(c_path);
+        CHECK(db.save(c_path));
+        CHECK(!std::ifstream(c_path));
+        db.properties(VK_FORMAT_R8G8B8A8_UNORM);
+        CHECK(db.save(c_path));
+        CHECK(std::ifstream(c_path));
+    }
+
+    // A driver update invalidates the file.
+    {
+        VkPhysicalDeviceProperties updated = props;
+        ++updated.driverVersion;
+        FormatDatabase db(VK_NULL_HANDLE, updated);
+        CHECK(db.load(c_path) == FormatDatabaseLoad::OtherDevice);
+        CHECK(db.formatsNum() == 0);
+    }
+
+    {
+        std::ofstream file(c_path, std::ios::binary | std::ios::app);
+        file << "x";
+    }
+    {
+        FormatDatabase db(VK_NULL_HANDLE, props);
+        CHECK(db.load(c_path) == FormatDatabaseLoad::Corrupt);
+        CHECK(db.formatsNum() == 0);
+    }
+    std::remove(c_path);
+}
+
+} // namespace
+
+int main()
+{
+    testSelect();
+    testLoadAndSave();
+    return checkResult();
+}
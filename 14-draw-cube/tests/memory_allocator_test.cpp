@@ -0,0 +1,354 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "fake_vulkan.h"
+#include "memory_allocator.h"
+#include "test_check.h"
+
+#include <limits>
+#include <tuple>
+
+namespace {
+
+constexpr VkDeviceSize c_mib = 1024 * 1024;
+constexpr VkDeviceSize c_granularity = 4096;
+constexpr uint32_t c_all_types = 0xF;
+
+constexpr VkMemoryPropertyFlags c_host_memory =
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+    VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+/**
+ * A discrete GPU: device local memory, the 256 MiB window of it the host can
+ * write to and cached and uncached system memory.
+ */
+VkPhysicalDeviceMemoryProperties makeMemoryProperties()
+{
+    VkPhysicalDeviceMemoryProperties mem_props = {};
+    mem_props.memoryHeapCount = 3;
+    mem_props.memoryHeaps[0] = {8192 * c_mib,
+                                VK_MEMORY_HEAP_DEVICE_LOCAL_BIT};
+    mem_props.memoryHeaps[1] = {256 * c_mib, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT};
+    mem_props.memoryHeaps[2] = {16384 * c_mib, 0};
+
+    mem_props.memoryTypeCount = 4;
+    mem_props.memoryTypes[0] = {VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0};
+    mem_props.memoryTypes[1] = {
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | c_host_memory, 1};
+    mem_props.memoryTypes[2] = {c_host_memory, 2};
+    mem_props.memoryTypes[3] = {
+        c_host_memory | VK_MEMORY_PROPERTY_HOST_CACHED_BIT, 2};
+    return mem_props;
+}
+
+VkPhysicalDeviceLimits makeLimits()
+{
+    VkPhysicalDeviceLimits limits = {};
+    limits.bufferImageGranularity = c_granularity;
+    limits.maxMemoryAllocationCount = 4096;
+    return limits;
+}
+
+VkMemoryRequirements makeRequirements(
+    VkDeviceSize size, VkDeviceSize alignment, uint32_t type_bits)
+{
+    VkMemoryRequirements mem_reqs = {};
+    mem_reqs.size = size;
+    mem_reqs.alignment = alignment;
+    mem_reqs.memoryTypeBits = type_bits;
+    return mem_reqs;
+}
+
+void testBestFit()
+{
+    BlockSubAllocator sub_allocator(1024);
+    CHECK(sub_allocator.allocate(300, 1).second == 0);
+    CHECK(sub_allocator.allocate(100, 1).second == 300);
+    CHECK(sub_allocator.allocate(150, 1).second == 400);
+    CHECK(sub_allocator.allocate(100, 1).second == 550);
+
+    // Free ranges of 300, 150 and 374 bytes.
+    sub_allocator.free(0);
+    sub_allocator.free(400);
+    CHECK(sub_allocator.freeRangesNum() == 3);
+
+    // First fit would take the range at 0, best fit the tightest one.
+    auto[found, offset] = sub_allocator.allocate(140, 1);
+    CHECK(found);
+    CHECK(offset == 400);
+
+    CHECK(!sub_allocator.allocate(400, 1).first);
+    CHECK(sub_allocator.largestFreeRange() == 374);
+}
+
+void testCoalescing()
+{
+    BlockSubAllocator sub_allocator(1024);
+    VkDeviceSize offsets[4] = {};
+    for (VkDeviceSize& offset : offsets)
+    {
+        offset = sub_allocator.allocate(256, 1).second;
+    }
+    CHECK(sub_allocator.usedSize() == 1024);
+    CHECK(sub_allocator.freeRangesNum() == 0);
+
+    sub_allocator.free(offsets[0]);
+    sub_allocator.free(offsets[2]);
+    CHECK(sub_allocator.freeRangesNum() == 2);
+
+    // Merges with both the previous and the next free range.
+    sub_allocator.free(offsets[1]);
+    CHECK(sub_allocator.freeRangesNum() == 1);
+    CHECK(sub_allocator.largestFreeRange() == 768);
+
+    sub_allocator.free(offsets[3]);
+    CHECK(sub_allocator.empty());
+    CHECK(sub_allocator.usedSize() == 0);
+    CHECK(sub_allocator.freeRangesNum() == 1);
+    CHECK(sub_allocator.largestFreeRange() == 1024);
+}
+
+void testAlignment()
+{
+    BlockSubAllocator sub_allocator(1024);
+    CHECK(sub_allocator.allocate(10, 1).second == 0);
+    CHECK(sub_allocator.allocate(10, 256).second == 256);
+
+    // The padding in front of the aligned range stays allocatable.
+    CHECK(sub_allocator.freeRangesNum() == 2);
+    CHECK(sub_allocator.allocate(200, 8).second == 16);
+}
+
+void testFindMemoryType()
+{
+    const VkPhysicalDeviceMemoryProperties mem_props = makeMemoryProperties();
+
+    auto[found, index] = findMemoryType(
+        mem_props,
+        c_all_types,
+        c_host_memory,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    CHECK(found);
+    CHECK(index == 1);
+
+    // Without the preferred flags any type with the required ones will do.
+    std::tie(found, index) = findMemoryType(
+        mem_props, 0x5, c_host_memory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    CHECK(found);
+    CHECK(index == 2);
+
+    std::tie(found, index) = findMemoryType(
+        mem_props, c_all_types, 0, VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+    CHECK(found);
+    CHECK(index == 3);
+
+    std::tie(found, index) = findMemoryType(
+        mem_props, 0x3, VK_MEMORY_PROPERTY_HOST_CACHED_BIT, 0);
+    CHECK(!found);
+    CHECK(index == std::numeric_limits<uint32_t>::max());
+}
+
+void testPreferredAndFallbackTypes()
+{
+    fake_vulkan::reset();
+    {
+        MemoryAllocator allocator(
+            VK_NULL_HANDLE, makeMemoryProperties(), makeLimits());
+
+        MemoryAllocation allocation;
+        CHECK(
+            allocator.allocate(
+                makeRequirements(256, 16, c_all_types),
+                c_host_memory,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                false,
+                allocation) == VK_SUCCESS);
+        CHECK(allocation.memory_type_index == 1);
+        CHECK(allocation.mapped != nullptr);
+
+        // The BAR window is full, system memory is the fallback.
+        fake_vulkan::failing_types = 1u << 1;
+        MemoryAllocation fallback;
+        CHECK(
+            allocator.allocate(
+                makeRequirements(256 * c_mib, 16, c_all_types),
+                c_host_memory,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                false,
+                fallback) == VK_SUCCESS);
+        CHECK(fallback.memory_type_index == 2);
+
+        // Out of memory once every type with the required flags failed.
+        fake_vulkan::failing_types = 0xE;
+        MemoryAllocation failed;
+        CHECK(
+            allocator.allocate(
+                makeRequirements(512 * c_mib, 16, c_all_types),
+                c_host_memory,
+                0,
+                false,
+                failed) == VK_ERROR_OUT_OF_DEVICE_MEMORY);
+        CHECK(failed.memory == VK_NULL_HANDLE);
+
+        // Device local memory never satisfies host visible requirements.
+        CHECK(
+            allocator.allocate(
+                makeRequirements(256, 16, 0x1),
+                c_host_memory,
+                0,
+                false,
+                failed) == VK_ERROR_FEATURE_NOT_PRESENT);
+
+        allocator.free(allocation);
+        allocator.free(fallback);
+    }
+    CHECK(fake_vulkan::live_allocations_num == 0);
+}
+
+void testBlockSizing()
+{
+    fake_vulkan::reset();
+    MemoryAllocator allocator(
+        VK_NULL_HANDLE, makeMemoryProperties(), makeLimits());
+
+    MemoryAllocation device_local;
+    CHECK(
+        allocator.allocate(
+            makeRequirements(1024, 16, 0x1), 0, 0, false, device_local) ==
+        VK_SUCCESS);
+    // An eighth of the 256 MiB heap is smaller than the default block size.
+    MemoryAllocation bar;
+    CHECK(
+        allocator.allocate(makeRequirements(1024, 16, 0x2), 0, 0, false, bar) ==
+        VK_SUCCESS);
+    // Allocations larger than a block get a block of their own.
+    MemoryAllocation large;
+    CHECK(
+        allocator.allocate(
+            makeRequirements(100 * c_mib + 1, 16, 0x1), 0, 0, false, large) ==
+        VK_SUCCESS);
+
+    const auto& allocations = fake_vulkan::allocations;
+    CHECK(allocations.size() == 3);
+    CHECK(allocations[0].memoryTypeIndex == 0);
+    CHECK(
+        allocations[0].allocationSize ==
+        MemoryAllocator::c_default_block_size);
+    CHECK(allocations[1].memoryTypeIndex == 1);
+    CHECK(allocations[1].allocationSize == 32 * c_mib);
+    CHECK(allocations[2].allocationSize == 100 * c_mib + c_granularity);
+
+    const MemoryAllocatorStats stats = allocator.stats();
+    CHECK(stats.blocks_num == 3);
+    CHECK(stats.allocations_num == 3);
+
+    // The last empty block of a type is kept, the others are released.
+    allocator.free(large);
+    CHECK(fake_vulkan::live_allocations_num == 2);
+    allocator.free(device_local);
+    CHECK(fake_vulkan::live_allocations_num == 2);
+    allocator.free(bar);
+}
+
+void testImageGranularity()
+{
+    fake_vulkan::reset();
+    MemoryAllocator allocator(
+        VK_NULL_HANDLE, makeMemoryProperties(), makeLimits());
+
+    MemoryAllocation buffer;
+    CHECK(
+        allocator.allocate(
+            makeRequirements(100, 16, 0x1), 0, 0, false, buffer) ==
+        VK_SUCCESS);
+    CHECK(buffer.offset == 0);
+
+    // Optimal images start and end on a page of their own.
+    MemoryAllocation image;
+    CHECK(
+        allocator.allocate(
+            makeRequirements(5000, 256, 0x1), 0, 0, true, image) ==
+        VK_SUCCESS);
+    CHECK(image.offset == c_granularity);
+    CHECK(image.size == 2 * c_granularity);
+
+    MemoryAllocation next_buffer;
+    CHECK(
+        allocator.allocate(
+            makeRequirements(4000, 16, 0x1), 0, 0, false, next_buffer) ==
+        VK_SUCCESS);
+    CHECK(next_buffer.offset == 3 * c_granularity);
+
+    // Linear images share pages with buffers like any linear resource.
+    MemoryAllocation linear_image;
+    CHECK(
+        allocator.allocate(
+            makeRequirements(5000, 256, 0x1), 0, 0, false, linear_image) ==
+        VK_SUCCESS);
+    CHECK(linear_image.offset % 256 == 0);
+    CHECK(linear_image.size == 5000);
+}
+
+void testAllocationCountLimit()
+{
+    fake_vulkan::reset();
+    VkPhysicalDeviceLimits limits = makeLimits();
+    limits.maxMemoryAllocationCount = 2;
+    MemoryAllocator allocator(VK_NULL_HANDLE, makeMemoryProperties(), limits);
+
+    const VkMemoryRequirements block_reqs =
+        makeRequirements(MemoryAllocator::c_default_block_size, 16, 0x1);
+    MemoryAllocation allocations[3];
+    CHECK(
+        allocator.allocate(block_reqs, 0, 0, false, allocations[0]) ==
+        VK_SUCCESS);
+    CHECK(
+        allocator.allocate(block_reqs, 0, 0, false, allocations[1]) ==
+        VK_SUCCESS);
+    // Refused before the driver is asked for a third device allocation.
+    CHECK(
+        allocator.allocate(block_reqs, 0, 0, false, allocations[2]) ==
+        VK_ERROR_TOO_MANY_OBJECTS);
+    CHECK(fake_vulkan::allocations.size() == 2);
+
+    allocator.free(allocations[0]);
+    CHECK(
+        allocator.allocate(block_reqs, 0, 0, false, allocations[2]) ==
+        VK_SUCCESS);
+    CHECK(fake_vulkan::live_allocations_num == 2);
+}
+
+} // namespace
+
+int main()
+{
+    testBestFit();
+    testCoalescing();
+    testAlignment();
+    testFindMemoryType();
+    testPreferredAndFallbackTypes();
+    testBlockSizing();
+    testImageGranularity();
+    testAllocationCountLimit();
+    return checkResult();
+}
@@ -0,0 +1,219 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "mesh_optimizer.h"
+#include "test_check.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Vertex = std::array<float, 3>;
+using Triangle = std::array<uint32_t, 3>;
+
+/** Triangles of a grid of quads, row by row. */
+std::vector<uint32_t> makeGridIndices(uint32_t quads_per_row)
+{
+    const uint32_t row = quads_per_row + 1;
+    std::vector<uint32_t> indices;
+    for (uint32_t y = 0; y < quads_per_row; ++y)
+    {
+        for (uint32_t x = 0; x < quads_per_row; ++x)
+        {
+            const uint32_t v = y * row + x;
+            indices.insert(indices.end(), {v, v + row, v + 1});
+            indices.insert(indices.end(), {v + 1, v + row, v + row + 1});
+        }
+    }
+    return indices;
+}
+
+/** Triangles with their winding, rotated to start at the lowest index. */
+std::vector<Triangle> sortedTriangles(const std::vector<uint32_t>& indices)
+{
+    std::vector<Triangle> triangles;
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        Triangle triangle = {indices[i], indices[i + 1], indices[i + 2]};
+        std::rotate(
+            triangle.begin(),
+            std::min_element(triangle.begin(), triangle.end()),
+            triangle.end());
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+void testGenerateIndexBuffer()
+{
+    // A quad as two triangles sharing an edge, plus a vertex that only
+    // differs in the sign of zero.
+    const Vertex vertices[] = {
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {-0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 0.0f},
+    };
+
+    std::vector<uint8_t> unique_vertices;
+    std::vector<uint32_t> indices;
+    generateIndexBuffer(
+        vertices,
+        std::size(vertices),
+        sizeof(Vertex),
+        unique_vertices,
+        indices);
+
+    const std::vector<uint32_t> expected = {0, 1, 2, 2, 1, 3, 4, 1, 0};
+    CHECK(indices == expected);
+    // Welding is bitwise, -0.0 stays a vertex of its own.
+    CHECK(unique_vertices.size() == 5 * sizeof(Vertex));
+    CHECK(
+        std::memcmp(
+            unique_vertices.data() + 3 * sizeof(Vertex),
+            &vertices[5],
+            sizeof(Vertex)) == 0);
+    CHECK(
+        std::memcmp(
+            unique_vertices.data() + 4 * sizeof(Vertex),
+            &vertices[6],
+            sizeof(Vertex)) == 0);
+
+    generateIndexBuffer(
+        vertices, 0, sizeof(Vertex), unique_vertices, indices);
+    CHECK(indices.empty());
+    CHECK(unique_vertices.empty());
+}
+
+void testOptimizeVertexCache()
+{
+    const uint32_t quads_per_row = 32;
+    const std::size_t vertex_count = (quads_per_row + 1) * (quads_per_row + 1);
+    std::vector<uint32_t> indices = makeGridIndices(quads_per_row);
+
+    // Triangles in random order share hardly any vertices with their
+    // neighbours.
+    std::vector<Triangle> triangles;
+    for (std::size_t i = 0; i < indices.size(); i += 3)
+    {
+        triangles.push_back({indices[i], indices[i + 1], indices[i + 2]});
+    }
+    std::mt19937 random(42);
+    std::shuffle(triangles.begin(), triangles.end(), random);
+    indices.clear();
+    for (const Triangle& triangle : triangles)
+    {
+        indices.insert(indices.end(), triangle.begin(), triangle.end());
+    }
+
+    const std::vector<Triangle> before_triangles = sortedTriangles(indices);
+    const VertexCacheStats before = analyzeVertexCache(indices, vertex_count);
+
+    optimizeVertexCache(indices, vertex_count);
+    const VertexCacheStats after = analyzeVertexCache(indices, vertex_count);
+
+    // Only the order of the triangles changes, not the triangles or their
+    // winding.
+    CHECK(sortedTriangles(indices) == before_triangles);
+    CHECK(after.triangles == before.triangles);
+    CHECK(after.vertices == before.vertices);
+    CHECK(before.acmr > 1.5);
+    CHECK(after.acmr < 0.9);
+    CHECK(after.misses < before.misses);
+}
+
+void testOptimizeVertexFetch()
+{
+    // Vertex 3 is unreferenced.
+    std::vector<uint8_t> vertices = {10, 11, 12, 13, 14};
+    std::vector<uint32_t> indices = {2, 0, 4, 4, 0, 1};
+
+    const std::size_t vertex_count = optimizeVertexFetch(indices, vertices, 1);
+    CHECK(vertex_count == 4);
+
+    const std::vector<uint8_t> expected_vertices = {12, 10, 14, 11};
+    const std::vector<uint32_t> expected_indices = {0, 1, 2, 2, 1, 3};
+    CHECK(vertices == expected_vertices);
+    CHECK(indices == expected_indices);
+}
+
+void testAnalyzeVertexCache()
+{
+    VertexCacheStats stats = analyzeVertexCache({0, 1, 2}, 3);
+    CHECK(stats.triangles == 1);
+    CHECK(stats.vertices == 3);
+    CHECK(stats.misses == 3);
+    CHECK(stats.acmr == 3.0);
+    CHECK(stats.atvr == 1.0);
+
+    // Two triangles sharing an edge.
+    stats = analyzeVertexCache({0, 1, 2, 2, 1, 3}, 4);
+    CHECK(stats.misses == 4);
+    CHECK(stats.acmr == 2.0);
+    CHECK(stats.atvr == 1.0);
+
+    // A FIFO of 3 has evicted the first triangle when it comes again, a
+    // FIFO of 6 still holds it.
+    const std::vector<uint32_t> repeated = {0, 1, 2, 3, 4, 5, 0, 1, 2};
+    stats = analyzeVertexCache(repeated, 6, 3);
+    CHECK(stats.misses == 9);
+    CHECK(stats.acmr == 3.0);
+    CHECK(stats.atvr == 1.5);
+    stats = analyzeVertexCache(repeated, 6, 6);
+    CHECK(stats.misses == 6);
+    CHECK(stats.atvr == 1.0);
+
+    // Unreferenced vertices don't count.
+    stats = analyzeVertexCache({0, 1, 2}, 8);
+    CHECK(stats.vertices == 3);
+}
+
+void testFitsShortIndices()
+{
+    CHECK(fitsShortIndices(0));
+    // Indices up to 0xFFFE, 0xFFFF stays the primitive restart index.
+    CHECK(fitsShortIndices(0xFFFF));
+    CHECK(!fitsShortIndices(0x10000));
+}
+
+} // namespace
+
+int main()
+{
+    testGenerateIndexBuffer();
+    testOptimizeVertexCache();
+    testOptimizeVertexFetch();
+    testAnalyzeVertexCache();
+    testFitsShortIndices();
+    return checkResult();
+}
@@ -0,0 +1,191 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "fake_vulkan.h"
+#include "pipeline_cache.h"
+#include "test_check.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+// Written to the working directory, which ctest points at the build tree.
+const char* c_path = "pipeline_cache_test.bin";
+
+VkPhysicalDeviceProperties makeDeviceProperties()
+{
+    VkPhysicalDeviceProperties props = {};
+    props.vendorID = 1;
+    props.deviceID = 2;
+    for (uint8_t i = 0; i < VK_UUID_SIZE; ++i)
+    {
+        props.pipelineCacheUUID[i] = i;
+    }
+    return props;
+}
+
+/** Cache data as the driver of the device writes it. */
+std::vector<uint8_t> makeCacheData(
+    const VkPhysicalDeviceProperties& props, std::size_t payload_size)
+{
+    const uint32_t header[] = {
+        16 + VK_UUID_SIZE,
+        VK_PIPELINE_CACHE_HEADER_VERSION_ONE,
+        props.vendorID,
+        props.deviceID};
+    std::vector<uint8_t> data(sizeof(header) + VK_UUID_SIZE + payload_size);
+    std::memcpy(data.data(), header, sizeof(header));
+    std::memcpy(
+        data.data() + sizeof(header), props.pipelineCacheUUID, VK_UUID_SIZE);
+    for (std::size_t i = sizeof(header) + VK_UUID_SIZE; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    return data;
+}
+
+void testRoundTrip()
+{
+    fake_vulkan::reset();
+    std::remove(c_path);
+    const VkPhysicalDeviceProperties props = makeDeviceProperties();
+    const std::vector<uint8_t> data = makeCacheData(props, 100);
+    {
+        PipelineCache cache(VK_NULL_HANDLE, props, c_path);
+        CHECK(cache.create() == VK_SUCCESS);
+        CHECK(cache.loadResult() == PipelineCacheLoad::Missing);
+        CHECK(fake_vulkan::pipeline_cache_initial_data.empty());
+
+        fake_vulkan::pipeline_cache_data = data;
+        CHECK(cache.save());
+
+        // Nothing changed since, so nothing is written.
+        std::remove(c_path);
+        CHECK(cache.save());
+        CHECK(!std::ifstream(c_path));
+        fake_vulkan::pipeline_cache_data.push_back(0);
+        CHECK(cache.save());
+        CHECK(std::ifstream(c_path));
+        fake_vulkan::pipeline_cache_data.pop_back();
+        CHECK(cache.save());
+    }
+    {
+        PipelineCache cache(VK_NULL_HANDLE, props, c_path);
+        CHECK(cache.create() == VK_SUCCESS);
+        CHECK(cache.loadResult() == PipelineCacheLoad::Warm);
+        CHECK(fake_vulkan::pipeline_cache_initial_data == data);
+    }
+    std::remove(c_path);
+}
+
+void testRejectedFiles()
+{
+    fake_vulkan::reset();
+    std::remove(c_path);
+    const VkPhysicalDeviceProperties props = makeDeviceProperties();
+    {
+        PipelineCache cache(VK_NULL_HANDLE, props, c_path);
+        CHECK(cache.create() == VK_SUCCESS);
+        fake_vulkan::pipeline_cache_data = makeCacheData(props, 100);
+        CHECK(cache.save());
+    }
+
+    // Another cache UUID, e.g. after a driver update.
+    {
+        VkPhysicalDeviceProperties updated = props;
+        ++updated.pipelineCacheUUID[0];
+        PipelineCache cache(VK_NULL_HANDLE, updated, c_path);
+        CHECK(cache.create() == VK_SUCCESS);
+        CHECK(cache.loadResult() == PipelineCacheLoad::OtherDevice);
+        CHECK(fake_vulkan::pipeline_cache_initial_data.empty());
+    }
+
+    // Truncated and appended to files fail the envelope.
+    std::vector<char> bytes;
+    {
+        std::ifstream file(c_path, std::ios::binary);
+        bytes.assign(
+            std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>());
+    }
+    for (std::size_t size : {bytes.size() - 1, std::size_t{4}})
+    {
+        {
+            std::ofstream file(c_path, std::ios::binary);
+            file.write(bytes.data(), static_cast<std::streamsize>(size));
+        }
+        PipelineCache cache(VK_NULL_HANDLE, props, c_path);
+        CHECK(cache.create() == VK_SUCCESS);
+        CHECK(cache.loadResult() == PipelineCacheLoad::Corrupt);
+        CHECK(fake_vulkan::pipeline_cache_initial_data.empty());
+    }
+    {
+        std::ofstream file(c_path, std::ios::binary);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        file << "x";
+    }
+    {
+        PipelineCache cache(VK_NULL_HANDLE, props, c_path);
+        CHECK(cache.create() == VK_SUCCESS);
+        CHECK(cache.loadResult() == PipelineCacheLoad::Corrupt);
+    }
+    std::remove(c_path);
+}
+
+void testIncompleteSave()
+{
+    fake_vulkan::reset();
+    std::remove(c_path);
+    const VkPhysicalDeviceProperties props = makeDeviceProperties();
+    const std::vector<uint8_t> data = makeCacheData(props, 100);
+    {
+        PipelineCache cache(VK_NULL_HANDLE, props, c_path);
+        CHECK(cache.create() == VK_SUCCESS);
+        fake_vulkan::pipeline_cache_data = data;
+        fake_vulkan::pipeline_cache_growth = 64;
+        CHECK(cache.save());
+    }
+
+    // The prefix that fit is saved, and it is a valid cache.
+    {
+        PipelineCache cache(VK_NULL_HANDLE, props, c_path);
+        CHECK(cache.create() == VK_SUCCESS);
+        CHECK(cache.loadResult() == PipelineCacheLoad::Warm);
+        CHECK(fake_vulkan::pipeline_cache_initial_data == data);
+    }
+    std::remove(c_path);
+}
+
+} // namespace
+
+int main()
+{
+    testRoundTrip();
+    testRejectedFiles();
+    testIncompleteSave();
+    return checkResult();
+}
@@ -0,0 +1,151 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "fake_vulkan.h"
+#include "pipeline_factory.h"
+#include "test_check.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Keys only differ in the layout handle, nothing looks at it.
+PipelineKey makeKey(uintptr_t layout)
+{
+    PipelineKey key;
+    key.layout = reinterpret_cast<VkPipelineLayout>(layout);
+    return key;
+}
+
+const VkPipeline c_fallback = reinterpret_cast<VkPipeline>(uintptr_t{~0u});
+
+void testGet()
+{
+    fake_vulkan::reset();
+    {
+        PipelineFactory factory(VK_NULL_HANDLE, VK_NULL_HANDLE, 2);
+        VkPipeline first = VK_NULL_HANDLE;
+        VkPipeline second = VK_NULL_HANDLE;
+        CHECK(factory.get(makeKey(1), first) == VK_SUCCESS);
+        CHECK(factory.get(makeKey(1), second) == VK_SUCCESS);
+        CHECK(first != VK_NULL_HANDLE);
+        CHECK(first == second);
+        CHECK(factory.get(makeKey(2), second) == VK_SUCCESS);
+        CHECK(first != second);
+        CHECK(fake_vulkan::created_pipelines_num == 2);
+
+        // Released pipelines belong to the caller.
+        CHECK(factory.release(makeKey(1)) == first);
+        CHECK(factory.release(makeKey(1)) == VK_NULL_HANDLE);
+        vkDestroyPipeline(VK_NULL_HANDLE, first, nullptr);
+    }
+    CHECK(fake_vulkan::live_pipelines_num == 0);
+}
+
+void testGetOrFallback()
+{
+    fake_vulkan::reset();
+    fake_vulkan::pipeline_compile_time = std::chrono::milliseconds(20);
+    {
+        PipelineFactory factory(VK_NULL_HANDLE, VK_NULL_HANDLE, 2);
+        CHECK(factory.getOrFallback(makeKey(1), c_fallback) == c_fallback);
+
+        // get() waits for the worker instead of compiling a second time.
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        CHECK(factory.get(makeKey(1), pipeline) == VK_SUCCESS);
+        CHECK(factory.getOrFallback(makeKey(1), c_fallback) == pipeline);
+        CHECK(fake_vulkan::created_pipelines_num == 1);
+    }
+    CHECK(fake_vulkan::live_pipelines_num == 0);
+}
+
+/**
+ * Threads waiting in get() for a key that is compiling while another
+ * thread releases it: each waiter either gets the pipeline before the
+ * release or fails, it never reads the erased entry.
+ */
+void testConcurrentGetAndRelease()
+{
+    fake_vulkan::reset();
+    fake_vulkan::pipeline_compile_time = std::chrono::milliseconds(10);
+    constexpr int c_rounds = 20;
+    constexpr int c_waiters = 4;
+    {
+        PipelineFactory factory(VK_NULL_HANDLE, VK_NULL_HANDLE, 2);
+        for (int round = 0; round < c_rounds; ++round)
+        {
+            const PipelineKey key = makeKey(100 + round);
+            std::atomic<int> failed(0);
+            std::vector<VkPipeline> got(c_waiters, VK_NULL_HANDLE);
+
+            std::vector<std::thread> threads;
+            for (int i = 0; i < c_waiters; ++i)
+            {
+                threads.emplace_back([&, i] {
+                    if (factory.get(key, got[i]) != VK_SUCCESS)
+                    {
+                        ++failed;
+                    }
+                });
+            }
+            // The waiters are blocked on the compile by now.
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            VkPipeline released = factory.release(key);
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            // A waiter that came too late compiles the key again, the
+            // factory owns that pipeline.
+            int succeeded = 0;
+            for (VkPipeline pipeline : got)
+            {
+                if (pipeline != VK_NULL_HANDLE)
+                {
+                    ++succeeded;
+                }
+            }
+            CHECK(released != VK_NULL_HANDLE);
+            CHECK(succeeded + failed == c_waiters);
+            if (released != VK_NULL_HANDLE)
+            {
+                vkDestroyPipeline(VK_NULL_HANDLE, released, nullptr);
+            }
+        }
+    }
+    CHECK(fake_vulkan::live_pipelines_num == 0);
+}
+
+} // namespace
+
+int main()
+{
+    testGet();
+    testGetOrFallback();
+    testConcurrentGetAndRelease();
+    return checkResult();
+}
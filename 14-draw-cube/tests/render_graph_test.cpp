@@ -0,0 +1,474 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "fake_vulkan.h"
+#include "render_graph.h"
+#include "test_check.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr VkDeviceSize c_mib = 1024 * 1024;
+
+const ImageDesc c_color_desc = {VK_FORMAT_B8G8R8A8_UNORM, {64, 64}};
+const ImageDesc c_depth_desc = {VK_FORMAT_D16_UNORM, {64, 64}};
+
+/** lazy_type adds a lazily allocated memory type 2 as tilers have. */
+VkPhysicalDeviceMemoryProperties makeMemoryProperties(bool lazy_type = false)
+{
+    VkPhysicalDeviceMemoryProperties mem_props = {};
+    mem_props.memoryHeapCount = 1;
+    mem_props.memoryHeaps[0] = {4096 * c_mib, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT};
+    mem_props.memoryTypeCount = lazy_type ? 3 : 2;
+    mem_props.memoryTypes[0] = {VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0};
+    mem_props.memoryTypes[1] = {VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, 0};
+    mem_props.memoryTypes[2] = {
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+            VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT,
+        0};
+    return mem_props;
+}
+
+VkPhysicalDeviceLimits makeLimits()
+{
+    VkPhysicalDeviceLimits limits = {};
+    limits.bufferImageGranularity = 1024;
+    limits.maxMemoryAllocationCount = 4096;
+    return limits;
+}
+
+/** Every transient resource takes 1 MiB of device local memory. */
+void resetFakes()
+{
+    fake_vulkan::reset();
+    fake_vulkan::memory_requirements = {c_mib, 4096, 0x1};
+}
+
+/** Stands in for a swapchain image. */
+template <typename Handle>
+Handle importedHandle(uintptr_t value)
+{
+    return reinterpret_cast<Handle>(0x10000 + value);
+}
+
+const VkImageMemoryBarrier* findImageBarrier(
+    const fake_vulkan::PipelineBarrier& barrier, VkImage image)
+{
+    for (const VkImageMemoryBarrier& image_barrier : barrier.image_barriers)
+    {
+        if (image_barrier.image == image)
+        {
+            return &image_barrier;
+        }
+    }
+    return nullptr;
+}
+
+void testCullingAndBarriers()
+{
+    resetFakes();
+    MemoryAllocator memory_allocator(
+        VK_NULL_HANDLE, makeMemoryProperties(), makeLimits());
+    {
+        RenderGraph graph(VK_NULL_HANDLE, memory_allocator);
+        const uint32_t color = graph.importImage(
+            "color",
+            c_color_desc,
+            {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+             0,
+             VK_IMAGE_LAYOUT_UNDEFINED},
+            {VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+             0,
+             VK_IMAGE_LAYOUT_PRESENT_SRC_KHR});
+        const uint32_t draws = graph.importBuffer("draws", {}, {});
+        const uint32_t depth = graph.createImage("depth", c_depth_desc);
+        const uint32_t shadow = graph.createImage("shadow", c_depth_desc);
+        const uint32_t hdr = graph.createImage("hdr", c_color_desc);
+        const uint32_t debug_image = graph.createImage("debug", c_color_desc);
+        const uint32_t scratch = graph.createBuffer("scratch", 1000);
+        const VkClearValue clear_value = {};
+
+        const uint32_t cull = graph.addPass("cull", PassType::Compute);
+        graph.write(cull, draws, ResourceUsage::StorageWrite);
+        graph.write(cull, scratch, ResourceUsage::StorageWrite);
+        const uint32_t shadows = graph.addPass("shadow", PassType::Graphics);
+        graph.write(shadows, shadow, ResourceUsage::DepthAttachment);
+        graph.clear(shadows, shadow, clear_value);
+        const uint32_t scene = graph.addPass("scene", PassType::Graphics);
+        graph.write(scene, hdr, ResourceUsage::ColorAttachment);
+        graph.clear(scene, hdr, clear_value);
+        graph.write(scene, depth, ResourceUsage::DepthAttachment);
+        graph.clear(scene, depth, clear_value);
+        graph.read(scene, draws, ResourceUsage::IndirectBuffer);
+        graph.read(scene, shadow, ResourceUsage::Sampled);
+        // Writes an image nothing reads.
+        const uint32_t debug = graph.addPass("debug", PassType::Graphics);
+        graph.write(debug, debug_image, ResourceUsage::ColorAttachment);
+        graph.read(debug, hdr, ResourceUsage::Sampled);
+        const uint32_t tonemap = graph.addPass("tonemap", PassType::Graphics);
+        graph.write(tonemap, color, ResourceUsage::ColorAttachment);
+        graph.clear(tonemap, color, clear_value);
+        graph.read(tonemap, hdr, ResourceUsage::Sampled);
+
+        for (uint32_t pass : {cull, shadows, scene, debug, tonemap})
+        {
+            graph.setRecord(pass, [pass](VkCommandBuffer) {
+                const char* names[] = {
+                    "cull", "shadow", "scene", "debug", "tonemap"};
+                fake_vulkan::commands.push_back(names[pass]);
+            });
+        }
+        graph.setHooks(
+            scene,
+            [](VkCommandBuffer) {
+                fake_vulkan::commands.push_back("scene before");
+            },
+            [](VkCommandBuffer) {
+                fake_vulkan::commands.push_back("scene after");
+            });
+        graph.setHooks(
+            cull,
+            [](VkCommandBuffer) {
+                fake_vulkan::commands.push_back("cull before");
+            },
+            nullptr);
+
+        CHECK(graph.compile() == VK_SUCCESS);
+        CHECK(graph.culled(debug));
+        CHECK(!graph.culled(cull));
+        CHECK(!graph.culled(shadows));
+        CHECK(!graph.culled(scene));
+        CHECK(!graph.culled(tonemap));
+        // Nothing is created for what only the culled pass used.
+        CHECK(graph.image(debug_image) == VK_NULL_HANDLE);
+        CHECK(graph.buffer(scratch) != VK_NULL_HANDLE);
+        CHECK(fake_vulkan::live_render_passes_num == 3);
+        CHECK(fake_vulkan::live_images_num == 3);
+        CHECK(fake_vulkan::live_image_views_num == 3);
+        CHECK(fake_vulkan::live_buffers_num == 1);
+
+        const RenderGraphStats stats = graph.stats();
+        CHECK(stats.passes_num == 5);
+        CHECK(stats.culled_passes_num == 1);
+        // The lifetimes of shadow, depth, hdr and scratch all overlap.
+        CHECK(stats.transient_resources_num == 4);
+        CHECK(stats.transient_bytes == 4 * c_mib);
+        CHECK(stats.aliased_bytes == 4 * c_mib);
+
+        // The tonemap render pass clears and stores the imported image.
+        CHECK(fake_vulkan::render_pass_attachments.size() == 1);
+        CHECK(
+            fake_vulkan::render_pass_attachments[0].loadOp ==
+            VK_ATTACHMENT_LOAD_OP_CLEAR);
+        CHECK(
+            fake_vulkan::render_pass_attachments[0].storeOp ==
+            VK_ATTACHMENT_STORE_OP_STORE);
+
+        // The swapchain image isn't bound yet.
+        CHECK(graph.execute(VK_NULL_HANDLE) == VK_ERROR_INITIALIZATION_FAILED);
+        CHECK(fake_vulkan::commands.empty());
+
+        const VkImage color_image = importedHandle<VkImage>(1);
+        graph.setImage(color, color_image, importedHandle<VkImageView>(2));
+        CHECK(graph.execute(VK_NULL_HANDLE) == VK_SUCCESS);
+        const std::vector<std::string> expected_commands = {
+            "cull before", "barrier", "cull",
+            "barrier", "begin", "shadow", "end",
+            "scene before", "barrier", "begin", "scene", "end", "scene after",
+            "barrier", "begin", "tonemap", "end",
+            "barrier"};
+        CHECK(fake_vulkan::commands == expected_commands);
+        CHECK(fake_vulkan::live_framebuffers_num == 3);
+
+        const std::vector<fake_vulkan::PipelineBarrier>& barriers =
+            fake_vulkan::pipeline_barriers;
+        CHECK(barriers.size() == 5);
+        if (barriers.size() == 5)
+        {
+            // The indirect draw waits on the compute writes through a
+            // global memory barrier, the shadow map becomes readable.
+            const fake_vulkan::PipelineBarrier& to_scene = barriers[2];
+            CHECK(to_scene.src_stages & VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+            CHECK(
+                to_scene.src_stages &
+                VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
+            CHECK(to_scene.dst_stages & VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+            CHECK(to_scene.dst_stages & VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+            CHECK(to_scene.memory_barriers.size() == 1);
+            if (!to_scene.memory_barriers.empty())
+            {
+                const VkMemoryBarrier& memory = to_scene.memory_barriers[0];
+                CHECK(memory.srcAccessMask & VK_ACCESS_SHADER_WRITE_BIT);
+                CHECK(
+                    memory.dstAccessMask &
+                    VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+            }
+            const VkImageMemoryBarrier* shadow_barrier =
+                findImageBarrier(to_scene, graph.image(shadow));
+            CHECK(shadow_barrier != nullptr);
+            if (shadow_barrier != nullptr)
+            {
+                CHECK(
+                    shadow_barrier->oldLayout ==
+                    VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+                CHECK(
+                    shadow_barrier->newLayout ==
+                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+                CHECK(
+                    shadow_barrier->srcAccessMask ==
+                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+                CHECK(
+                    shadow_barrier->dstAccessMask ==
+                    VK_ACCESS_SHADER_READ_BIT);
+            }
+
+            // Only images move between scene and tonemap.
+            const fake_vulkan::PipelineBarrier& to_tonemap = barriers[3];
+            CHECK(to_tonemap.memory_barriers.empty());
+            CHECK(
+                to_tonemap.src_stages &
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+            CHECK(
+                to_tonemap.dst_stages & VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+            const VkImageMemoryBarrier* hdr_barrier =
+                findImageBarrier(to_tonemap, graph.image(hdr));
+            CHECK(hdr_barrier != nullptr);
+            if (hdr_barrier != nullptr)
+            {
+                CHECK(
+                    hdr_barrier->oldLayout ==
+                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+                CHECK(
+                    hdr_barrier->newLayout ==
+                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+                CHECK(
+                    hdr_barrier->srcAccessMask ==
+                    VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+                CHECK(hdr_barrier->dstAccessMask == VK_ACCESS_SHADER_READ_BIT);
+            }
+            const VkImageMemoryBarrier* color_barrier =
+                findImageBarrier(to_tonemap, color_image);
+            CHECK(color_barrier != nullptr);
+            if (color_barrier != nullptr)
+            {
+                CHECK(color_barrier->oldLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+                CHECK(
+                    color_barrier->newLayout ==
+                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+            }
+
+            // After the last pass the imported image goes to its final state.
+            const fake_vulkan::PipelineBarrier& to_present = barriers[4];
+            CHECK(
+                to_present.dst_stages ==
+                VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+            CHECK(to_present.image_barriers.size() == 1);
+            color_barrier = findImageBarrier(to_present, color_image);
+            CHECK(color_barrier != nullptr);
+            if (color_barrier != nullptr)
+            {
+                CHECK(
+                    color_barrier->newLayout ==
+                    VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+                CHECK(color_barrier->dstAccessMask == 0);
+            }
+        }
+
+        // The framebuffers are kept for the next frame.
+        fake_vulkan::commands.clear();
+        CHECK(graph.execute(VK_NULL_HANDLE) == VK_SUCCESS);
+        CHECK(fake_vulkan::commands == expected_commands);
+        CHECK(fake_vulkan::live_framebuffers_num == 3);
+    }
+    CHECK(fake_vulkan::live_images_num == 0);
+    CHECK(fake_vulkan::live_image_views_num == 0);
+    CHECK(fake_vulkan::live_buffers_num == 0);
+    CHECK(fake_vulkan::live_render_passes_num == 0);
+    CHECK(fake_vulkan::live_framebuffers_num == 0);
+}
+
+void testAliasing()
+{
+    resetFakes();
+    MemoryAllocator memory_allocator(
+        VK_NULL_HANDLE, makeMemoryProperties(), makeLimits());
+    RenderGraph graph(VK_NULL_HANDLE, memory_allocator);
+    const uint32_t out = graph.importImage("out", c_color_desc, {}, {});
+    // A chain where every image dies in the pass after the one writing it,
+    // so a and c can share memory and b sits beside them.
+    const uint32_t a = graph.createImage("a", c_color_desc);
+    const uint32_t b = graph.createImage("b", c_color_desc);
+    const uint32_t c = graph.createImage("c", c_color_desc);
+    const uint32_t p0 = graph.addPass("p0", PassType::Graphics);
+    graph.write(p0, a, ResourceUsage::ColorAttachment);
+    graph.clear(p0, a, {});
+    const uint32_t p1 = graph.addPass("p1", PassType::Graphics);
+    graph.read(p1, a, ResourceUsage::Sampled);
+    graph.write(p1, b, ResourceUsage::ColorAttachment);
+    const uint32_t p2 = graph.addPass("p2", PassType::Graphics);
+    graph.read(p2, b, ResourceUsage::Sampled);
+    graph.write(p2, c, ResourceUsage::ColorAttachment);
+    const uint32_t p3 = graph.addPass("p3", PassType::Transfer);
+    graph.read(p3, c, ResourceUsage::TransferSrc);
+    graph.write(p3, out, ResourceUsage::TransferDst);
+
+    CHECK(graph.compile() == VK_SUCCESS);
+    const RenderGraphStats stats = graph.stats();
+    CHECK(stats.culled_passes_num == 0);
+    CHECK(stats.transient_resources_num == 3);
+    CHECK(stats.transient_bytes == 3 * c_mib);
+    CHECK(stats.aliased_bytes == 2 * c_mib);
+
+    // Bound in the order the images were declared.
+    const std::vector<fake_vulkan::MemoryBinding>& bindings =
+        fake_vulkan::memory_bindings;
+    CHECK(bindings.size() == 3);
+    if (bindings.size() == 3)
+    {
+        CHECK(bindings[0].memory == bindings[2].memory);
+        CHECK(bindings[0].offset == bindings[2].offset);
+        CHECK(
+            bindings[0].memory != bindings[1].memory ||
+            bindings[0].offset != bindings[1].offset);
+    }
+
+    // The last render pass, p2's, has nothing to load into c but keeps it
+    // for the copy.
+    CHECK(fake_vulkan::render_pass_attachments.size() == 1);
+    CHECK(
+        fake_vulkan::render_pass_attachments[0].loadOp ==
+        VK_ATTACHMENT_LOAD_OP_DONT_CARE);
+    CHECK(
+        fake_vulkan::render_pass_attachments[0].storeOp ==
+        VK_ATTACHMENT_STORE_OP_STORE);
+
+    graph.setImage(
+        out, importedHandle<VkImage>(1), importedHandle<VkImageView>(2));
+    CHECK(graph.execute(VK_NULL_HANDLE) == VK_SUCCESS);
+    // a takes over the memory from c, so p0 waits for the copy from c
+    // and the writes to it of the frame before.
+    CHECK(!fake_vulkan::pipeline_barriers.empty());
+    if (!fake_vulkan::pipeline_barriers.empty())
+    {
+        const fake_vulkan::PipelineBarrier& to_p0 =
+            fake_vulkan::pipeline_barriers[0];
+        CHECK(to_p0.src_stages & VK_PIPELINE_STAGE_TRANSFER_BIT);
+        CHECK(to_p0.memory_barriers.size() == 1);
+        if (!to_p0.memory_barriers.empty())
+        {
+            CHECK(
+                to_p0.memory_barriers[0].srcAccessMask ==
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+        }
+        const VkImageMemoryBarrier* a_barrier =
+            findImageBarrier(to_p0, graph.image(a));
+        CHECK(a_barrier != nullptr);
+        if (a_barrier != nullptr)
+        {
+            CHECK(a_barrier->oldLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+        }
+    }
+}
+
+/**
+ * A depth buffer that never leaves its render pass is a transient
+ * attachment and goes to lazily allocated memory where there is some. A
+ * readback of the color image only survives when it feeds an imported
+ * buffer.
+ */
+void testTransientAttachments()
+{
+    for (bool headless : {false, true})
+    {
+        for (bool lazy : {false, true})
+        {
+            resetFakes();
+            fake_vulkan::transient_memory_type_bits = 0x4;
+            MemoryAllocator memory_allocator(
+                VK_NULL_HANDLE, makeMemoryProperties(lazy), makeLimits());
+            RenderGraph graph(VK_NULL_HANDLE, memory_allocator);
+            const uint32_t color =
+                graph.importImage("color", c_color_desc, {}, {});
+            const uint32_t depth = graph.createImage("depth", c_depth_desc);
+            const uint32_t readback_buffer = graph.importBuffer(
+                "readback",
+                {},
+                {VK_PIPELINE_STAGE_HOST_BIT,
+                 VK_ACCESS_HOST_READ_BIT,
+                 VK_IMAGE_LAYOUT_UNDEFINED});
+            const uint32_t draw = graph.addPass("draw", PassType::Graphics);
+            graph.write(draw, color, ResourceUsage::ColorAttachment);
+            graph.clear(draw, color, {});
+            graph.write(draw, depth, ResourceUsage::DepthAttachment);
+            graph.clear(draw, depth, {});
+            const uint32_t readback =
+                graph.addPass("readback", PassType::Transfer);
+            if (headless)
+            {
+                graph.read(readback, color, ResourceUsage::TransferSrc);
+                graph.write(
+                    readback, readback_buffer, ResourceUsage::TransferDst);
+            }
+
+            CHECK(graph.compile() == VK_SUCCESS);
+            CHECK(!graph.culled(draw));
+            CHECK(graph.culled(readback) == !headless);
+            CHECK(fake_vulkan::image_usages.size() == 1);
+            if (!fake_vulkan::image_usages.empty())
+            {
+                CHECK(
+                    fake_vulkan::image_usages[0] &
+                    VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT);
+            }
+            const RenderGraphStats stats = graph.stats();
+            CHECK(stats.transient_attachments_num == 1);
+            CHECK(stats.lazy_bytes == (lazy ? c_mib : 0));
+            CHECK(!fake_vulkan::allocations.empty());
+            if (!fake_vulkan::allocations.empty())
+            {
+                CHECK(
+                    fake_vulkan::allocations.back().memoryTypeIndex ==
+                    (lazy ? 2u : 0u));
+            }
+
+            graph.setImage(
+                color,
+                importedHandle<VkImage>(1),
+                importedHandle<VkImageView>(2));
+            CHECK(graph.execute(VK_NULL_HANDLE) == VK_SUCCESS);
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    testCullingAndBarriers();
+    testAliasing();
+    testTransientAttachments();
+    return checkResult();
+}
@@ -0,0 +1,273 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "embedded_shaders.h"
+#include "shader_reflection.h"
+#include "test_check.h"
+
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace {
+
+ShaderReflection reflect(const std::vector<uint8_t>& spirv)
+{
+    ShaderReflection reflection;
+    std::string error;
+    const bool reflected = reflectShader(spirv, reflection, error);
+    CHECK(reflected);
+    CHECK(error.empty());
+    return reflection;
+}
+
+const InterfaceVariable* findVariable(
+    const std::vector<InterfaceVariable>& variables, const std::string& name)
+{
+    for (const InterfaceVariable& variable : variables)
+    {
+        if (variable.name == name)
+        {
+            return &variable;
+        }
+    }
+    return nullptr;
+}
+
+/** Words of one instruction, the count goes into the first word. */
+void emit(
+    std::vector<uint32_t>& words,
+    uint32_t opcode,
+    std::initializer_list<uint32_t> operands)
+{
+    words.push_back(
+        (static_cast<uint32_t>(operands.size() + 1) << 16) | opcode);
+    words.insert(words.end(), operands);
+}
+
+std::vector<uint8_t> toBytes(const std::vector<uint32_t>& words)
+{
+    std::vector<uint8_t> bytes(words.size() * sizeof(uint32_t));
+    std::memcpy(bytes.data(), words.data(), bytes.size());
+    return bytes;
+}
+
+/**
+ * A vertex shader with the push constant block
+ *
+ *  layout (push_constant) uniform PushConstants {
+ *      layout (row_major) mat2x3 row;
+ *      layout (column_major) mat2x3 column;
+ *  };
+ *
+ * which glslang lays out with a matrix stride of 16 bytes.
+ */
+std::vector<uint8_t> makeMatrixLayoutShader()
+{
+    enum : uint32_t
+    {
+        c_main = 1,
+        c_float,
+        c_vec3,
+        c_mat2x3,
+        c_block,
+        c_block_ptr,
+        c_push,
+        c_bound
+    };
+    std::vector<uint32_t> words = {0x07230203, 0x00010000, 0, c_bound, 0};
+    emit(words, 17, {1});                           // Capability Shader
+    emit(words, 14, {0, 1});                        // MemoryModel GLSL450
+    emit(words, 15, {0, c_main, 0x6E69616D, 0});    // EntryPoint "main"
+    emit(words, 5, {c_block, 0x68737550, 0});       // Name "Push"
+    emit(words, 71, {c_block, 2});                  // Block
+    emit(words, 72, {c_block, 0, 4});               // RowMajor
+    emit(words, 72, {c_block, 0, 35, 0});           // Offset 0
+    emit(words, 72, {c_block, 0, 7, 16});           // MatrixStride 16
+    emit(words, 72, {c_block, 1, 5});               // ColMajor
+    emit(words, 72, {c_block, 1, 35, 48});          // Offset 48
+    emit(words, 72, {c_block, 1, 7, 16});           // MatrixStride 16
+    emit(words, 22, {c_float, 32});                 // TypeFloat
+    emit(words, 23, {c_vec3, c_float, 3});          // TypeVector
+    emit(words, 24, {c_mat2x3, c_vec3, 2});         // TypeMatrix
+    emit(words, 30, {c_block, c_mat2x3, c_mat2x3}); // TypeStruct
+    emit(words, 32, {c_block_ptr, 9, c_block});     // TypePointer
+    emit(words, 59, {c_block_ptr, c_push, 9});      // Variable
+    return toBytes(words);
+}
+
+void testUniformBuffer()
+{
+    const ShaderReflection reflection = reflect(c_vert_shader);
+    CHECK(reflection.stage == VK_SHADER_STAGE_VERTEX_BIT);
+    CHECK(reflection.entry_point == "main");
+    CHECK(!reflection.has_push_constants);
+    CHECK(reflection.bindings.size() == 1);
+    if (!reflection.bindings.empty())
+    {
+        const DescriptorBinding& binding = reflection.bindings[0];
+        CHECK(binding.set == 0);
+        CHECK(binding.binding == 0);
+        CHECK(binding.type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+        CHECK(binding.count == 1);
+        CHECK(binding.block.size == 64);
+    }
+    CHECK(reflection.inputs.size() == 2);
+    const InterfaceVariable* in_color =
+        findVariable(reflection.inputs, "in_color");
+    CHECK(in_color != nullptr && in_color->location == 1);
+    CHECK(reflection.outputs.size() == 1);
+}
+
+void testPushConstants()
+{
+    const ShaderReflection reflection = reflect(c_push_constant_vert_shader);
+    CHECK(reflection.bindings.empty());
+    CHECK(reflection.has_push_constants);
+    CHECK(reflection.push_constants.size == 64);
+
+    const ShaderReflection storage = reflect(c_storage_buffer_vert_shader);
+    CHECK(storage.bindings.size() == 1);
+    if (!storage.bindings.empty())
+    {
+        CHECK(storage.bindings[0].type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+        // Only a runtime array, which takes no fixed space.
+        CHECK(storage.bindings[0].block.size == 0);
+    }
+}
+
+void testInstancedInput()
+{
+    const ShaderReflection reflection = reflect(c_instanced_vert_shader);
+    CHECK(reflection.push_constants.size == 64);
+    CHECK(reflection.inputs.size() == 4);
+    const InterfaceVariable* model =
+        findVariable(reflection.inputs, "in_model");
+    CHECK(model != nullptr);
+    if (model != nullptr)
+    {
+        // A mat4 input takes a location per column.
+        CHECK(model->location == 2);
+        CHECK(model->locations == 4);
+        CHECK(model->format == VK_FORMAT_R32G32B32A32_SFLOAT);
+    }
+    const InterfaceVariable* color =
+        findVariable(reflection.inputs, "in_instance_color");
+    CHECK(color != nullptr && color->location == 6);
+
+    std::string error;
+    std::vector<VkVertexInputAttributeDescription> attributes;
+    for (uint32_t location = 0; location < 7; ++location)
+    {
+        attributes.push_back(
+            {location, 0, VK_FORMAT_R32G32B32A32_SFLOAT, 0});
+    }
+    CHECK(checkVertexInput(reflection, attributes, error));
+    // The last column of the model matrix isn't fed.
+    attributes.erase(attributes.begin() + 5);
+    CHECK(!checkVertexInput(reflection, attributes, error));
+    CHECK(!error.empty());
+}
+
+void testCullShader()
+{
+    const ShaderReflection reflection = reflect(c_cull_comp_shader);
+    CHECK(reflection.stage == VK_SHADER_STAGE_COMPUTE_BIT);
+    CHECK(reflection.inputs.empty());
+    CHECK(reflection.bindings.size() == 3);
+    for (uint32_t i = 0; i < reflection.bindings.size(); ++i)
+    {
+        const DescriptorBinding& binding = reflection.bindings[i];
+        CHECK(binding.set == 0);
+        CHECK(binding.binding == i);
+        CHECK(binding.type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    }
+    if (reflection.bindings.size() == 3)
+    {
+        // VkDrawIndexedIndirectCommand.
+        CHECK(reflection.bindings[2].block.size == 20);
+    }
+    // Six planes and the instance count.
+    CHECK(reflection.has_push_constants);
+    CHECK(reflection.push_constants.size == 100);
+    CHECK(reflection.push_constants.members.size() == 2);
+    if (reflection.push_constants.members.size() == 2)
+    {
+        CHECK(reflection.push_constants.members[0].size == 96);
+        CHECK(reflection.push_constants.members[1].offset == 96);
+    }
+}
+
+void testFragmentShader()
+{
+    const ShaderReflection reflection = reflect(c_frag_shader);
+    CHECK(reflection.stage == VK_SHADER_STAGE_FRAGMENT_BIT);
+    CHECK(reflection.bindings.empty());
+    CHECK(!reflection.has_push_constants);
+    CHECK(reflection.inputs.size() == 1);
+    CHECK(reflection.outputs.size() == 1);
+}
+
+void testMatrixLayout()
+{
+    const ShaderReflection reflection = reflect(makeMatrixLayoutShader());
+    CHECK(reflection.has_push_constants);
+    CHECK(reflection.push_constants.members.size() == 2);
+    if (reflection.push_constants.members.size() == 2)
+    {
+        // Three rows of 16 bytes against two columns of 16 bytes.
+        CHECK(reflection.push_constants.members[0].size == 48);
+        CHECK(reflection.push_constants.members[1].size == 32);
+    }
+    CHECK(reflection.push_constants.size == 80);
+}
+
+void testMalformed()
+{
+    ShaderReflection reflection;
+    std::string error;
+    CHECK(!reflectShader({1, 2, 3, 4}, reflection, error));
+    CHECK(!error.empty());
+
+    // Cut in the middle of an instruction.
+    const std::vector<uint8_t> truncated(
+        c_vert_shader.begin(), c_vert_shader.begin() + 40);
+    error.clear();
+    CHECK(!reflectShader(truncated, reflection, error));
+    CHECK(!error.empty());
+}
+
+} // namespace
+
+int main()
+{
+    testUniformBuffer();
+    testPushConstants();
+    testInstancedInput();
+    testCullShader();
+    testFragmentShader();
+    testMatrixLayout();
+    testMalformed();
+    return checkResult();
+}
@@ -0,0 +1,286 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Yuriy Khokhulya
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "mesh_optimizer.h"
+#include "vertex_format.h"
+#include "test_check.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// Built twice, as vertex_format_test with the SSE2 encoders where the
+// target has them and as vertex_format_scalar_test without. Both compare
+// against the same scalar reference, so the two paths agree bit for bit.
+
+namespace {
+
+/** Positions as Snorm16, colors as Unorm8, normals as Octahedral16. */
+constexpr VertexFormat c_compact_format = {
+    PositionEncoding::Snorm16,
+    ColorEncoding::Unorm8,
+    NormalEncoding::Octahedral16};
+constexpr uint32_t c_color_offset = 8;
+constexpr uint32_t c_normal_offset = 12;
+
+int16_t referenceSnorm16(float value)
+{
+    return static_cast<int16_t>(
+        std::nearbyint(std::clamp(value, -1.f, 1.f) * 32767.f));
+}
+
+uint8_t referenceUnorm8(float value)
+{
+    return static_cast<uint8_t>(
+        std::nearbyint(std::clamp(value, 0.f, 1.f) * 255.f));
+}
+
+/** Encodes one vertex per value with the value in every component. */
+std::vector<uint8_t> encodeSplat(
+    const VertexFormat& format, const std::vector<float>& values)
+{
+    std::vector<float> streams;
+    for (float value : values)
+    {
+        streams.insert(streams.end(), {value, value, value});
+    }
+    VertexStreams input;
+    input.count = values.size();
+    input.positions = streams.data();
+    input.colors = streams.data();
+    input.normals = streams.data();
+    std::vector<uint8_t> encoded(values.size() * format.stride());
+    encodeVertices(format, input, encoded.data());
+    return encoded;
+}
+
+/**
+ * Values around and on the rounding ties of both encodings, including the
+ * ones whose product with the scale rounds to exactly x.5 in float.
+ */
+std::vector<float> makeRoundingValues()
+{
+    std::vector<float> values = {-2.f, -1.f, -0.5f, 0.f, 0.5f, 1.f, 2.f};
+    for (int i = -512; i <= 512; ++i)
+    {
+        values.push_back((i + 0.5f) / 255.f);
+        values.push_back((i * 64 + 0.5f) / 32767.f);
+        values.push_back(i / 512.f);
+    }
+    return values;
+}
+
+void testSnorm16()
+{
+    const VertexFormat format = {
+        PositionEncoding::Snorm16, ColorEncoding::Float32};
+    const std::vector<float> values = makeRoundingValues();
+    const std::vector<uint8_t> encoded = encodeSplat(format, values);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        int16_t packed[4];
+        std::memcpy(packed, &encoded[i * format.stride()], sizeof(packed));
+        const int16_t expected = referenceSnorm16(values[i]);
+        CHECK(packed[0] == expected);
+        CHECK(packed[1] == expected);
+        CHECK(packed[2] == expected);
+        CHECK(packed[3] == 32767);
+    }
+}
+
+void testUnorm8()
+{
+    const std::vector<float> values = makeRoundingValues();
+    const std::vector<uint8_t> encoded =
+        encodeSplat(c_compact_format, values);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        const uint8_t* color =
+            &encoded[i * c_compact_format.stride() + c_color_offset];
+        const uint8_t expected = referenceUnorm8(values[i]);
+        CHECK(color[0] == expected);
+        CHECK(color[1] == expected);
+        CHECK(color[2] == expected);
+        CHECK(color[3] == 255);
+    }
+}
+
+void testHalf()
+{
+    const VertexFormat format = {
+        PositionEncoding::Half, ColorEncoding::Float32};
+    struct Case
+    {
+        float value;
+        uint16_t bits;
+    };
+    const Case cases[] = {
+        {0.f, 0x0000},
+        {-0.f, 0x8000},
+        {1.f, 0x3C00},
+        {-2.f, 0xC000},
+        {0.5f, 0x3800},
+        {65504.f, 0x7BFF},
+        // Halfway to the next half above the maximum rounds to infinity.
+        {65520.f, 0x7C00},
+        {INFINITY, 0x7C00},
+        // Ties between two halves round to the even mantissa.
+        {1.f + 0x1p-11f, 0x3C00},
+        {1.f + 0x3p-11f, 0x3C02},
+        // Smallest normal, smallest subnormal and a subnormal tie.
+        {0x1p-14f, 0x0400},
+        {0x1p-24f, 0x0001},
+        {0x3p-25f, 0x0002},
+        {0x1p-26f, 0x0000},
+    };
+    std::vector<float> values;
+    for (const Case& c : cases)
+    {
+        values.push_back(c.value);
+    }
+    const std::vector<uint8_t> encoded = encodeSplat(format, values);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        uint16_t packed[4];
+        std::memcpy(packed, &encoded[i * format.stride()], sizeof(packed));
+        CHECK(packed[0] == cases[i].bits);
+        CHECK(packed[2] == cases[i].bits);
+        CHECK(packed[3] == 0x3C00);
+    }
+}
+
+float signNotZero(float value)
+{
+    return value >= 0.f ? 1.f : -1.f;
+}
+
+/** Decodes like the shaders do, see NormalEncoding::Octahedral16. */
+void decodeOctahedral(const uint8_t* in, float* normal)
+{
+    int16_t packed[2];
+    std::memcpy(packed, in, sizeof(packed));
+    float x = std::max(packed[0] / 32767.f, -1.f);
+    float y = std::max(packed[1] / 32767.f, -1.f);
+    const float z = 1.f - std::fabs(x) - std::fabs(y);
+    if (z < 0.f)
+    {
+        const float folded_x = (1.f - std::fabs(y)) * signNotZero(x);
+        const float folded_y = (1.f - std::fabs(x)) * signNotZero(y);
+        x = folded_x;
+        y = folded_y;
+    }
+    const float length = std::sqrt(x * x + y * y + z * z);
+    normal[0] = x / length;
+    normal[1] = y / length;
+    normal[2] = z / length;
+}
+
+void testOctahedralRoundTrip()
+{
+    // The axes, the diagonals of every octant and a spiral over the sphere
+    // that crosses the folded lower half.
+    std::vector<float> normals = {
+        1.f, 0.f, 0.f, -1.f, 0.f, 0.f,
+        0.f, 1.f, 0.f, 0.f, -1.f, 0.f,
+        0.f, 0.f, 1.f, 0.f, 0.f, -1.f};
+    for (int i = 0; i < 8; ++i)
+    {
+        normals.insert(
+            normals.end(),
+            {i & 1 ? -1.f : 1.f, i & 2 ? -1.f : 1.f, i & 4 ? -1.f : 1.f});
+    }
+    const int spiral_points = 500;
+    for (int i = 0; i < spiral_points; ++i)
+    {
+        const float z = 1.f - (2.f * i + 1.f) / spiral_points;
+        const float r = std::sqrt(1.f - z * z);
+        const float phi = 2.39996323f * i;
+        // Not normalized on purpose, the encoder takes any length.
+        normals.insert(
+            normals.end(),
+            {3.f * r * std::cos(phi), 3.f * r * std::sin(phi), 3.f * z});
+    }
+
+    const std::size_t count = normals.size() / 3;
+    std::vector<float> zeros(normals.size(), 0.f);
+    VertexStreams streams;
+    streams.count = count;
+    streams.positions = zeros.data();
+    streams.colors = zeros.data();
+    streams.normals = normals.data();
+    std::vector<uint8_t> encoded(count * c_compact_format.stride());
+    encodeVertices(c_compact_format, streams, encoded.data());
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float* original = &normals[i * 3];
+        const float length = std::sqrt(
+            original[0] * original[0] + original[1] * original[1] +
+            original[2] * original[2]);
+        float decoded[3];
+        decodeOctahedral(
+            &encoded[i * c_compact_format.stride() + c_normal_offset],
+            decoded);
+        // The sine of the angle between them, well conditioned for the
+        // small angles a cosine near 1 can't resolve in float.
+        const float cross[3] = {
+            original[1] * decoded[2] - original[2] * decoded[1],
+            original[2] * decoded[0] - original[0] * decoded[2],
+            original[0] * decoded[1] - original[1] * decoded[0]};
+        const float sine = std::sqrt(
+                               cross[0] * cross[0] + cross[1] * cross[1] +
+                               cross[2] * cross[2]) /
+                           length;
+        const float dot = original[0] * decoded[0] +
+                          original[1] * decoded[1] + original[2] * decoded[2];
+        // 16 bit octahedral normals stay well within 0.01 degrees.
+        CHECK(dot > 0.f);
+        CHECK(sine < 0.01f * 3.14159265f / 180.f);
+    }
+}
+
+void testLayout()
+{
+    CHECK(c_compact_format.stride() == 16);
+    const std::vector<VkVertexInputAttributeDescription> attributes =
+        c_compact_format.attributes(0, 2);
+    CHECK(attributes.size() == 3);
+    CHECK(attributes[0].location == 2);
+    CHECK(attributes[1].offset == c_color_offset);
+    CHECK(attributes[1].format == VK_FORMAT_R8G8B8A8_UNORM);
+    CHECK(attributes[2].offset == c_normal_offset);
+    CHECK(attributes[2].format == VK_FORMAT_R16G16_SNORM);
+}
+
+} // namespace
+
+int main()
+{
+    testSnorm16();
+    testUnorm8();
+    testHalf();
+    testOctahedralRoundTrip();
+    testLayout();
+    return checkResult();
+}